@@ -6,6 +6,13 @@
  * This file serves as adapter between the generic lock implementation
  * in 'lock.cc' and the underlying kernel.
  *
+ * Each thread owns a futex word with the states 'RUNNING', 'BLOCKED', and
+ * 'WOKEN'. A thread going to sleep marks itself as blocked. The previous
+ * lock owner marks the applicant as woken and issues a single FUTEX_WAKE
+ * only if the applicant is actually blocked. If the applicant has not
+ * blocked yet, it finds itself marked as woken and does not enter the
+ * kernel at all. So the handover never polls for the applicant to sleep.
+ *
  * For documentation about the interface, please revisit the 'base-pistachio'
  * implementation.
  */
@@ -22,6 +29,7 @@
 
 /* Genode includes */
 #include <base/thread.h>
+#include <cpu/atomic.h>
 
 /* Linux includes */
 #include <linux_syscalls.h>
@@ -30,37 +38,66 @@
 extern int main_thread_futex_counter;
 
 
-static inline void thread_yield()
+/**
+ * States of the futex word of a thread
+ */
+enum { LX_THREAD_RUNNING = 0, LX_THREAD_BLOCKED = 1, LX_THREAD_WOKEN = 2 };
+
+enum { LX_EINTR = 4 };
+
+
+static inline int volatile *thread_futex_word(Genode::Thread *thread_base)
 {
-	struct timespec ts = { 0, 1000 };
-	lx_nanosleep(&ts, 0);
+	return thread_base ? &thread_base->native_thread().futex_counter
+	                   : &main_thread_futex_counter;
 }
 
 
+static inline void thread_yield() { lx_sched_yield(); }
+
+
 static inline bool thread_check_stopped_and_restart(Genode::Thread *thread_base)
 {
-	const int *futex_counter_ptr = thread_base ?
-	                               &thread_base->native_thread().futex_counter :
-	                               &main_thread_futex_counter;
-	return lx_futex(futex_counter_ptr, LX_FUTEX_WAKE, 1);
+	int volatile * const word = thread_futex_word(thread_base);
+
+	if (Genode::cmpxchg(word, LX_THREAD_BLOCKED, LX_THREAD_WOKEN)) {
+		lx_futex((int const *)word, LX_FUTEX_WAKE, 1);
+		return true;
+	}
+
+	/*
+	 * The applicant has not blocked yet. It will observe the mark and
+	 * return from 'thread_stop_myself' immediately. If the applicant
+	 * blocked in between, the caller retries.
+	 */
+	return Genode::cmpxchg(word, LX_THREAD_RUNNING, LX_THREAD_WOKEN);
 }
 
 
-static inline void thread_switch_to(Genode::Thread *) { thread_yield(); }
+/*
+ * The applicant is woken up by 'thread_check_stopped_and_restart' without
+ * polling. Hence, there is nothing to wait for between the attempts.
+ */
+static inline void thread_switch_to(Genode::Thread *) { }
 
 
 static inline void thread_stop_myself()
 {
+	int volatile * const word = thread_futex_word(Genode::Thread::myself());
+
 	/*
-	 * Just go to sleep without modifying the counter value. The
-	 * 'thread_check_stopped_and_restart()' function will get called
-	 * repeatedly until this thread has actually executed the syscall.
+	 * Sleep only if we have not been woken up already. Spurious wake-ups
+	 * are filtered by checking the futex word. An interrupted call is
+	 * caused by core's cancel-blocking mechanism.
 	 */
-	Genode::Thread *myself = Genode::Thread::myself();
-	const int *futex_counter_ptr = myself ?
-	                               &myself->native_thread().futex_counter :
-	                               &main_thread_futex_counter;
-	lx_futex(futex_counter_ptr, LX_FUTEX_WAIT, 0);
+	if (Genode::cmpxchg(word, LX_THREAD_RUNNING, LX_THREAD_BLOCKED)) {
+		while (*word == LX_THREAD_BLOCKED)
+			if (lx_futex((int const *)word, LX_FUTEX_WAIT,
+			             LX_THREAD_BLOCKED) == -LX_EINTR)
+				break;
+	}
+
+	*word = LX_THREAD_RUNNING;
 }
 
 #endif /* _INCLUDE__BASE__INTERNAL__LOCK_HELPER_H_ */
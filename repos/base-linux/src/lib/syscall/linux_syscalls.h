@@ -340,6 +340,9 @@ inline int lx_nanosleep(const struct timespec *req, struct timespec *rem)
 	return lx_syscall(SYS_nanosleep, req, rem);
 }
 
+
+inline int lx_sched_yield() { return lx_syscall(SYS_sched_yield); }
+
 enum {
 	LX_FUTEX_WAIT = FUTEX_WAIT,
 	LX_FUTEX_WAKE = FUTEX_WAKE,
@@ -26,6 +26,27 @@ namespace Genode {
 
 class Genode::Cancelable_lock
 {
+	public:
+
+		/**
+		 * Counters of contended lock acquisitions
+		 *
+		 * The counters are updated only if enabled for a lock via the
+		 * 'contention' method. Each acquisition that involved blocking is
+		 * reported as 'Trace::Lock_contention' event once the lock is
+		 * released again.
+		 */
+		struct Contention
+		{
+			char const *name;
+
+			unsigned long spinning = 0; /* acquired by spinning  */
+			unsigned long blocking = 0; /* acquired after blocking */
+			unsigned long canceled = 0; /* blocking was canceled */
+
+			explicit Contention(char const *name) : name(name) { }
+		};
+
 	private:
 
 		class Applicant
@@ -58,7 +79,8 @@ class Genode::Cancelable_lock
 
 		/*
 		 * Note that modifications of the applicants queue must be performed
-		 * atomically. Hence, we use the additional spinlock here.
+		 * atomically. Hence, we use the additional spinlock here. The
+		 * uncontended acquisition and release only modify '_state'.
 		 */
 
 		volatile int _spinlock_state = 0;
@@ -68,6 +90,14 @@ class Genode::Cancelable_lock
 
 		Applicant _owner;
 
+		/* number of spinning rounds before blocking, adapted at runtime */
+		unsigned _spin_limit = 0;
+
+		Contention *_contention = nullptr;
+
+		/* contended acquisition to be reported by the owner on 'unlock' */
+		bool _contention_pending = false;
+
 	public:
 
 		enum State { LOCKED, UNLOCKED };
@@ -89,6 +119,13 @@ class Genode::Cancelable_lock
 		 */
 		void unlock();
 
+		/**
+		 * Enable the counting of contended acquisitions
+		 *
+		 * \param contention  counters, must outlive the lock
+		 */
+		void contention(Contention &contention) { _contention = &contention; }
+
 		/**
 		 * Lock guard
 		 */
@@ -123,6 +123,11 @@ class Genode::Heap : public Allocator
 		 */
 		bool _unsynchronized_alloc(size_t size, void **out_addr);
 
+		/**
+		 * Unsynchronized implementation of 'free'
+		 */
+		void _unsynchronized_free(void *addr);
+
 	public:
 
 		enum { UNLIMITED = ~0 };
@@ -145,6 +150,27 @@ class Genode::Heap : public Allocator
 		 */
 		int quota_limit(size_t new_quota_limit);
 
+		/**
+		 * Allocate several blocks of equal size at once
+		 *
+		 * \param size   size of each block in bytes
+		 * \param out    array receiving the addresses of the blocks
+		 * \param count  number of blocks to allocate
+		 *
+		 * \return  number of blocks actually allocated
+		 *
+		 * In contrast to calling 'alloc' 'count' times, the heap lock is
+		 * acquired only once. Each block is accounted against the quota
+		 * limit individually, so the result may be less than 'count' if
+		 * the quota is exhausted on the way.
+		 */
+		unsigned alloc_batch(size_t size, void **out, unsigned count);
+
+		/**
+		 * Release several blocks at once while holding the heap lock only once
+		 */
+		void free_batch(void * const *blocks, unsigned count);
+
 		/**
 		 * Re-assign RAM allocator and region map
 		 */
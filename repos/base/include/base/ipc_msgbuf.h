@@ -112,6 +112,11 @@ class Genode::Msgbuf_base : Noncopyable
 			return reinterpret_cast<unsigned long *>(_data)[i];
 		}
 
+		unsigned long word(unsigned i) const
+		{
+			return reinterpret_cast<unsigned long const *>(_data)[i];
+		}
+
 		/**
 		 * Return size of message buffer
 		 */
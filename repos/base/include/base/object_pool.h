@@ -20,6 +20,7 @@
 #include <util/noncopyable.h>
 #include <base/capability.h>
 #include <base/weak_ptr.h>
+#include <base/rw_lock.h>
 
 namespace Genode { template <typename> class Object_pool; }
 
@@ -30,7 +31,9 @@ namespace Genode { template <typename> class Object_pool; }
  * \param OBJ_TYPE  object type (must be inherited from Object_pool::Entry)
  *
  * The local names of a capabilities are used to differentiate multiple server
- * objects managed by one and the same object pool.
+ * objects managed by one and the same object pool. Lookups via 'apply' share
+ * the pool's lock. So threads of a multi-threaded entrypoint can look up
+ * objects in parallel.
  */
 template <typename OBJ_TYPE>
 class Genode::Object_pool : Interface, Noncopyable
@@ -95,13 +98,13 @@ class Genode::Object_pool : Interface, Noncopyable
 	private:
 
 		Avl_tree<Entry> _tree { };
-		Lock            _lock { };
+		Rw_lock         _lock { };
 
 	protected:
 
 		bool empty()
 		{
-			Lock::Guard lock_guard(_lock);
+			Rw_lock::Shared_guard lock_guard(_lock);
 			return _tree.first() == nullptr;
 		}
 
@@ -109,13 +112,13 @@ class Genode::Object_pool : Interface, Noncopyable
 
 		void insert(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
+			Rw_lock::Guard lock_guard(_lock);
 			_tree.insert(obj);
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
+			Rw_lock::Guard lock_guard(_lock);
 			_tree.remove(obj);
 		}
 
@@ -131,7 +134,7 @@ class Genode::Object_pool : Interface, Noncopyable
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				Rw_lock::Shared_guard lock_guard(_lock);
 
 				Entry * entry = _tree.first() ?
 					_tree.first()->find_by_obj_id(capid) : nullptr;
@@ -164,7 +167,7 @@ class Genode::Object_pool : Interface, Noncopyable
 				OBJ_TYPE * obj;
 
 				{
-					Lock::Guard lock_guard(_lock);
+					Rw_lock::Guard lock_guard(_lock);
 
 					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
 
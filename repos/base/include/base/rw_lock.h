@@ -0,0 +1,243 @@
+/*
+ * \brief  Reader-writer lock
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__RW_LOCK_H_
+#define _INCLUDE__BASE__RW_LOCK_H_
+
+#include <base/lock.h>
+#include <base/lock_guard.h>
+#include <util/fifo.h>
+#include <util/noncopyable.h>
+#include <cpu/atomic.h>
+
+namespace Genode { class Rw_lock; }
+
+
+/**
+ * Lock that can be held by multiple readers or by one writer
+ *
+ * A reader that arrives while a writer holds or waits for the lock is
+ * blocked. So a continuous stream of readers cannot starve a writer. When a
+ * writer releases the lock, all readers blocked at this time acquire the
+ * lock together before the next waiting writer.
+ *
+ * As long as no thread blocks, acquiring and releasing the lock is done
+ * via a single atomic operation. Blocked threads are queued in elements
+ * located on their stacks, so the lock needs no dynamic memory.
+ */
+class Genode::Rw_lock : Noncopyable
+{
+	private:
+
+		/*
+		 * The state word contains the number of readers that hold the lock,
+		 * the 'WRITER' bit if a writer holds the lock, and the 'WAITERS' bit
+		 * if threads are blocked. If 'WAITERS' is set, the state is modified
+		 * only while holding the '_meta_lock'.
+		 */
+		enum {
+			WRITER  = 1 << 30,
+			WAITERS = 1 << 29,
+			READERS = WAITERS - 1,
+		};
+
+		int volatile _state = 0;
+
+		Lock _meta_lock { };
+
+		struct Waiter : Fifo<Waiter>::Element
+		{
+			Lock lock { Lock::LOCKED };
+
+			void block()   { lock.lock();   }
+			void wake_up() { lock.unlock(); }
+		};
+
+		Fifo<Waiter> _readers { };
+		Fifo<Waiter> _writers { };
+
+		/**
+		 * Mark the state as having waiters unless the lock can be acquired
+		 *
+		 * \param acquirable  returns true if the lock can be acquired in
+		 *                    the given state
+		 * \param acquired    returns new state after acquiring the lock
+		 *
+		 * \return  true if the lock got acquired
+		 */
+		template <typename ACQUIRABLE, typename ACQUIRED>
+		bool _acquire_or_mark_waiting(ACQUIRABLE const &acquirable,
+		                              ACQUIRED   const &acquired)
+		{
+			for (;;) {
+				int const state = _state;
+
+				if (acquirable(state)) {
+					if (cmpxchg(&_state, state, acquired(state)))
+						return true;
+					continue;
+				}
+
+				if ((state & WAITERS) || cmpxchg(&_state, state, state | WAITERS))
+					return false;
+			}
+		}
+
+		/**
+		 * Return state for the case that no thread holds the lock
+		 *
+		 * This method must be called with '_meta_lock' held. It dequeues the
+		 * threads that acquire the lock next and returns them as list.
+		 */
+		int _next_state(Fifo<Waiter> &woken, bool prefer_readers)
+		{
+			if (prefer_readers || _writers.empty()) {
+
+				int readers = 0;
+				while (Waiter *w = _readers.dequeue()) {
+					woken.enqueue(w);
+					readers++;
+				}
+
+				if (readers)
+					return readers | (_writers.empty() ? 0 : WAITERS);
+			}
+
+			if (Waiter *w = _writers.dequeue()) {
+				woken.enqueue(w);
+				return WRITER | (_writers.empty() && _readers.empty() ? 0 : WAITERS);
+			}
+
+			return 0;
+		}
+
+		static void _wake_up(Fifo<Waiter> &woken)
+		{
+			/* a woken waiter may vanish, so dequeue it first */
+			while (Waiter *w = woken.dequeue())
+				w->wake_up();
+		}
+
+	public:
+
+		/**
+		 * Acquire the lock exclusively
+		 */
+		void lock()
+		{
+			/* uncontended case */
+			if (cmpxchg(&_state, 0, WRITER))
+				return;
+
+			_meta_lock.lock();
+
+			auto acquirable = [] (int state) { return state == 0; };
+			auto acquired   = [] (int)       { return (int)WRITER; };
+
+			if (_acquire_or_mark_waiting(acquirable, acquired)) {
+				_meta_lock.unlock();
+				return;
+			}
+
+			/* the lock is handed over to us by the releasing thread */
+			Waiter waiter;
+			_writers.enqueue(&waiter);
+			_meta_lock.unlock();
+			waiter.block();
+		}
+
+		/**
+		 * Release exclusively acquired lock
+		 */
+		void unlock()
+		{
+			/* no waiters */
+			if (cmpxchg(&_state, WRITER, 0))
+				return;
+
+			Fifo<Waiter> woken;
+			{
+				Lock::Guard guard(_meta_lock);
+				_state = _next_state(woken, true);
+			}
+			_wake_up(woken);
+		}
+
+		/**
+		 * Acquire the lock shared with other readers
+		 */
+		void lock_shared()
+		{
+			/* uncontended case */
+			int const state = _state;
+			if (!(state & (WRITER | WAITERS)) && cmpxchg(&_state, state, state + 1))
+				return;
+
+			_meta_lock.lock();
+
+			auto acquirable = [] (int state) { return !(state & (WRITER | WAITERS)); };
+			auto acquired   = [] (int state) { return state + 1; };
+
+			if (_acquire_or_mark_waiting(acquirable, acquired)) {
+				_meta_lock.unlock();
+				return;
+			}
+
+			/* the lock is handed over to us by the releasing thread */
+			Waiter waiter;
+			_readers.enqueue(&waiter);
+			_meta_lock.unlock();
+			waiter.block();
+		}
+
+		/**
+		 * Release lock acquired via 'lock_shared'
+		 */
+		void unlock_shared()
+		{
+			/* no waiters */
+			for (int state = _state; !(state & WAITERS); state = _state)
+				if (cmpxchg(&_state, state, state - 1))
+					return;
+
+			Fifo<Waiter> woken;
+			{
+				Lock::Guard guard(_meta_lock);
+
+				int const state = _state - 1;
+
+				_state = (state & READERS) ? state : _next_state(woken, false);
+			}
+			_wake_up(woken);
+		}
+
+		typedef Lock_guard<Rw_lock> Guard;
+
+		/**
+		 * Guard for acquiring the lock shared with other readers
+		 */
+		class Shared_guard : Noncopyable
+		{
+			private:
+
+				Rw_lock &_lock;
+
+			public:
+
+				explicit Shared_guard(Rw_lock &lock) : _lock(lock) {
+					_lock.lock_shared(); }
+
+				~Shared_guard() { _lock.unlock_shared(); }
+		};
+};
+
+#endif /* _INCLUDE__BASE__RW_LOCK_H_ */
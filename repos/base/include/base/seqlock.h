@@ -0,0 +1,102 @@
+/*
+ * \brief  Sequence lock
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__SEQLOCK_H_
+#define _INCLUDE__BASE__SEQLOCK_H_
+
+#include <base/lock.h>
+#include <util/noncopyable.h>
+#include <cpu/memory_barrier.h>
+#include <cpu/spin_pause.h>
+
+namespace Genode { class Seqlock; }
+
+
+/**
+ * Lock for small data that is read frequently and written rarely
+ *
+ * Readers do not modify the lock but read the data optimistically and
+ * retry if a writer modified the data in the meantime. Hence, readers
+ * usually do not delay a writer. Writers are serialized among each other.
+ * A reader that failed for a bounded number of attempts because of
+ * continuous writes takes the lock of the writers to make progress.
+ *
+ * The read functor may be executed multiple times and may observe
+ * inconsistent data. So it should merely copy the protected data and must
+ * not follow pointers contained in the data. The copy is consistent once
+ * 'read' returns.
+ */
+class Genode::Seqlock : Noncopyable
+{
+	private:
+
+		/* attempts of an optimistic read before it takes the write lock */
+		enum { MAX_READ_ATTEMPTS = 128 };
+
+		/* odd while a writer modifies the data */
+		unsigned volatile _sequence = 0;
+
+		Lock mutable _write_lock { };
+
+	public:
+
+		/**
+		 * Read protected data
+		 *
+		 * \param fn  functor that copies the protected data
+		 */
+		template <typename FN>
+		void read(FN const &fn) const
+		{
+			for (unsigned i = 0; i < MAX_READ_ATTEMPTS; i++) {
+				unsigned const sequence = _sequence;
+
+				if (sequence & 1) {
+					spin_pause();
+					continue;
+				}
+
+				memory_barrier();
+				fn();
+				memory_barrier();
+
+				if (_sequence == sequence)
+					return;
+			}
+
+			/*
+			 * Writers keep modifying the data, e.g., because the writer got
+			 * preempted or runs on the same CPU. Read while excluding them.
+			 */
+			Lock::Guard guard(_write_lock);
+			fn();
+		}
+
+		/**
+		 * Modify protected data
+		 *
+		 * \param fn  functor that modifies the protected data
+		 */
+		template <typename FN>
+		void write(FN const &fn)
+		{
+			Lock::Guard guard(_write_lock);
+
+			_sequence = _sequence + 1;
+			memory_barrier();
+			fn();
+			memory_barrier();
+			_sequence = _sequence + 1;
+		}
+};
+
+#endif /* _INCLUDE__BASE__SEQLOCK_H_ */
@@ -0,0 +1,307 @@
+/*
+ * \brief  Heap front end with per-thread size-class caches
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__THREAD_CACHED_HEAP_H_
+#define _INCLUDE__BASE__THREAD_CACHED_HEAP_H_
+
+#include <base/heap.h>
+#include <base/thread.h>
+#include <base/lock.h>
+
+namespace Genode { class Thread_cached_heap; }
+
+
+/**
+ * Allocator that keeps recently freed small blocks in per-thread magazines
+ *
+ * Each thread using the allocator is assigned a cache slot on its first
+ * allocation. The slot holds one magazine per size class. Allocations and
+ * deallocations served from the caller's own magazines neither take a lock
+ * nor touch the AVL tree of the backing heap. The backing 'Heap' is consulted
+ * only for refilling an empty magazine, for draining a full one, and for
+ * blocks larger than 'MAX_CACHED_SIZE'. Refills and drains move half a
+ * magazine at a time via 'Heap::alloc_batch' and 'Heap::free_batch', which
+ * acquire the heap lock only once.
+ *
+ * Blocks held in magazines remain allocated at the backing heap. Hence,
+ * 'Heap::consumed' and the quota limit configured via 'Heap::quota_limit'
+ * keep their meaning. A thread may return its cached blocks to the heap by
+ * calling 'flush', e.g., before lowering the quota limit.
+ *
+ * Cache slots are bound to 'Thread' objects. A thread must release its slot
+ * by calling 'detach' before it exits. Otherwise, the slot and the blocks
+ * cached in it stay bound to the stale 'Thread' object until the allocator
+ * is destructed. Threads that find no free slot, and the main thread during
+ * the component initialization (when 'Thread::myself' is 0), are served by
+ * the backing heap directly.
+ */
+class Genode::Thread_cached_heap : public Allocator
+{
+	public:
+
+		enum {
+			MAX_THREADS     = 16,
+			MAGAZINE_DEPTH  = 32,
+			NUM_CLASSES     = 14,
+			MAX_CACHED_SIZE = 2048,
+		};
+
+	private:
+
+		/*
+		 * Meta data prepended to each block, two machine words to retain
+		 * the alignment guaranteed by 'Heap'
+		 */
+		struct Header
+		{
+			unsigned long size_class;
+			unsigned long reserved;
+		};
+
+		enum { UNCACHED = ~0UL };
+
+		struct Magazine
+		{
+			unsigned  count = 0;
+			void     *blocks[MAGAZINE_DEPTH] { };
+		};
+
+		struct Cache
+		{
+			Thread * volatile owner = nullptr;
+
+			Magazine magazines[NUM_CLASSES] { };
+		};
+
+		Heap  &_heap;
+		Lock   _claim_lock { };
+		Cache  _caches[MAX_THREADS] { };
+
+		/*
+		 * Noncopyable
+		 */
+		Thread_cached_heap(Thread_cached_heap const &);
+		Thread_cached_heap &operator = (Thread_cached_heap const &);
+
+		static size_t _class_size(unsigned long c)
+		{
+			static size_t const sizes[NUM_CLASSES] = {
+				16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536,
+				MAX_CACHED_SIZE };
+
+			return sizes[c];
+		}
+
+		static unsigned long _size_class(size_t size)
+		{
+			for (unsigned long c = 0; c < NUM_CLASSES; c++)
+				if (size <= _class_size(c))
+					return c;
+
+			return UNCACHED;
+		}
+
+		static Header *_header(void *block) { return (Header *)block - 1; }
+
+		/**
+		 * Return cache slot of the calling thread, or 0 if there is none
+		 */
+		Cache *_my_cache()
+		{
+			Thread * const myself = Thread::myself();
+			if (!myself)
+				return nullptr;
+
+			unsigned const start = ((addr_t)myself >> 12) % MAX_THREADS;
+
+			/*
+			 * A slot's owner is set to a thread and reset to 0 only by the
+			 * owning thread itself. So the lookup of an already claimed slot
+			 * needs no lock.
+			 */
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Cache &cache = _caches[(start + i) % MAX_THREADS];
+				if (cache.owner == myself)
+					return &cache;
+			}
+
+			Lock::Guard guard(_claim_lock);
+
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Cache &cache = _caches[(start + i) % MAX_THREADS];
+				if (!cache.owner) {
+					cache.owner = myself;
+					return &cache;
+				}
+			}
+			return nullptr;
+		}
+
+		bool _alloc_uncached(unsigned long size_class, size_t size, void **out_addr)
+		{
+			void *block = nullptr;
+			if (!_heap.alloc(sizeof(Header) + size, &block))
+				return false;
+
+			((Header *)block)->size_class = size_class;
+			*out_addr = (Header *)block + 1;
+			return true;
+		}
+
+		void _refill(Magazine &magazine, unsigned long size_class)
+		{
+			void *blocks[MAGAZINE_DEPTH/2];
+
+			unsigned const n = _heap.alloc_batch(sizeof(Header) + _class_size(size_class),
+			                                     blocks, MAGAZINE_DEPTH/2);
+			for (unsigned i = 0; i < n; i++) {
+				((Header *)blocks[i])->size_class = size_class;
+				magazine.blocks[magazine.count++] = (Header *)blocks[i] + 1;
+			}
+		}
+
+		void _drain(Magazine &magazine, unsigned count)
+		{
+			void *blocks[MAGAZINE_DEPTH];
+
+			for (unsigned i = 0; i < count; i++)
+				blocks[i] = _header(magazine.blocks[--magazine.count]);
+
+			_heap.free_batch(blocks, count);
+		}
+
+	public:
+
+		Thread_cached_heap(Heap &heap) : _heap(heap) { }
+
+		~Thread_cached_heap()
+		{
+			for (unsigned i = 0; i < MAX_THREADS; i++)
+				for (unsigned c = 0; c < NUM_CLASSES; c++) {
+					Magazine &magazine = _caches[i].magazines[c];
+					_drain(magazine, magazine.count);
+				}
+		}
+
+		/**
+		 * Return blocks cached by the calling thread to the backing heap
+		 */
+		void flush()
+		{
+			Cache * const cache = _my_cache();
+			if (!cache)
+				return;
+
+			for (unsigned c = 0; c < NUM_CLASSES; c++) {
+				Magazine &magazine = cache->magazines[c];
+				_drain(magazine, magazine.count);
+			}
+		}
+
+		/**
+		 * Return blocks cached by the calling thread and release its slot
+		 *
+		 * This method must be called by each thread that used the allocator
+		 * before the thread exits, e.g., at the end of its 'entry' method.
+		 * The slot can then be claimed by another thread. If the calling
+		 * thread uses the allocator again, it claims a slot anew.
+		 */
+		void detach()
+		{
+			Thread * const myself = Thread::myself();
+			if (!myself)
+				return;
+
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				Cache &cache = _caches[i];
+				if (cache.owner != myself)
+					continue;
+
+				for (unsigned c = 0; c < NUM_CLASSES; c++) {
+					Magazine &magazine = cache.magazines[c];
+					_drain(magazine, magazine.count);
+				}
+
+				Lock::Guard guard(_claim_lock);
+				cache.owner = nullptr;
+				return;
+			}
+		}
+
+		/**
+		 * Return number of threads that currently own a cache slot
+		 */
+		unsigned attached_threads() const
+		{
+			unsigned count = 0;
+			for (unsigned i = 0; i < MAX_THREADS; i++)
+				if (_caches[i].owner)
+					count++;
+
+			return count;
+		}
+
+		Heap &heap() { return _heap; }
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			unsigned long const size_class = _size_class(size);
+
+			if (size_class == UNCACHED)
+				return _alloc_uncached(UNCACHED, size, out_addr);
+
+			Cache * const cache = _my_cache();
+			if (!cache)
+				return _alloc_uncached(size_class, _class_size(size_class), out_addr);
+
+			Magazine &magazine = cache->magazines[size_class];
+			if (!magazine.count)
+				_refill(magazine, size_class);
+
+			if (!magazine.count)
+				return false;
+
+			*out_addr = magazine.blocks[--magazine.count];
+			return true;
+		}
+
+		void free(void *addr, size_t) override
+		{
+			unsigned long const size_class = _header(addr)->size_class;
+
+			Cache * const cache = (size_class == UNCACHED) ? nullptr : _my_cache();
+			if (!cache) {
+				_heap.free(_header(addr), 0);
+				return;
+			}
+
+			Magazine &magazine = cache->magazines[size_class];
+			if (magazine.count == MAGAZINE_DEPTH)
+				_drain(magazine, MAGAZINE_DEPTH/2);
+
+			magazine.blocks[magazine.count++] = addr;
+		}
+
+		size_t consumed() const override { return _heap.consumed(); }
+
+		size_t overhead(size_t size) const override {
+			return _heap.overhead(sizeof(Header) + size) + sizeof(Header); }
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__BASE__THREAD_CACHED_HEAP_H_ */
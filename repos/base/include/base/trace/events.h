@@ -25,6 +25,7 @@ namespace Genode { namespace Trace {
 	struct Rpc_reply;
 	struct Signal_submit;
 	struct Signal_received;
+	struct Lock_contention;
 } }
 
 
@@ -121,4 +122,23 @@ struct Genode::Trace::Signal_received
 };
 
 
+struct Genode::Trace::Lock_contention
+{
+	char const    *name;
+	unsigned long  spinning;
+	unsigned long  blocking;
+
+	Lock_contention(char const *name, unsigned long spinning,
+	                unsigned long blocking)
+	:
+		name(name), spinning(spinning), blocking(blocking)
+	{
+		Thread::trace(this);
+	}
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.lock_contention(dst, name, spinning, blocking); }
+};
+
+
 #endif /* _INCLUDE__BASE__TRACE__EVENTS_H_ */
@@ -0,0 +1,39 @@
+/*
+ * \brief  Hint for busy-waiting loops
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__CPU__SPIN_PAUSE_H_
+#define _INCLUDE__CPU__SPIN_PAUSE_H_
+
+#include <cpu/memory_barrier.h>
+
+namespace Genode {
+
+	/**
+	 * Hint the CPU that the caller is busy waiting
+	 *
+	 * On x86, the hint avoids the penalty of a memory-order violation when
+	 * the awaited value changes and releases the execution resources to a
+	 * sibling hyperthread.
+	 */
+	static inline void spin_pause()
+	{
+#if defined(__i386__) || defined(__x86_64__)
+		asm volatile ("pause" ::: "memory");
+#elif defined(__ARM_ARCH) && __ARM_ARCH >= 7
+		asm volatile ("yield" ::: "memory");
+#else
+		memory_barrier();
+#endif
+	}
+}
+
+#endif /* _INCLUDE__CPU__SPIN_PAUSE_H_ */
@@ -16,10 +16,12 @@
 
 #include <util/token.h>
 #include <base/exception.h>
+#include <base/allocator.h>
 
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
 }
 
 
@@ -49,6 +51,7 @@ class Genode::Xml_attribute
 		Token _value;
 
 		friend class Xml_node;
+		friend class Xml_index;
 
 		/*
 		 * Even though 'Tag' is part of 'Xml_node', the friendship
@@ -188,6 +191,8 @@ class Genode::Xml_node
 {
 	private:
 
+		friend class Xml_index;
+
 		typedef Xml_attribute::Token Token;
 
 		/**
@@ -449,6 +454,24 @@ class Genode::Xml_node
 		Tag         _start_tag;
 		Tag         _end_tag;
 
+		Xml_index const *_index { nullptr }; /* optional index of the document */
+		unsigned         _entry { 0 };       /* node's entry within '_index'   */
+
+		/**
+		 * Constructor used for creating nodes from an 'Xml_index'
+		 *
+		 * \param at  start of the node if it differs from the start tag,
+		 *            as for the first sub node, which starts at the
+		 *            content of its parent
+		 */
+		inline Xml_node(Xml_index const &index, unsigned entry,
+		                char const *at = nullptr);
+
+		inline Xml_node _indexed_next() const;
+		inline Xml_node _indexed_sub_node(unsigned idx) const;
+		inline Xml_node _indexed_sub_node(char const *type) const;
+		inline Xml_attribute _indexed_attribute(char const *type) const;
+
 		/**
 		 * Search for end tag of XML node and initialize '_num_sub_nodes'
 		 *
@@ -720,6 +743,10 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			/* the index covers the sub nodes of its root node only */
+			if (_index && _entry)
+				return _indexed_next();
+
 			Token after_node = _end_tag.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try { return _sub_node(after_node.start()); }
@@ -757,6 +784,9 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(unsigned idx = 0U) const
 		{
+			if (_index)
+				return _indexed_sub_node(idx);
+
 			if (_num_sub_nodes > 0) {
 
 				/* look up node at specified index */
@@ -778,6 +808,9 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(const char *type) const
 		{
+			if (_index)
+				return _indexed_sub_node(type);
+
 			if (_num_sub_nodes > 0) {
 
 				/* search for sub node of specified type */
@@ -850,6 +883,9 @@ class Genode::Xml_node
 		 */
 		Xml_attribute attribute(const char *type) const
 		{
+			if (_index)
+				return _indexed_attribute(type);
+
 			/* iterate, beginning with the first attribute of the node */
 			for (Xml_attribute a = _start_tag.attribute(); ; a = a.next())
 				if (a.has_type(type))
@@ -903,4 +939,288 @@ class Genode::Xml_node
 			output.out_string(addr(), size()); }
 };
 
+
+/**
+ * Index of the nodes and attributes of an XML document
+ *
+ * The index is built in one linear pass over the document. It records the
+ * position of each node's start tag, end tag, and type name, the links to
+ * the node's sibling and sub nodes, and the positions of the node's
+ * attributes. Nodes obtained via 'root' use the index for navigating to
+ * sub nodes and siblings and for looking up attributes. So each step takes
+ * constant time instead of re-tokenizing the document.
+ *
+ * The index refers to the document buffer but does not copy it. Hence,
+ * both the buffer and the index must outlive all nodes obtained from the
+ * index.
+ */
+class Genode::Xml_index
+{
+	private:
+
+		friend class Xml_node;
+
+		typedef Xml_node::Token   Token;
+		typedef Xml_node::Tag     Tag;
+		typedef Xml_node::Comment Comment;
+
+		enum { INVALID = ~0U };
+
+		struct Node
+		{
+			unsigned start;         /* offset of start tag                   */
+			unsigned end;           /* offset of end tag, 'start' if empty   */
+			unsigned name;          /* offset of type name                   */
+			unsigned name_len;
+			unsigned parent;
+			unsigned next;          /* next sibling                          */
+			unsigned num_sub_nodes; /* sub nodes follow their parent         */
+			unsigned first_attr;
+			unsigned num_attrs;
+		};
+
+		struct Attr
+		{
+			unsigned offset;        /* offset of attribute name              */
+			unsigned name_len;
+		};
+
+		Allocator  &_alloc;
+		char const *_base;
+		size_t      _max_len;
+		Node       *_nodes        { nullptr };
+		unsigned    _num_nodes    { 0 };
+		unsigned    _nodes_avail  { 0 };
+		Attr       *_attrs        { nullptr };
+		unsigned    _num_attrs    { 0 };
+		unsigned    _attrs_avail  { 0 };
+
+		/*
+		 * Noncopyable
+		 */
+		Xml_index(Xml_index const &);
+		Xml_index &operator = (Xml_index const &);
+
+		template <typename T>
+		void _grow(T *&array, unsigned &avail, unsigned used)
+		{
+			unsigned const new_avail = avail ? 2*avail : 64;
+
+			T *new_array = (T *)_alloc.alloc(new_avail*sizeof(T));
+			if (array) {
+				memcpy(new_array, array, used*sizeof(T));
+				_alloc.free(array, avail*sizeof(T));
+			}
+			array = new_array;
+			avail = new_avail;
+		}
+
+		unsigned _offset(char const *ptr) const { return (unsigned)(ptr - _base); }
+
+		unsigned _add_node(Tag const &tag, unsigned parent)
+		{
+			if (_num_nodes == _nodes_avail)
+				_grow(_nodes, _nodes_avail, _num_nodes);
+
+			unsigned const idx   = _num_nodes++;
+			unsigned const start = _offset(tag.token().start());
+
+			_nodes[idx] = Node { start, start, _offset(tag.name().start()),
+			                     (unsigned)tag.name().len(), parent, INVALID,
+			                     0, _num_attrs, 0 };
+			try {
+				for (Xml_attribute a = tag.attribute(); ; a = a._next()) {
+
+					if (_num_attrs == _attrs_avail)
+						_grow(_attrs, _attrs_avail, _num_attrs);
+
+					_attrs[_num_attrs++] = Attr { _offset(a._name.start()),
+					                              (unsigned)a._name.len() };
+					_nodes[idx].num_attrs++;
+				}
+			} catch (Xml_attribute::Nonexistent_attribute) { }
+
+			/*
+			 * Link node to its preceding sibling. While a parent node is
+			 * open, its 'end' field holds the index of its last sub node.
+			 */
+			if (parent != INVALID) {
+				Node &p = _nodes[parent];
+				if (p.num_sub_nodes++)
+					_nodes[p.end].next = idx;
+				p.end = idx;
+			}
+			return idx;
+		}
+
+		/**
+		 * Build index in one pass over the tokens of the root node
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 */
+		void _build(Xml_node const &root)
+		{
+			unsigned open = INVALID;
+			Token    t    = root._start_tag.token();
+
+			while (t.type() != Token::END) {
+
+				Comment comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				if (tag.node()) {
+					unsigned const idx = _add_node(tag, open);
+
+					if (tag.type() == Tag::START)
+						open = idx;
+
+				} else {
+
+					/* end tag must match the name of the open node */
+					if (open == INVALID
+					 || tag.name().len() != _nodes[open].name_len
+					 || strcmp(tag.name().start(), _base + _nodes[open].name,
+					           _nodes[open].name_len))
+						throw Xml_node::Invalid_syntax();
+
+					_nodes[open].end = _offset(tag.token().start());
+					open = _nodes[open].parent;
+				}
+
+				/* root node is complete */
+				if (open == INVALID)
+					return;
+
+				t = tag.next_token();
+			}
+			throw Xml_node::Invalid_syntax();
+		}
+
+		Node const &_node(unsigned idx) const { return _nodes[idx]; }
+
+		bool _has_type(unsigned idx, char const *type) const
+		{
+			Node const &n = _nodes[idx];
+			return strlen(type) == n.name_len
+			    && !strcmp(type, _base + n.name, n.name_len);
+		}
+
+		void _free()
+		{
+			if (_nodes) _alloc.free(_nodes, _nodes_avail*sizeof(Node));
+			if (_attrs) _alloc.free(_attrs, _attrs_avail*sizeof(Attr));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the index tables
+		 * \param node   root node of the index
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		:
+			_alloc(alloc), _base(node.addr()), _max_len(node._max_len)
+		{
+			try { _build(node); }
+			catch (...) { _free(); throw; }
+		}
+
+		~Xml_index() { _free(); }
+
+		/**
+		 * Return indexed root node
+		 */
+		Xml_node root() const { return Xml_node(*this, 0); }
+
+		/**
+		 * Return number of indexed nodes
+		 */
+		unsigned num_nodes() const { return _num_nodes; }
+};
+
+
+Genode::Xml_node::Xml_node(Xml_index const &index, unsigned entry, char const *at)
+:
+	_addr(at ? at : index._base + index._node(entry).start),
+	_max_len(index._max_len - (_addr - index._base)),
+	_num_sub_nodes(index._node(entry).num_sub_nodes),
+	_start_tag(Token(index._base + index._node(entry).start,
+	                 index._max_len - index._node(entry).start)),
+	_end_tag(index._node(entry).end == index._node(entry).start
+	         ? _start_tag
+	         : Tag(Token(index._base + index._node(entry).end,
+	                     index._max_len - index._node(entry).end))),
+	_index(&index), _entry(entry)
+{ }
+
+
+Genode::Xml_node Genode::Xml_node::_indexed_next() const
+{
+	unsigned const next = _index->_node(_entry).next;
+	if (next == Xml_index::INVALID)
+		throw Nonexistent_sub_node();
+
+	return Xml_node(*_index, next);
+}
+
+
+Genode::Xml_node Genode::Xml_node::_indexed_sub_node(unsigned idx) const
+{
+	if (idx >= (unsigned)_num_sub_nodes)
+		throw Nonexistent_sub_node();
+
+	/* the first sub node directly follows its parent */
+	if (idx == 0)
+		return Xml_node(*_index, _entry + 1, content_addr());
+
+	unsigned entry = _entry + 1;
+	for (; idx > 0; idx--)
+		entry = _index->_node(entry).next;
+
+	return Xml_node(*_index, entry);
+}
+
+
+Genode::Xml_node Genode::Xml_node::_indexed_sub_node(char const *type) const
+{
+	if (_num_sub_nodes > 0)
+		for (unsigned entry = _entry + 1; entry != Xml_index::INVALID;
+		     entry = _index->_node(entry).next)
+			if (_index->_has_type(entry, type))
+				return Xml_node(*_index, entry,
+				                entry == _entry + 1 ? content_addr() : nullptr);
+
+	throw Nonexistent_sub_node();
+}
+
+
+Genode::Xml_attribute Genode::Xml_node::_indexed_attribute(char const *type) const
+{
+	Xml_index::Node const &n   = _index->_node(_entry);
+	size_t          const  len = strlen(type);
+
+	for (unsigned i = n.first_attr; i < n.first_attr + n.num_attrs; i++) {
+		Xml_index::Attr const &a = _index->_attrs[i];
+		if (a.name_len == len && !strcmp(type, _index->_base + a.offset, len))
+			return Xml_attribute(Token(_index->_base + a.offset,
+			                           _index->_max_len - a.offset));
+	}
+	throw Nonexistent_attribute();
+}
+
 #endif /* _INCLUDE__UTIL__XML_NODE_H_ */
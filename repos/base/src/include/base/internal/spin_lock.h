@@ -18,6 +18,7 @@
 /* Genode includes */
 #include <cpu/atomic.h>
 #include <cpu/memory_barrier.h>
+#include <cpu/spin_pause.h>
 
 /* base-internal includes */
 #include <base/internal/native_thread.h>
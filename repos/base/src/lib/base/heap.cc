@@ -226,11 +226,8 @@ bool Heap::alloc(size_t size, void **out_addr)
 }
 
 
-void Heap::free(void *addr, size_t)
+void Heap::_unsynchronized_free(void *addr)
 {
-	/* serialize access of heap functions */
-	Lock::Guard lock_guard(_lock);
-
 	/* try to find the size in our local allocator */
 	size_t const size = _alloc->size_at(addr);
 
@@ -265,6 +262,44 @@ void Heap::free(void *addr, size_t)
 }
 
 
+void Heap::free(void *addr, size_t)
+{
+	/* serialize access of heap functions */
+	Lock::Guard lock_guard(_lock);
+
+	_unsynchronized_free(addr);
+}
+
+
+unsigned Heap::alloc_batch(size_t size, void **out, unsigned count)
+{
+	/* serialize access of heap functions */
+	Lock::Guard lock_guard(_lock);
+
+	unsigned i = 0;
+	for (; i < count; i++) {
+
+		/* check each block against quota limit */
+		if (size + _quota_used > _quota_limit)
+			break;
+
+		if (!_unsynchronized_alloc(size, &out[i]))
+			break;
+	}
+	return i;
+}
+
+
+void Heap::free_batch(void * const *blocks, unsigned count)
+{
+	/* serialize access of heap functions */
+	Lock::Guard lock_guard(_lock);
+
+	for (unsigned i = 0; i < count; i++)
+		_unsynchronized_free(blocks[i]);
+}
+
+
 Heap::Heap(Ram_allocator *ram_alloc,
            Region_map    *region_map,
            size_t         quota_limit,
@@ -13,6 +13,7 @@
 
 /* Genode includes */
 #include <base/cancelable_lock.h>
+#include <base/trace/events.h>
 #include <cpu/memory_barrier.h>
 
 /* base-internal includes */
@@ -60,59 +61,93 @@ void Cancelable_lock::Applicant::wake_up()
  ** Cancelable lock **
  *********************/
 
-void Cancelable_lock::lock()
-{
-	Applicant myself(Thread::myself());
+/*
+ * Besides the values of 'Cancelable_lock::State', '_state' can be
+ * 'CONTENDED', which means that applicants may be queued. In this state,
+ * 'unlock' hands the lock over to the first applicant. In the 'LOCKED'
+ * state, 'unlock' merely sets '_state' to 'UNLOCKED'.
+ */
+enum { CONTENDED = Cancelable_lock::UNLOCKED + 1 };
 
-	spinlock_lock(&_spinlock_state);
+/*
+ * Bounds of the adaptive spinning before blocking
+ *
+ * The spinning succeeds only if the lock owner runs on another CPU and
+ * leaves the critical section soon. As the owner's CPU is unknown, the
+ * number of spinning rounds is adapted to the observed success. It is
+ * doubled towards 'SPIN_MAX' if the lock got acquired in the second half
+ * of the spinning and is halved down to 'SPIN_MIN' if the spinning failed.
+ */
+enum { SPIN_MIN = 16, SPIN_MAX = 4096 };
 
-	if (cmpxchg(&_state, UNLOCKED, LOCKED)) {
 
-		/* we got the lock */
-		_owner          =  myself;
-		_last_applicant = &_owner;
-		spinlock_unlock(&_spinlock_state);
+static inline bool try_acquire(volatile int *state)
+{
+	return *state == Cancelable_lock::UNLOCKED
+	    && cmpxchg(state, Cancelable_lock::UNLOCKED, Cancelable_lock::LOCKED);
+}
+
+
+void Cancelable_lock::lock()
+{
+	/* uncontended case */
+	if (cmpxchg(&_state, UNLOCKED, LOCKED))
 		return;
-	}
 
 	/*
-	 * We failed to grab the lock, lets add ourself to the
-	 * list of applicants and block for the current lock holder.
+	 * Spin while the lock is held without queued applicants. Otherwise,
+	 * the lock will be handed over to the first applicant anyway.
 	 */
+	unsigned const limit = max(_spin_limit, (unsigned)SPIN_MIN);
+	for (unsigned i = 0; i < limit && _state == LOCKED; i++) {
+
+		spin_pause();
 
-	/* reset ownership if one thread 'lock' twice */
-	if (_owner == myself) {
-		/* remember applicants already in list */
-		Applicant * applicants =_owner.applicant_to_wake_up();
+		if (!try_acquire(&_state))
+			continue;
 
-		/* reset owner */
-		_owner = Applicant(invalid_thread_base());
+		if (2*i >= limit)
+			_spin_limit = min(2*limit, (unsigned)SPIN_MAX);
 
-		/* register thread calling twice 'lock' as first applicant */
-		_owner.applicant_to_wake_up(&myself);
+		if (_contention)
+			_contention->spinning++;
+		return;
+	}
+	_spin_limit = max(limit/2, (unsigned)SPIN_MIN);
 
-		/* if we had already applicants, add after myself in list */
-		myself.applicant_to_wake_up(applicants);
+	Applicant myself(Thread::myself());
 
-		/* if we had applicants, _last_applicant already points to the last */
-		if (!applicants)
-			_last_applicant = &myself;
-	} else {
-		_last_applicant->applicant_to_wake_up(&myself);
-		_last_applicant = &myself;
+	spinlock_lock(&_spinlock_state);
+
+	/* announce that we are going to be queued, or get the released lock */
+	for (;;) {
+		if (try_acquire(&_state)) {
+			spinlock_unlock(&_spinlock_state);
+			return;
+		}
+		if (_state == CONTENDED || cmpxchg(&_state, LOCKED, CONTENDED))
+			break;
 	}
 
+	/*
+	 * We failed to grab the lock, lets add ourself to the
+	 * list of applicants and block for the current lock holder.
+	 */
+	Applicant * const last = _last_applicant ? _last_applicant : &_owner;
+	last->applicant_to_wake_up(&myself);
+	_last_applicant = &myself;
+
 	spinlock_unlock(&_spinlock_state);
 
 	/*
 	 * At this point, a race can happen. We have added ourself to the wait
 	 * queue but do not block yet. If we get preempted here, the lock holder
-	 * may call 'unlock' and thereby find us as the next applicant to wake up.
-	 * However, the 'L4_Start' call will then be issued before we went to sleep
-	 * via 'L4_Stop'. When we get scheduled for the next time, we are expected
-	 * to enter the critical section but we will execute 'L4_Stop' instead.
-	 * We handle this case in the 'unlock' function by checking the previous
-	 * thread state when resuming its execution.
+	 * may call 'unlock' and thereby find us as the next applicant to wake up
+	 * before we went to sleep. The kernel-specific lock helper deals with
+	 * this case. Either 'thread_check_stopped_and_restart' fails until we
+	 * actually sleep, e.g., on L4 kernels, or it leaves a wake-up that lets
+	 * 'thread_stop_myself' return immediately, e.g., via the futex word on
+	 * Linux.
 	 *
 	 * Note for testing: To artificially increase the chance for triggering the
 	 * race condition, we can delay the execution here. For example via:
@@ -144,16 +179,87 @@ void Cancelable_lock::lock()
 			}
 		}
 
+		/* let the owner release the lock without the spinlock */
+		if (!_owner.applicant_to_wake_up()) {
+			_last_applicant = &_owner;
+			_state          = LOCKED;
+		}
+
+		if (_contention)
+			_contention->canceled++;
+
 		spinlock_unlock(&_spinlock_state);
 
 		throw Blocking_canceled();
 	}
+
+	/*
+	 * The owner is identified only until the handover is completed, which
+	 * prevents a later canceled applicant to mistake itself as owner.
+	 */
+	Applicant * const applicants = _owner.applicant_to_wake_up();
+	_owner = Applicant(invalid_thread_base());
+	_owner.applicant_to_wake_up(applicants);
+
 	spinlock_unlock(&_spinlock_state);
+
+	if (_contention) {
+		_contention->blocking++;
+		_contention_pending = true;
+	}
 }
 
 
+/**
+ * Contention event sampled by the lock owner, emitted on destruction
+ *
+ * Generating the trace event may take long and may even acquire other locks.
+ * Hence, 'unlock' samples the counters while still owning the lock but
+ * emits the event after releasing it.
+ */
+class Contention_event
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Contention_event(Contention_event const &);
+		Contention_event &operator = (Contention_event const &);
+
+		char const    *_name     = nullptr;
+		unsigned long  _spinning = 0;
+		unsigned long  _blocking = 0;
+
+	public:
+
+		Contention_event(Cancelable_lock::Contention const *contention)
+		{
+			if (!contention)
+				return;
+
+			_name     = contention->name;
+			_spinning = contention->spinning;
+			_blocking = contention->blocking;
+		}
+
+		~Contention_event()
+		{
+			if (_name)
+				Trace::Lock_contention(_name, _spinning, _blocking);
+		}
+};
+
+
 void Cancelable_lock::unlock()
 {
+	Contention_event const event(_contention_pending ? _contention : nullptr);
+	_contention_pending = false;
+
+	/* no applicants */
+	if (cmpxchg(&_state, LOCKED, UNLOCKED))
+		return;
+
 	spinlock_lock(&_spinlock_state);
 
 	Applicant *next_owner = _owner.applicant_to_wake_up();
@@ -169,6 +275,10 @@ void Cancelable_lock::unlock()
 		if (_last_applicant == next_owner)
 			_last_applicant = &_owner;
 
+		/* let the new owner release the lock without the spinlock */
+		if (!_owner.applicant_to_wake_up())
+			_state = LOCKED;
+
 		spinlock_unlock(&_spinlock_state);
 
 		owner.wake_up();
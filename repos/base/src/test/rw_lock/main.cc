@@ -0,0 +1,252 @@
+/*
+ * \brief  Test for 'Rw_lock' and 'Seqlock'
+ * \date   2026-10-18
+ *
+ * Reader threads check the consistency of data modified concurrently by
+ * writer threads. The data is protected by a reader-writer lock in the
+ * first test and by a sequence lock in the second test.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/thread.h>
+#include <base/rw_lock.h>
+#include <base/seqlock.h>
+
+using namespace Genode;
+
+
+/**
+ * Data that is consistent if both values match
+ */
+struct Pair
+{
+	unsigned long first  = 0;
+	unsigned long second = 0;
+
+	bool consistent() const { return first == second; }
+
+	void increment()
+	{
+		first++;
+
+		/* widen the window for observing inconsistent data */
+		for (unsigned volatile i = 0; i < 100; i++);
+
+		second++;
+	}
+};
+
+
+struct Worker : Thread
+{
+	enum { STACK_SIZE = 16*1024 };
+
+	unsigned const _rounds;
+	unsigned       _errors = 0;
+
+	Worker(Env &env, Name const &name, unsigned rounds)
+	: Thread(env, name, STACK_SIZE), _rounds(rounds) { }
+
+	unsigned errors() const { return _errors; }
+};
+
+
+struct Rw_lock_reader : Worker
+{
+	Rw_lock    &_lock;
+	Pair const &_pair;
+
+	/* number of readers holding the lock */
+	int volatile &_readers;
+	int volatile &_max_readers;
+
+	Rw_lock_reader(Env &env, Name const &name, unsigned rounds, Rw_lock &lock,
+	               Pair const &pair, int volatile &readers,
+	               int volatile &max_readers)
+	:
+		Worker(env, name, rounds), _lock(lock), _pair(pair),
+		_readers(readers), _max_readers(max_readers)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _rounds; i++) {
+			Rw_lock::Shared_guard guard(_lock);
+
+			int readers = _readers;
+			while (!cmpxchg(&_readers, readers, readers + 1))
+				readers = _readers;
+
+			if (readers + 1 > _max_readers)
+				_max_readers = readers + 1;
+
+			if (!_pair.consistent())
+				_errors++;
+
+			readers = _readers;
+			while (!cmpxchg(&_readers, readers, readers - 1))
+				readers = _readers;
+		}
+	}
+};
+
+
+struct Rw_lock_writer : Worker
+{
+	Rw_lock &_lock;
+	Pair    &_pair;
+
+	int volatile &_readers;
+
+	Rw_lock_writer(Env &env, Name const &name, unsigned rounds, Rw_lock &lock,
+	               Pair &pair, int volatile &readers)
+	:
+		Worker(env, name, rounds), _lock(lock), _pair(pair), _readers(readers)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _rounds; i++) {
+			Rw_lock::Guard guard(_lock);
+
+			if (_readers)
+				_errors++;
+
+			_pair.increment();
+		}
+	}
+};
+
+
+struct Seqlock_reader : Worker
+{
+	Seqlock    &_lock;
+	Pair const &_pair;
+
+	Seqlock_reader(Env &env, Name const &name, unsigned rounds,
+	               Seqlock &lock, Pair const &pair)
+	: Worker(env, name, rounds), _lock(lock), _pair(pair) { }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _rounds; i++) {
+			Pair copy;
+			_lock.read([&] () {
+				copy.first  = _pair.first;
+				copy.second = _pair.second;
+			});
+
+			if (!copy.consistent())
+				_errors++;
+		}
+	}
+};
+
+
+struct Seqlock_writer : Worker
+{
+	Seqlock &_lock;
+	Pair    &_pair;
+
+	Seqlock_writer(Env &env, Name const &name, unsigned rounds,
+	               Seqlock &lock, Pair &pair)
+	: Worker(env, name, rounds), _lock(lock), _pair(pair) { }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _rounds; i++)
+			_lock.write([&] () { _pair.increment(); });
+	}
+};
+
+
+struct Main
+{
+	enum { READER_ROUNDS = 200*1000, WRITER_ROUNDS = 20*1000 };
+
+	Env &_env;
+
+	unsigned _errors = 0;
+
+	template <typename... WORKERS>
+	void _run(WORKERS &... workers)
+	{
+		Worker *all[] = { &workers... };
+
+		for (Worker *w : all) w->start();
+		for (Worker *w : all) w->join();
+
+		for (Worker *w : all) {
+			if (!w->errors())
+				continue;
+
+			error(w->name(), " observed ", w->errors(), " errors");
+			_errors += w->errors();
+		}
+	}
+
+	void _test_rw_lock()
+	{
+		Rw_lock      lock;
+		Pair         pair;
+		int volatile readers     = 0;
+		int volatile max_readers = 0;
+
+		Rw_lock_reader r1(_env, "reader 1", READER_ROUNDS, lock, pair, readers, max_readers);
+		Rw_lock_reader r2(_env, "reader 2", READER_ROUNDS, lock, pair, readers, max_readers);
+		Rw_lock_reader r3(_env, "reader 3", READER_ROUNDS, lock, pair, readers, max_readers);
+		Rw_lock_writer w1(_env, "writer 1", WRITER_ROUNDS, lock, pair, readers);
+		Rw_lock_writer w2(_env, "writer 2", WRITER_ROUNDS, lock, pair, readers);
+
+		_run(r1, r2, r3, w1, w2);
+
+		if (pair.first != 2*WRITER_ROUNDS) {
+			error("rw_lock: ", pair.first, " instead of ",
+			      (unsigned)2*WRITER_ROUNDS, " writes");
+			_errors++;
+		}
+		log("rw_lock: up to ", max_readers, " readers held the lock together");
+	}
+
+	void _test_seqlock()
+	{
+		Seqlock lock;
+		Pair    pair;
+
+		Seqlock_reader r1(_env, "reader 1", READER_ROUNDS, lock, pair);
+		Seqlock_reader r2(_env, "reader 2", READER_ROUNDS, lock, pair);
+		Seqlock_writer w1(_env, "writer 1", WRITER_ROUNDS, lock, pair);
+		Seqlock_writer w2(_env, "writer 2", WRITER_ROUNDS, lock, pair);
+
+		_run(r1, r2, w1, w2);
+
+		if (pair.first != 2*WRITER_ROUNDS) {
+			error("seqlock: ", pair.first, " instead of ",
+			      (unsigned)2*WRITER_ROUNDS, " writes");
+			_errors++;
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- rw_lock test started ---");
+
+		_test_rw_lock();
+		_test_seqlock();
+
+		log("--- rw_lock test finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
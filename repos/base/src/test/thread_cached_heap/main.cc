@@ -0,0 +1,113 @@
+/*
+ * \brief  Test for 'Thread_cached_heap'
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/thread_cached_heap.h>
+#include <util/string.h>
+
+using namespace Genode;
+
+
+struct Worker : Thread
+{
+	Thread_cached_heap &_alloc;
+
+	unsigned errors = 0;
+
+	Worker(Env &env, Thread_cached_heap &alloc, char const *name)
+	: Thread(env, name, 16*1024), _alloc(alloc) { start(); }
+
+	void entry() override
+	{
+		enum { ROUNDS = 1000, BLOCKS = 64 };
+
+		void *blocks[BLOCKS] { };
+
+		for (unsigned round = 0; round < ROUNDS; round++) {
+
+			for (unsigned i = 0; i < BLOCKS; i++) {
+				size_t const size = 1 + (i*37 + round) % 3000;
+
+				if (!_alloc.alloc(size, &blocks[i])) {
+					errors++;
+					blocks[i] = nullptr;
+					continue;
+				}
+				memset(blocks[i], (int)i, size);
+			}
+
+			for (unsigned i = 0; i < BLOCKS; i++)
+				if (blocks[i])
+					_alloc.free(blocks[i], 0);
+		}
+
+		_alloc.flush();
+		_alloc.detach();
+	}
+};
+
+
+struct Main
+{
+	Env &_env;
+
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Thread_cached_heap _cache { _heap };
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- thread-cached heap test ---");
+
+		size_t const consumed_before = _heap.consumed();
+
+		{
+			Worker w1(_env, _cache, "w1"), w2(_env, _cache, "w2"),
+			       w3(_env, _cache, "w3"), w4(_env, _cache, "w4");
+
+			w1.join(); w2.join(); w3.join(); w4.join();
+
+			unsigned const errors = w1.errors + w2.errors + w3.errors + w4.errors;
+			if (errors)
+				error(errors, " allocations failed");
+		}
+
+		/* all blocks were returned to the backing heap via 'flush' */
+		if (_heap.consumed() != consumed_before)
+			error("heap consumption differs: ", _heap.consumed(),
+			      " != ", consumed_before);
+
+		/* slots released via 'detach' are claimed by later threads */
+		for (unsigned i = 0; i < Thread_cached_heap::MAX_THREADS + 4; i++) {
+			Worker w(_env, _cache, "w");
+			w.join();
+		}
+		if (_cache.attached_threads())
+			error(_cache.attached_threads(), " slots not released");
+
+		if (_heap.consumed() != consumed_before)
+			error("heap consumption differs after detach: ", _heap.consumed(),
+			      " != ", consumed_before);
+
+		/* cached blocks are subject to the quota limit of the backing heap */
+		_heap.quota_limit(_heap.consumed() + 4096);
+		void *block = nullptr;
+		if (_cache.alloc(8192, &block))
+			error("allocation beyond quota limit succeeded");
+
+		log("--- thread-cached heap test finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -121,28 +121,47 @@ struct Nitpicker_buffer
 		fn(pixel, alpha);
 	}
 
-	void reset_surface()
+	/**
+	 * Reset the back buffer within the specified rectangle
+	 */
+	void reset_surface(Rect rect)
 	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
 		Pixel_surface pixel(pixel_surface_ds.local_addr<Pixel_rgb888>(), size());
 		Alpha_surface alpha(alpha_surface_ds.local_addr<Pixel_alpha8>(), size());
 
-		Genode::size_t const num_pixels = size().count();
-		Genode::memset(alpha.addr(), 0, num_pixels);
-
 		/*
 		 * Initialize color buffer with 50% gray
 		 *
 		 * We do not use black to limit the bleeding of black into antialiased
 		 * drawing operations applied onto an initially transparent background.
 		 */
-		Pixel_rgb888 *dst = pixel.addr();
-
 		Pixel_rgb888 const gray(127, 127, 127, 255);
 
-		for (unsigned n = num_pixels; n; n--)
-			*dst++ = gray;
+		unsigned const line_len = size().w();
+		unsigned const offset   = rect.y1()*line_len + rect.x1();
+
+		Pixel_rgb888 *pixel_line = pixel.addr() + offset;
+		Pixel_alpha8 *alpha_line = alpha.addr() + offset;
+
+		for (unsigned y = 0; y < rect.h(); y++) {
+
+			Genode::memset(alpha_line, 0, rect.w());
+
+			Pixel_rgb888 *dst = pixel_line;
+			for (unsigned n = rect.w(); n; n--)
+				*dst++ = gray;
+
+			pixel_line += line_len;
+			alpha_line += line_len;
+		}
 	}
 
+	void reset_surface() { reset_surface(Rect(Point(0, 0), size())); }
+
 	template <typename DST_PT, typename SRC_PT>
 	void _convert_back_to_front(DST_PT                        *front_base,
 	                            Genode::Texture<SRC_PT> const &texture,
@@ -155,7 +174,7 @@ struct Nitpicker_buffer
 		Dither_painter::paint(surface, texture, Point());
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		unsigned const num_pixels = size().count();
 
@@ -164,8 +183,8 @@ struct Nitpicker_buffer
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
+		unsigned const line_len = size().w();
+		unsigned const offset   = rect.y1()*line_len + rect.x1();
 
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
@@ -174,21 +193,32 @@ struct Nitpicker_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (unsigned y = 0; y < rect.h(); y++) {
+
+			unsigned char const *src = alpha_base + offset + y*line_len;
+			unsigned char       *dst = input_base + offset + y*line_len;
+
+			for (unsigned i = 0; i < rect.w(); i++)
+				*dst++ = (*src++) > threshold;
+		}
 	}
 
-	void flush_surface()
+	/**
+	 * Transfer the back buffer within the specified rectangle to the
+	 * virtual framebuffer
+	 */
+	void flush_surface(Rect clip_rect)
 	{
+		clip_rect = Rect::intersect(clip_rect, Rect(Point(0, 0), size()));
+		if (!clip_rect.valid())
+			return;
+
 		/* represent back buffer as texture */
 		Genode::Texture<Pixel_rgb888>
 			texture(pixel_surface_ds.local_addr<Pixel_rgb888>(),
 			        alpha_surface_ds.local_addr<unsigned char>(),
 			        size());
 
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
-
 		Pixel_rgb565 *pixel_base = fb_ds.local_addr<Pixel_rgb565>();
 		Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 		                         + mode.bytes_per_pixel()*size().count();
@@ -196,8 +226,10 @@ struct Nitpicker_buffer
 		_convert_back_to_front(pixel_base, texture, clip_rect);
 		_convert_back_to_front(alpha_base, texture, clip_rect);
 
-		_update_input_mask();
+		_update_input_mask(clip_rect);
 	}
+
+	void flush_surface() { flush_surface(Rect(Point(0, 0), size())); }
 };
 
 #endif /* _INCLUDE__GEMS__NITPICKER_BUFFER_H_ */
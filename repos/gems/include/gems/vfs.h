@@ -217,6 +217,23 @@ struct Genode::Directory : Noncopyable, Interface
 
 			return stat.size;
 		}
+
+		/**
+		 * Return dataspace of file at specified directory-relative path
+		 *
+		 * The returned capability is invalid if the file system does not
+		 * provide the file content as dataspace. A valid dataspace must be
+		 * handed back via 'release' once it is no longer used.
+		 */
+		Dataspace_capability dataspace(Path const &rel_path) const
+		{
+			return _nonconst_fs().dataspace(Path(_path, "/", rel_path).string());
+		}
+
+		void release(Path const &rel_path, Dataspace_capability ds) const
+		{
+			_nonconst_fs().release(Path(_path, "/", rel_path).string(), ds);
+		}
 };
 
 
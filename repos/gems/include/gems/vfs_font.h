@@ -14,6 +14,7 @@
 #ifndef _INCLUDE__GEMS__VFS_FONT_T_
 #define _INCLUDE__GEMS__VFS_FONT_T_
 
+#include <base/attached_dataspace.h>
 #include <gems/vfs.h>
 #include <nitpicker_gfx/text_painter.h>
 
@@ -24,7 +25,9 @@ class Genode::Vfs_font : public Text_painter::Font
 {
 	public:
 
-		typedef Glyph_painter::Glyph Glyph;
+		typedef Glyph_painter::Glyph    Glyph;
+		typedef Text_painter::Codepoint Codepoint;
+		typedef Text_painter::Area      Area;
 
 		static constexpr Vfs::file_size GLYPH_SLOT_BYTES = 64*1024;
 
@@ -68,11 +71,62 @@ class Genode::Vfs_font : public Text_painter::Font
 
 		} __attribute__((packed));
 
+		/**
+		 * Layout of the glyph atlas
+		 *
+		 * The atlas contains the pre-rendered glyphs of the codepoints
+		 * 0 ... 'num_codepoints' - 1 in slots of 'slot_bytes' each. Each slot
+		 * starts with a 'Glyph_header'. The atlas is provided as dataspace so
+		 * that the components using a font can share the rendered glyphs.
+		 */
+		struct Atlas_header
+		{
+			uint32_t num_codepoints;
+			uint32_t slot_bytes;
+
+			static constexpr size_t slots_offset() { return 64; }
+
+			/**
+			 * Return size of a slot for glyphs of the given font
+			 *
+			 * A rendered glyph may exceed the bounding box of the font by
+			 * one pixel in each dimension, e.g., due to the padding added by
+			 * the TTF renderer. Each pixel is horizontally stretched by 4.
+			 */
+			static size_t slot_bytes_for(Area bounding_box)
+			{
+				return align_addr(sizeof(Glyph_header)
+				                  + 4*(bounding_box.w() + 1)*(bounding_box.h() + 1), 2);
+			}
+
+			/**
+			 * Return number of glyph rows of 'width' that fit in a slot
+			 */
+			size_t slot_rows(unsigned width) const
+			{
+				size_t const row_bytes = 4*width*sizeof(Glyph::Opacity);
+				return row_bytes ? (slot_bytes - sizeof(Glyph_header))/row_bytes : 0;
+			}
+
+			static size_t size(unsigned num_codepoints, Area bounding_box)
+			{
+				return slots_offset() + num_codepoints*slot_bytes_for(bounding_box);
+			}
+
+			Glyph_header const *slot(Codepoint c) const
+			{
+				if (c.value >= num_codepoints)
+					return nullptr;
+
+				return (Glyph_header const *)((char const *)this + slots_offset()
+				                              + c.value*slot_bytes);
+			}
+
+		} __attribute__((packed));
+
 	private:
 
-		typedef Text_painter::Codepoint Codepoint;
-		typedef Text_painter::Area      Area;
-		typedef Directory::Path         Path;
+		typedef Directory::Path Path;
 
 		Directory const _font_dir;
 		unsigned  const _baseline;
@@ -101,6 +155,67 @@ class Genode::Vfs_font : public Text_painter::Font
 
 		Readonly_file _glyphs_file;
 
+		/*
+		 * Glyph atlas shared with the component that renders the font
+		 *
+		 * The atlas is attached writable because region maps do not offer
+		 * read-only attachments. Any client sharing the atlas can modify
+		 * its content, including the header, at any time.
+		 */
+		struct Atlas : Noncopyable
+		{
+			Directory const     &_dir;
+			Dataspace_capability _ds;
+			Attached_dataspace   _attached;
+
+			Atlas(Region_map &rm, Directory const &dir, Dataspace_capability ds)
+			: _dir(dir), _ds(ds), _attached(rm, ds) { }
+
+			~Atlas() { _dir.release("atlas", _ds); }
+
+			Atlas_header const &header() const {
+				return *_attached.local_addr<Atlas_header const>(); }
+
+			size_t size() const { return _attached.size(); }
+		};
+
+		Constructible<Atlas> _atlas { };
+
+		void _attach_atlas(Region_map &rm)
+		{
+			Dataspace_capability const ds = _font_dir.dataspace("atlas");
+			if (!ds.valid())
+				return;
+
+			_atlas.construct(rm, _font_dir, ds);
+
+			/* ignore atlas that does not match the dimensions of the font */
+			Atlas_header const &header = _atlas->header();
+			if (header.slot_bytes != Atlas_header::slot_bytes_for(_bounding_box)
+			 || _atlas->size() < Atlas_header::size(header.num_codepoints,
+			                                        _bounding_box)) {
+				warning("ignoring glyph atlas of inconsistent size");
+				_atlas.destruct();
+			}
+		}
+
+		Glyph_header const *_atlas_slot(Codepoint c) const
+		{
+			if (!_atlas.constructed())
+				return nullptr;
+
+			Atlas_header const &header = _atlas->header();
+			Glyph_header const *slot   = header.slot(c);
+
+			/* ignore glyph that exceeds its slot */
+			if (slot) {
+				Glyph const glyph = slot->glyph();
+				if (glyph.height > header.slot_rows(glyph.width))
+					return nullptr;
+			}
+			return slot;
+		}
+
 		template <typename T, unsigned MAX_LEN = 128>
 		static T _value_from_file(Directory const &dir, Path const &path,
 		                          T const &default_value)
@@ -145,8 +260,34 @@ class Genode::Vfs_font : public Text_painter::Font
 			_glyphs_file(_font_dir, "glyphs")
 		{ }
 
+		/**
+		 * Constructor
+		 *
+		 * \param rm  region map used to attach the glyph atlas
+		 *
+		 * If the font directory provides a glyph atlas as dataspace, the
+		 * glyphs contained in the atlas are taken from there instead of being
+		 * read from the glyphs file. The atlas dataspace is writable by
+		 * every client that attaches it. Hence, a shared atlas must be
+		 * provided only to components that trust each other.
+		 *
+		 * \throw Unavailable  unable to obtain font data
+		 */
+		Vfs_font(Allocator &alloc, Region_map &rm, Directory const &dir,
+		         Path const &path)
+		:
+			Vfs_font(alloc, dir, path)
+		{
+			_attach_atlas(rm);
+		}
+
 		void _apply_glyph(Codepoint c, Apply_fn const &fn) const override
 		{
+			if (Glyph_header const *slot = _atlas_slot(c)) {
+				fn.apply(slot->glyph());
+				return;
+			}
+
 			_glyphs_file.read(_file_pos(c), _buffer.ptr(), _buffer.num_bytes);
 
 			fn.apply(_buffer.header.glyph());
@@ -154,9 +295,14 @@ class Genode::Vfs_font : public Text_painter::Font
 
 		Advance_info advance_info(Codepoint c) const override
 		{
-			_glyphs_file.read(_file_pos(c), _buffer.ptr(), sizeof(Glyph_header));
+			Glyph_header const *slot = _atlas_slot(c);
+
+			if (!slot) {
+				_glyphs_file.read(_file_pos(c), _buffer.ptr(), sizeof(Glyph_header));
+				slot = &_buffer.header;
+			}
 
-			Glyph const glyph = _buffer.header.glyph();
+			Glyph const glyph = slot->glyph();
 
 			return Advance_info { .width = glyph.width, .advance = glyph.advance };
 		}
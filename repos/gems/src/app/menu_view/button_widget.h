@@ -156,6 +156,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 	{
 		blend.animate();
 
+		_mark_as_changed();
+
 		animated(blend != blend.dst());
 	}
 };
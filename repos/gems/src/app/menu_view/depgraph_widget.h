@@ -574,6 +574,9 @@ struct Menu_view::Depgraph_widget : Widget
 
 	Area min_size() const override { return _min_size; }
 
+	/* the connections depend on the positions of the children */
+	bool _depends_on_children() const override { return true; }
+
 	void _draw_connect(Surface<Pixel_rgb888> &pixel_surface,
 	                   Surface<Pixel_alpha8> &alpha_surface,
 	                   Point p1, Point p2, Color color, bool horizontal) const
@@ -164,7 +164,7 @@ void Menu_view::Main::_handle_dialog_update()
 	try {
 		Xml_node dialog_xml(_dialog_rom.local_addr<char>());
 
-		_root_widget.update(dialog_xml);
+		_root_widget.apply(dialog_xml);
 		_root_widget.size(_root_widget.min_size());
 	} catch (...) {
 		Genode::error("failed to construct widget tree");
@@ -269,23 +269,42 @@ void Menu_view::Main::_handle_frame_timer()
 		Area const old_size = _buffer.constructed() ? _buffer->size() : Area();
 		Area const size     = _root_widget.min_size();
 
-		if (!_buffer.constructed() || size.w() > old_size.w() || size.h() > old_size.h())
+		bool const new_buffer = !_buffer.constructed()
+		                     || size.w() > old_size.w() || size.h() > old_size.h();
+		if (new_buffer)
 			_buffer.construct(_nitpicker, size, _env.ram(), _env.rm());
-		else
-			_buffer->reset_surface();
 
 		_root_widget.size(size);
 		_root_widget.position(Point(0, 0));
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
-		                               Surface<Pixel_alpha8> &alpha) {
-			_root_widget.draw(pixel, alpha, Point(0, 0));
+		Rect const buffer_rect(Point(0, 0), _buffer->size());
+
+		/* restrict redraw to the areas of changed widgets */
+		Dirty_rect dirty { };
+		_root_widget.mark_changed_areas(dirty, Point(0, 0));
+
+		if (new_buffer)
+			dirty.mark_as_dirty(buffer_rect);
+
+		dirty.flush([&] (Rect const &rect) {
+
+			Rect const clipped = Rect::intersect(rect, buffer_rect);
+			if (!clipped.valid())
+				return;
+
+			_buffer->reset_surface(clipped);
+			_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
+			                               Surface<Pixel_alpha8> &alpha) {
+				pixel.clip(clipped);
+				alpha.clip(clipped);
+				_root_widget.draw(pixel, alpha, Point(0, 0));
+			});
+			_buffer->flush_surface(clipped);
+
+			_nitpicker.framebuffer()->refresh(clipped.x1(), clipped.y1(),
+			                                  clipped.w(), clipped.h());
 		});
 
-		_buffer->flush_surface();
-		_nitpicker.framebuffer()->refresh(0, 0, _buffer->size().w(), _buffer->size().h());
 		_update_view();
 
 		_schedule_redraw = false;
@@ -95,6 +95,52 @@ class Menu_view::Widget : public List_model<Widget>::Element
 
 		Unique_id const _unique_id;
 
+		/*
+		 * Digests of the XML node last applied, used to skip the update of
+		 * unchanged widgets
+		 */
+		uint64_t _node_digest = 0; /* node including its sub nodes */
+		uint64_t _tag_digest  = 0; /* start tag with the attributes */
+
+		static uint64_t _digest(char const *s, size_t len)
+		{
+			/* FNV-1a */
+			uint64_t h = 0xcbf29ce484222325ULL;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (unsigned char)s[i])*0x100000001b3ULL;
+			return h;
+		}
+
+		/*
+		 * State of the last redraw, used to determine the dirty areas
+		 */
+		bool _drawn        = false;
+		Rect _drawn_rect   { };     /* absolute position */
+		Rect _vanished     { };     /* area of removed children */
+		bool _needs_redraw = true;
+		bool _needs_layout = true;
+
+		static bool _same(Rect const &r1, Rect const &r2)
+		{
+			return r1.p1() == r2.p1() && r1.p2() == r2.p2();
+		}
+
+		/**
+		 * Return true if the subtree changed since the last redraw
+		 */
+		bool _changed(Point at) const
+		{
+			if (_needs_redraw || !_drawn || _vanished.valid()
+			 || !_same(_drawn_rect, Rect(at, _animated_geometry.area())))
+				return true;
+
+			bool result = false;
+			_children.for_each([&] (Widget const &w) {
+				result |= w._changed(at + w._animated_geometry.p1()); });
+
+			return result;
+		}
+
 	protected:
 
 		Widget_factory &_factory;
@@ -104,10 +150,21 @@ class Menu_view::Widget : public List_model<Widget>::Element
 		struct Model_update_policy : List_model<Widget>::Update_policy
 		{
 			Widget_factory &_factory;
+			Widget         &_owner;
 
-			Model_update_policy(Widget_factory &factory) : _factory(factory) { }
+			Model_update_policy(Widget_factory &factory, Widget &owner)
+			: _factory(factory), _owner(owner) { }
 
-			void destroy_element(Widget &w) { _factory.destroy(&w); }
+			void destroy_element(Widget &w)
+			{
+				/* the area covered by the widget must be redrawn */
+				if (w._drawn)
+					_owner._vanished = _owner._vanished.valid()
+					                 ? Rect::compound(_owner._vanished, w._drawn_rect)
+					                 : w._drawn_rect;
+
+				_factory.destroy(&w);
+			}
 
 			Widget &create_element(Xml_node elem_node)
 			{
@@ -117,7 +174,7 @@ class Menu_view::Widget : public List_model<Widget>::Element
 				throw Unknown_element_type();
 			}
 
-			void update_element(Widget &w, Xml_node node) { w.update(node); }
+			void update_element(Widget &w, Xml_node node) { w.apply(node); }
 
 			static bool element_matches_xml_node(Widget const &w, Xml_node node)
 			{
@@ -125,7 +182,7 @@ class Menu_view::Widget : public List_model<Widget>::Element
 				    && Widget::node_name(node) == w._name;
 			}
 
-		} _model_update_policy { _factory };
+		} _model_update_policy { _factory, *this };
 
 		inline void _update_children(Xml_node node)
 		{
@@ -142,6 +199,18 @@ class Menu_view::Widget : public List_model<Widget>::Element
 
 		virtual void _layout() { }
 
+		/**
+		 * Return true if the drawing of the widget depends on its children
+		 *
+		 * Such a widget is redrawn as a whole whenever a child changes.
+		 */
+		virtual bool _depends_on_children() const { return false; }
+
+		/**
+		 * Request the redraw of the widget, e.g., when animated
+		 */
+		void _mark_as_changed() { _needs_redraw = true; }
+
 		Rect _inner_geometry() const
 		{
 			return Rect(Point(margin.left, margin.top),
@@ -199,6 +268,31 @@ class Menu_view::Widget : public List_model<Widget>::Element
 
 		virtual void update(Xml_node node) = 0;
 
+		/**
+		 * Update widget from XML node
+		 *
+		 * The update is skipped if the node is equal to the node applied
+		 * last. A widget is redrawn as a whole only if its own attributes
+		 * changed.
+		 */
+		void apply(Xml_node node)
+		{
+			uint64_t const node_digest = _digest(node.addr(), node.size());
+			uint64_t const tag_digest  = _digest(node.addr(),
+			                                     node.content_base() - node.addr());
+			if (node_digest == _node_digest)
+				return;
+
+			if (tag_digest != _tag_digest || _depends_on_children())
+				_needs_redraw = true;
+
+			_node_digest  = node_digest;
+			_tag_digest   = tag_digest;
+			_needs_layout = true;
+
+			update(node);
+		}
+
 		virtual Area min_size() const = 0;
 
 		virtual void draw(Surface<Pixel_rgb888> &pixel_surface,
@@ -207,9 +301,15 @@ class Menu_view::Widget : public List_model<Widget>::Element
 
 		void size(Area size)
 		{
+			/* the layout of an unchanged widget remains the same */
+			if (!_needs_layout && size == _geometry.area())
+				return;
+
 			_geometry = Rect(_geometry.p1(), size);
 
 			_layout();
+
+			_needs_layout = false;
 		}
 
 		void position(Point position)
@@ -217,6 +317,39 @@ class Menu_view::Widget : public List_model<Widget>::Element
 			_geometry = Rect(position, _geometry.area());
 		}
 
+		/**
+		 * Mark areas that changed since the last redraw as dirty
+		 *
+		 * \param at  absolute position of the widget
+		 *
+		 * The caller must redraw the marked areas.
+		 */
+		void mark_changed_areas(Dirty_rect &dirty, Point at)
+		{
+			Rect const rect(at, _animated_geometry.area());
+
+			bool const whole = _needs_redraw || !_drawn
+			                || !_same(rect, _drawn_rect)
+			                || (_depends_on_children() && _changed(at));
+
+			auto mark = [&] (Rect const &r) {
+				if (r.valid()) dirty.mark_as_dirty(r); };
+
+			if (whole) {
+				if (_drawn) mark(_drawn_rect);
+				mark(rect);
+			}
+			mark(_vanished);
+
+			_drawn        = true;
+			_drawn_rect   = rect;
+			_vanished     = Rect();
+			_needs_redraw = false;
+
+			_children.for_each([&] (Widget &w) {
+				w.mark_changed_areas(dirty, at + w._animated_geometry.p1()); });
+		}
+
 		/**
 		 * Return unique ID of inner-most hovered widget
 		 *
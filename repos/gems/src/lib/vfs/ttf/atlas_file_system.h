@@ -0,0 +1,202 @@
+/*
+ * \brief  Glyph-atlas file system
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ATLAS_FILE_SYSTEM_H_
+#define _ATLAS_FILE_SYSTEM_H_
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <vfs/single_file_system.h>
+#include <nitpicker_gfx/text_painter.h>
+
+/* gems includes */
+#include <gems/vfs_font.h>
+
+namespace Vfs {
+
+	using namespace Genode;
+
+	class Atlas_file_system;
+
+	typedef Text_painter::Font     Font;
+	typedef Vfs_font::Glyph_header Glyph_header;
+	typedef Vfs_font::Atlas_header Atlas_header;
+}
+
+
+/**
+ * File that contains the pre-rendered glyphs of the lowest codepoints
+ *
+ * The atlas is rendered once into a RAM dataspace when it is accessed first.
+ * Besides reading the file, clients can obtain the dataspace via the
+ * 'dataspace' interface of the VFS. This way, all users of the font share
+ * the same rendered glyphs. Note that the RAM dataspace is writable by
+ * every client that attaches it. So the atlas must be shared only among
+ * components that trust each other.
+ */
+class Vfs::Atlas_file_system : public Vfs::Single_file_system
+{
+	private:
+
+		Env        &_env;
+		Font const &_font;
+
+		unsigned const _num_codepoints;
+		size_t   const _slot_bytes = Atlas_header::slot_bytes_for(_font.bounding_box());
+		size_t   const _size = Atlas_header::size(_num_codepoints, _font.bounding_box());
+
+		Constructible<Attached_ram_dataspace> _ds { };
+
+		/**
+		 * Return atlas, render it on first access
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Attached_ram_dataspace &_atlas()
+		{
+			if (_ds.constructed())
+				return *_ds;
+
+			_ds.construct(_env.ram(), _env.rm(), _size);
+
+			char * const base = _ds->local_addr<char>();
+
+			Atlas_header &header = *(Atlas_header *)base;
+			header.num_codepoints = _num_codepoints;
+			header.slot_bytes     = _slot_bytes;
+
+			for (unsigned i = 0; i < _num_codepoints; i++) {
+
+				char * const slot = base + Atlas_header::slots_offset()
+				                  + i*_slot_bytes;
+
+				_font.apply_glyph(Codepoint { i }, [&] (Glyph_painter::Glyph const &glyph) {
+
+					/* crop glyph to the rows that fit in the slot */
+					Glyph_painter::Glyph const cropped {
+						.width   = glyph.width,
+						.height  = (unsigned)min((size_t)glyph.height,
+						                         header.slot_rows(glyph.width)),
+						.vpos    = glyph.vpos,
+						.advance = glyph.advance,
+						.values  = glyph.values };
+
+					construct_at<Glyph_header>(slot, cropped);
+
+					memcpy(slot + sizeof(Glyph_header), cropped.values,
+					       cropped.num_values()*sizeof(Glyph_painter::Glyph::Opacity));
+				});
+			}
+			return *_ds;
+		}
+
+		struct Vfs_handle : Single_vfs_handle
+		{
+			Atlas_file_system &_fs;
+
+			Vfs_handle(Directory_service &ds,
+			           File_io_service   &fs,
+			           Allocator         &alloc,
+			           Atlas_file_system &atlas_fs)
+			:
+				Single_vfs_handle(ds, fs, alloc, 0), _fs(atlas_fs)
+			{ }
+
+			Read_result read(char *dst, file_size count,
+			                 file_size &out_count) override
+			{
+				out_count = 0;
+
+				if (seek() >= _fs._size)
+					return READ_OK;
+
+				size_t const len = min(_fs._size - seek(), count);
+
+				try {
+					memcpy(dst, _fs._atlas().local_addr<char>() + seek(), len); }
+				catch (Genode::Out_of_ram)  { return READ_ERR_IO; }
+				catch (Genode::Out_of_caps) { return READ_ERR_IO; }
+
+				out_count = len;
+				return READ_OK;
+			}
+
+			Write_result write(char const *, file_size, file_size &) override
+			{
+				return WRITE_ERR_IO;
+			}
+
+			bool read_ready() override { return true; }
+		};
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_codepoints  number of glyphs contained in the atlas
+		 */
+		Atlas_file_system(Env &env, Font const &font, unsigned num_codepoints)
+		:
+			Single_file_system(NODE_TYPE_CHAR_DEVICE, type(), Xml_node("<atlas/>")),
+			_env(env), _font(font), _num_codepoints(num_codepoints)
+		{ }
+
+		static char const *type_name() { return "atlas"; }
+
+		char const *type() override { return type_name(); }
+
+
+		/*********************************
+		 ** Directory-service interface **
+		 *********************************/
+
+		Open_result open(char const  *path, unsigned,
+		                 Vfs::Vfs_handle **out_handle,
+		                 Allocator   &alloc) override
+		{
+			if (!_single_file(path))
+				return OPEN_ERR_UNACCESSIBLE;
+
+			try {
+				*out_handle = new (alloc) Vfs_handle(*this, *this, alloc, *this);
+				return OPEN_OK;
+			}
+			catch (Genode::Out_of_ram)  { return OPEN_ERR_OUT_OF_RAM; }
+			catch (Genode::Out_of_caps) { return OPEN_ERR_OUT_OF_CAPS; }
+		}
+
+		Stat_result stat(char const *path, Stat &out) override
+		{
+			Stat_result result = Single_file_system::stat(path, out);
+			out.mode |= 0444;
+			out.size = _size;
+			return result;
+		}
+
+		Dataspace_capability dataspace(char const *path) override
+		{
+			if (!_single_file(path))
+				return Dataspace_capability();
+
+			try { return _atlas().cap(); }
+			catch (Genode::Out_of_ram)  { }
+			catch (Genode::Out_of_caps) { }
+			return Dataspace_capability();
+		}
+
+		/* the atlas stays available for other clients */
+		void release(char const *, Dataspace_capability) override { }
+};
+
+#endif /* _ATLAS_FILE_SYSTEM_H_ */
@@ -22,6 +22,7 @@
 
 /* local includes */
 #include <glyphs_file_system.h>
+#include <atlas_file_system.h>
 
 namespace Vfs_ttf {
 
@@ -76,6 +77,7 @@ struct Vfs_ttf::Local_factory : File_system_factory
 	Cached_font::Limit                   _cache_limit;
 	Cached_font                          _cached_font;
 	Glyphs_file_system                   _glyphs_fs;
+	Atlas_file_system                    _atlas_fs;
 	Readonly_value_file_system<unsigned> _baseline_fs;
 	Readonly_value_file_system<unsigned> _max_width_fs;
 	Readonly_value_file_system<unsigned> _max_height_fs;
@@ -89,6 +91,7 @@ struct Vfs_ttf::Local_factory : File_system_factory
 		_cache_limit({node.attribute_value("cache", Number_of_bytes())}),
 		_cached_font(alloc, _font.font(), _cache_limit),
 		_glyphs_fs    (_cached_font),
+		_atlas_fs     (env, _font.font(), node.attribute_value("atlas", 256U)),
 		_baseline_fs  ("baseline",   _font.font().baseline()),
 		_max_width_fs ("max_width",  _font.font().bounding_box().w()),
 		_max_height_fs("max_height", _font.font().bounding_box().h())
@@ -100,6 +103,9 @@ struct Vfs_ttf::Local_factory : File_system_factory
 		if (node.has_type(Glyphs_file_system::type_name()))
 			return &_glyphs_fs;
 
+		if (node.has_type(Atlas_file_system::type_name()))
+			return &_atlas_fs;
+
 		if (node.has_type(Readonly_value_file_system<unsigned>::type_name()))
 			return _baseline_fs.matches(node)   ? &_baseline_fs
 			     : _max_width_fs.matches(node)  ? &_max_width_fs
@@ -126,6 +132,7 @@ class Vfs_ttf::File_system : private Local_factory,
 				typedef String<64> Name;
 				xml.attribute("name", node.attribute_value("name", Name()));
 				xml.node("glyphs", [&] () { });
+				xml.node("atlas",  [&] () { });
 				xml.node("readonly_value", [&] () { xml.attribute("name", "baseline");   });
 				xml.node("readonly_value", [&] () { xml.attribute("name", "max_width");  });
 				xml.node("readonly_value", [&] () { xml.attribute("name", "max_height"); });
@@ -81,8 +81,38 @@ struct Test::Main
 
 	Vfs_font _font_4 { _heap, _root, "fonts/regular" };
 
+	/* font that takes glyphs from the shared atlas if available */
+	Vfs_font _font_5 { _heap, _env.rm(), _root, "fonts/regular" };
+
 	void _refresh() { _fb.refresh(0, 0, _size.w(), _size.h()); }
 
+	/**
+	 * Measure text throughput of the glyph painter
+	 */
+	void _measure_throughput(char const *name, Text_painter::Font const &font)
+	{
+		_surface.clip(Rect(Point(0, 0), _size));
+
+		char const *text = "The quick brown fox jumps over the lazy dog";
+
+		Timer::Connection timer(_env);
+
+		unsigned long const start_us = timer.elapsed_us();
+
+		enum { ITERATIONS = 1000 };
+		for (int i = 0; i < ITERATIONS; i++)
+			Text_painter::paint(_surface,
+			                    Text_painter::Position(i*37 % 200, i*59 % 500),
+			                    font, Color(200, 100 + i*13, 50 + i*73), text);
+
+		unsigned long const end_us = timer.elapsed_us();
+		unsigned long const num_glyphs = strlen(text)*ITERATIONS;
+
+		log(name, " throughput: ", num_glyphs*1000/max(1UL, end_us - start_us),
+		    " glyphs/ms");
+		_refresh();
+	}
+
 	Main(Env &env) : _env(env)
 	{
 		/* test positioning of text */
@@ -199,6 +229,17 @@ struct Test::Main
 			    " (", cached_font.stats(), ")");
 			_refresh();
 		}
+
+		{
+			Cached_font cached_font(_heap, _font_4, Cached_font::Limit{256*1024});
+
+			/* warm up the cache */
+			Text_painter::paint(_surface, Text_painter::Position(0, 0), cached_font,
+			                    Color(0, 0, 0), "The quick brown fox jumps over the lazy dog");
+
+			_measure_throughput("cached font", cached_font);
+		}
+		_measure_throughput("atlas font ", _font_5);
 	}
 };
 
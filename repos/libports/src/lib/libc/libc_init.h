@@ -43,7 +43,7 @@ namespace Libc {
 	/**
 	 * Malloc allocator
          */
-	void init_malloc(Genode::Allocator &heap);
+	void init_malloc(Genode::Env &env, Genode::Allocator &heap);
 }
 
 #endif /* _LIBC_INIT_H_ */
@@ -1,12 +1,12 @@
 /*
- * \brief  Simplistic malloc and free implementation
+ * \brief  Multi-arena malloc and free implementation
  * \author Norman Feske
  * \author Sebastian Sumpf
  * \date   2006-07-21
  */
 
 /*
- * Copyright (C) 2006-2017 Genode Labs GmbH
+ * Copyright (C) 2006-2026 Genode Labs GmbH
  *
  * This file is part of the Genode OS framework, which is distributed
  * under the terms of the GNU Affero General Public License version 3.
@@ -16,7 +16,12 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
+#include <base/allocator_avl.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
 #include <util/construct_at.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 #include <util/misc_math.h>
 
@@ -65,7 +70,227 @@ namespace Genode {
 
 
 /**
- * Allocator that uses slabs for small objects sizes
+ * Virtual-memory window for large blocks that can be grown by remapping
+ *
+ * Each large block is backed by a list of RAM dataspaces (extents) attached
+ * back to back within a managed region map. Each block reserves twice its
+ * initial size of virtual space. Growing a block attaches an additional
+ * extent behind the existing ones. If the reservation is exhausted, the
+ * extents are re-attached at a larger free range of the window. Hence, the
+ * content of a large block is never copied.
+ */
+class Large_block_area
+{
+	private:
+
+		typedef Genode::size_t size_t;
+		typedef Genode::addr_t addr_t;
+
+		enum { WINDOW_SIZE = sizeof(addr_t) == 8 ? 1UL << 30 : 128UL << 20 };
+
+		struct Block
+		{
+			enum { MAX_EXTENTS = 16 };
+
+			struct Extent
+			{
+				Genode::Ram_dataspace_capability ds   { };
+				size_t                           size { 0 };
+			};
+
+			Extent   extents[MAX_EXTENTS] { };
+			unsigned num_extents { 0 };
+			size_t   capacity    { 0 }; /* mapped bytes */
+			size_t   va_size     { 0 }; /* reserved virtual bytes */
+		};
+
+		Genode::Env          &_env;
+		Genode::Rm_connection _rm_connection { _env };
+		Genode::Region_map_client _rm { _rm_connection.create(WINDOW_SIZE) };
+		addr_t const          _base = _env.rm().attach(_rm.dataspace());
+		Genode::Allocator_avl _va;
+		Genode::Lock          _lock { };
+
+		Block &_block(addr_t offset) { return *(Block *)(_base + offset); }
+
+		/**
+		 * Attach new extent of 'size' bytes at 'offset' within the window
+		 */
+		bool _attach_extent(Block::Extent &extent, addr_t offset, size_t size)
+		{
+			Genode::Ram_dataspace_capability ds;
+			try {
+				ds = _env.ram().alloc(size);
+				_rm.attach_at(ds, offset);
+			}
+			catch (...) {
+				if (ds.valid())
+					_env.ram().free(ds);
+				return false;
+			}
+			extent = Block::Extent { ds, size };
+			return true;
+		}
+
+		void _detach_extents(Block const &block, addr_t offset)
+		{
+			for (unsigned i = 0; i < block.num_extents; i++) {
+				_rm.detach(offset);
+				offset += block.extents[i].size;
+			}
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Large_block_area(Large_block_area const &);
+		Large_block_area &operator = (Large_block_area const &);
+
+	public:
+
+		/**
+		 * Bytes at the beginning of a block occupied by the extent list
+		 */
+		static constexpr size_t header_size() {
+			return Genode::align_addr(sizeof(Block), 4); }
+
+		Large_block_area(Genode::Env &env, Genode::Allocator &md_alloc)
+		: _env(env), _va(&md_alloc)
+		{
+			_va.add_range(0, WINDOW_SIZE);
+		}
+
+		/**
+		 * Allocate block with room for 'size' bytes behind the header
+		 *
+		 * \return  local address of the block or 0
+		 */
+		addr_t alloc(size_t size)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			size_t const capacity = Genode::align_addr(size + header_size(), 12);
+			size_t const va_size  = 2*capacity;
+
+			void *offset_ptr = nullptr;
+			if (_va.alloc_aligned(va_size, &offset_ptr, 12).error())
+				return 0;
+
+			addr_t const offset = (addr_t)offset_ptr;
+
+			Block::Extent extent { };
+			if (!_attach_extent(extent, offset, capacity)) {
+				_va.free(offset_ptr);
+				return 0;
+			}
+
+			Block &block = *Genode::construct_at<Block>((void *)(_base + offset));
+			block.extents[0]  = extent;
+			block.num_extents = 1;
+			block.capacity    = capacity;
+			block.va_size     = va_size;
+
+			return _base + offset;
+		}
+
+		/**
+		 * Grow block such that it can hold 'size' bytes behind the header
+		 *
+		 * \return  new local address of the block or 0 if the block could
+		 *          not be grown by remapping
+		 */
+		addr_t grow(addr_t addr, size_t size)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			addr_t       offset = addr - _base;
+			Block  const block  = _block(offset);
+
+			size_t const needed = Genode::align_addr(size + header_size(), 12);
+			if (needed <= block.capacity)
+				return addr;
+
+			if (block.num_extents == Block::MAX_EXTENTS)
+				return 0;
+
+			/* grow at least by the current capacity to keep extents few */
+			size_t const extent_size = Genode::max(needed - block.capacity,
+			                                       block.capacity);
+			size_t const capacity    = block.capacity + extent_size;
+			size_t       va_size     = block.va_size;
+
+			if (capacity > va_size) {
+
+				/* relocate extents to a larger range of the window */
+				void *new_offset_ptr = nullptr;
+				if (_va.alloc_aligned(2*capacity, &new_offset_ptr, 12).error())
+					return 0;
+
+				addr_t const new_offset = (addr_t)new_offset_ptr;
+
+				_detach_extents(block, offset);
+
+				addr_t at = new_offset;
+				for (unsigned i = 0; i < block.num_extents; i++) {
+					_rm.attach_at(block.extents[i].ds, at);
+					at += block.extents[i].size;
+				}
+
+				_va.free((void *)offset);
+				offset  = new_offset;
+				va_size = 2*capacity;
+			}
+
+			Block::Extent extent { };
+			if (!_attach_extent(extent, offset + block.capacity, extent_size)) {
+				_block(offset).va_size = va_size;
+				return offset == addr - _base ? 0 : _base + offset;
+			}
+
+			Block &b = _block(offset);
+			b.extents[b.num_extents++] = extent;
+			b.capacity = capacity;
+			b.va_size  = va_size;
+
+			return _base + offset;
+		}
+
+		/**
+		 * Return number of bytes usable behind the header
+		 */
+		size_t capacity(addr_t addr) {
+			return _block(addr - _base).capacity - header_size(); }
+
+		void free(addr_t addr)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			addr_t const offset = addr - _base;
+			Block  const block  = _block(offset);
+
+			_detach_extents(block, offset);
+
+			for (unsigned i = 0; i < block.num_extents; i++)
+				_env.ram().free(block.extents[i].ds);
+
+			_va.free((void *)offset);
+		}
+};
+
+
+/**
+ * Allocator that uses per-arena slabs for small objects sizes
+ *
+ * Small blocks are served from one of 'NUM_ARENAS' arenas, each protected by
+ * its own lock. A thread always uses the arena selected by its 'Thread'
+ * object, which spreads concurrent threads over distinct locks. Size classes
+ * advance in 16-byte steps up to 256 bytes and in quarter-power-of-two steps
+ * above. A block can be grown in place up to the size of its class.
+ *
+ * Blocks of at least 'LARGE_THRESHOLD' bytes are allocated at the
+ * 'Large_block_area', which grows them by remapping instead of copying.
+ * Other blocks beyond the largest size class are taken from the backing
+ * store.
  */
 class Malloc
 {
@@ -75,25 +300,39 @@ class Malloc
 		typedef Genode::addr_t addr_t;
 
 		enum {
-			SLAB_START = 5,  /* 32 bytes (log2) */
-			SLAB_STOP  = 11, /* 2048 bytes (log2) */
-			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1
+			NUM_ARENAS       = 4,
+			FINE_STEP        = 16,
+			FINE_STOP        = 256, /* largest class with 16-byte steps */
+			COARSE_STOP_LOG2 = 13,  /* 8192 bytes */
+			NUM_FINE         = FINE_STOP / FINE_STEP,
+			NUM_CLASSES      = NUM_FINE + (COARSE_STOP_LOG2 - 8)*4,
+			LARGE_THRESHOLD  = 64*1024,
+
+			/* arena-field values of blocks not allocated at an arena */
+			KIND_BACKING = 6,
+			KIND_LARGE   = 7,
 		};
 
 		struct Metadata
 		{
-			unsigned long long value; /* bits 63..5 size and 4..0 offset */
+			/* bits 63..8 size, 7..5 arena or kind, 4..0 offset */
+			unsigned long long value;
 
 			/**
 			 * Allocation metadata
 			 *
 			 * \param size    allocation size
+			 * \param arena   arena index or kind of allocation
 			 * \param offset  offset of pointer from allocation
 			 */
-			Metadata(size_t size, unsigned offset)
-			: value(((unsigned long long)size << 5) | (offset & 0x1f)) { }
+			Metadata(size_t size, unsigned arena, unsigned offset)
+			:
+				value(((unsigned long long)size << 8)
+				    | ((arena & 0x7) << 5) | (offset & 0x1f))
+			{ }
 
-			size_t   size()   const { return value >> 5; }
+			size_t   size()   const { return value >> 8; }
+			unsigned arena()  const { return (value >> 5) & 0x7; }
 			unsigned offset() const { return value & 0x1f; }
 		};
 
@@ -112,35 +351,126 @@ class Malloc
 		 */
 		static constexpr size_t _room() { return sizeof(Metadata) + 15; }
 
-		Genode::Allocator  &_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+		struct Arena
+		{
+			Genode::Lock                            lock { };
+			Genode::Constructible<Genode::Slab_alloc> slabs[NUM_CLASSES] { };
+		};
+
+		Genode::Env       &_env;
+		Genode::Allocator &_backing_store;   /* back-end allocator */
+		Arena              _arenas[NUM_ARENAS] { };
 
-		unsigned _slab_log2(size_t size) const
+		/*
+		 * The large-block area is created on the first large allocation.
+		 * So components that never allocate large blocks do not pay for
+		 * the RM session and its virtual-memory window.
+		 */
+		Genode::Constructible<Large_block_area> _large { };
+		Genode::Lock                            _large_lock { };
+		bool                                    _large_failed = false;
+
+		Large_block_area *_large_area()
 		{
-			unsigned msb = Genode::log2(size);
+			Genode::Lock::Guard guard(_large_lock);
+
+			if (!_large.constructed() && !_large_failed) {
+				try { _large.construct(_env, _backing_store); }
+				catch (...) {
+					_large_failed = true;
+					Genode::warning("malloc: no large-block area, "
+					                "large reallocations will be copied");
+				}
+			}
+			return _large.constructed() ? &*_large : nullptr;
+		}
 
-			/* size is greater than msb */
-			if (size > (1U << msb))
-				msb++;
+		static unsigned _size_class(size_t size)
+		{
+			if (size <= FINE_STOP)
+				return (size + FINE_STEP - 1)/FINE_STEP - 1;
 
-			/* use smallest slab */
-			if (size < (1U << SLAB_START))
-				msb = SLAB_START;
+			unsigned const msb  = Genode::log2(size - 1);
+			size_t   const step = 1UL << (msb - 2);
 
-			return msb;
+			return NUM_FINE + (msb - 8)*4 + (size - 1 - (1UL << msb))/step;
 		}
 
-	public:
+		static size_t _class_size(unsigned size_class)
+		{
+			if (size_class < NUM_FINE)
+				return (size_class + 1)*FINE_STEP;
+
+			unsigned const msb = 8 + (size_class - NUM_FINE)/4;
+			unsigned const sub = (size_class - NUM_FINE)%4;
+
+			return (1UL << msb) + (sub + 1)*(1UL << (msb - 2));
+		}
 
-		Malloc(Genode::Allocator &backing_store) : _backing_store(backing_store)
+		static unsigned _my_arena()
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] =
-					new (backing_store) Genode::Slab_alloc(1U << i, &backing_store);
-			}
+			addr_t const t = (addr_t)Genode::Thread::myself();
+
+			return ((t >> 4) ^ (t >> 12) ^ (t >> 20)) % NUM_ARENAS;
+		}
+
+		Genode::Slab_alloc &_slab(Arena &arena, unsigned size_class)
+		{
+			if (!arena.slabs[size_class].constructed())
+				arena.slabs[size_class].construct(_class_size(size_class),
+				                                  &_backing_store);
+
+			return *arena.slabs[size_class];
+		}
+
+		/**
+		 * Return number of bytes usable at 'ptr'
+		 */
+		static size_t _usable(void *ptr)
+		{
+			Metadata const &md = *((Metadata *)ptr - 1);
+			return md.size() - md.offset();
+		}
+
+		/**
+		 * Bytes between the block header of a large block and the pointer
+		 * returned to the caller
+		 *
+		 * The block and its header are page-aligned and 16-byte aligned. So
+		 * the pointer is 16-byte aligned.
+		 */
+		static constexpr size_t _large_room() {
+			return Genode::align_addr(sizeof(Metadata), 4); }
+
+		/**
+		 * Write metadata of large block and return pointer for the caller
+		 */
+		void *_init_large(addr_t block)
+		{
+			void * const ptr = (void *)(block + Large_block_area::header_size()
+			                                  + _large_room());
+
+			*((Metadata *)ptr - 1) =
+				Metadata(_large->capacity(block) - _large_room(), KIND_LARGE, 0);
+
+			return ptr;
+		}
+
+		void *_alloc_large(Large_block_area &large, size_t size)
+		{
+			addr_t const block = large.alloc(size + _large_room());
+
+			return block ? _init_large(block) : nullptr;
 		}
 
+		static addr_t _large_block(void *ptr) {
+			return (addr_t)ptr - _large_room() - Large_block_area::header_size(); }
+
+	public:
+
+		Malloc(Genode::Env &env, Genode::Allocator &backing_store)
+		: _env(env), _backing_store(backing_store) { }
+
 		~Malloc() { Genode::warning(__func__, " unexpectedly called"); }
 
 		/**
@@ -149,18 +479,32 @@ class Malloc
 
 		void * alloc(size_t size)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
+			size_t const real_size = size + _room();
 
-			size_t   const real_size = size + _room();
-			unsigned const msb       = _slab_log2(real_size);
+			if (real_size >= LARGE_THRESHOLD)
+				if (Large_block_area * const large = _large_area())
+					if (void * const ptr = _alloc_large(*large, size))
+						return ptr;
 
-			void *alloc_addr = nullptr;
+			void     *alloc_addr = nullptr;
+			size_t    block_size = real_size;
+			unsigned  arena_idx  = KIND_BACKING;
 
-			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
+			/* use backing store if requested memory is larger than largest class */
+			if (real_size > _class_size(NUM_CLASSES - 1)) {
 				_backing_store.alloc(real_size, &alloc_addr);
-			else
-				alloc_addr = _allocator[msb - SLAB_START]->alloc();
+
+			} else {
+
+				unsigned const size_class = _size_class(real_size);
+
+				arena_idx  = _my_arena();
+				block_size = _class_size(size_class);
+
+				Arena &arena = _arenas[arena_idx];
+				Genode::Lock::Guard lock_guard(arena.lock);
+				alloc_addr = _slab(arena, size_class).alloc();
+			}
 
 			if (!alloc_addr) return nullptr;
 
@@ -170,26 +514,34 @@ class Malloc
 
 			unsigned const offset = (addr_t)aligned_addr - (addr_t)alloc_addr;
 
-			*(aligned_addr - 1) = Metadata(real_size, offset);
+			*(aligned_addr - 1) = Metadata(block_size, arena_idx, offset);
 
 			return aligned_addr;
 		}
 
 		void *realloc(void *ptr, size_t size)
 		{
-			size_t const real_size     = size + _room();
-			size_t const old_real_size = ((Metadata *)ptr - 1)->size();
-
-			/* do not reallocate if new size is less than the current size */
-			if (real_size <= old_real_size)
+			/* grow in place within the size class or the mapped capacity */
+			if (size <= _usable(ptr))
 				return ptr;
 
+			/* grow large block by remapping */
+			if (((Metadata *)ptr - 1)->arena() == KIND_LARGE) {
+				addr_t const block = _large->grow(_large_block(ptr),
+				                                  size + _large_room());
+				if (block) {
+					ptr = _init_large(block);
+					if (size <= _usable(ptr))
+						return ptr;
+				}
+			}
+
 			/* allocate new block */
 			void *new_addr = alloc(size);
 
 			if (new_addr) {
 				/* copy content from old block into new block */
-				memcpy(new_addr, ptr, old_real_size - _room());
+				memcpy(new_addr, ptr, _usable(ptr));
 
 				/* free old block */
 				free(ptr);
@@ -200,20 +552,26 @@ class Malloc
 
 		void free(void *ptr)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
-			size_t   const  real_size  = md->size();
-			unsigned const  msb        = _slab_log2(real_size);
+			size_t   const real_size  = md->size();
+			unsigned const arena_idx  = md->arena();
 
 			void *alloc_addr = (void *)((addr_t)ptr - md->offset());
 
-			if (msb > SLAB_STOP) {
+			if (arena_idx == KIND_LARGE) {
+				_large->free(_large_block(ptr));
+				return;
+			}
+
+			if (arena_idx == KIND_BACKING) {
 				_backing_store.free(alloc_addr, real_size);
-			} else {
-				_allocator[msb - SLAB_START]->free(alloc_addr);
+				return;
 			}
+
+			Arena &arena = _arenas[arena_idx];
+			Genode::Lock::Guard lock_guard(arena.lock);
+			arena.slabs[_size_class(real_size)]->free(alloc_addr);
 		}
 };
 
@@ -255,7 +613,7 @@ extern "C" void *realloc(void *ptr, size_t size)
 }
 
 
-void Libc::init_malloc(Genode::Allocator &heap)
+void Libc::init_malloc(Genode::Env &env, Genode::Allocator &heap)
 {
-	mallocator = unmanaged_singleton<Malloc>(heap);
+	mallocator = unmanaged_singleton<Malloc>(env, heap);
 }
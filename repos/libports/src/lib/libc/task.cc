@@ -925,7 +925,7 @@ void Component::construct(Genode::Env &env)
 		*unmanaged_singleton<Genode::Heap>(env.ram(), env.rm());
 
 	/* pass Genode::Env to libc subsystems that depend on it */
-	Libc::init_malloc(heap);
+	Libc::init_malloc(env, heap);
 	Libc::init_mem_alloc(env);
 	Libc::init_dl(env);
 	Libc::sysctl_init(env);
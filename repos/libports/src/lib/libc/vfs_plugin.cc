@@ -16,6 +16,7 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/log.h>
+#include <dataspace/client.h>
 #include <vfs/dir_file_system.h>
 
 /* libc includes */
@@ -1122,6 +1123,37 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 }
 
 
+void *Libc::Vfs_plugin::_map_dataspace(::size_t length, Libc::File_descriptor *fd,
+                                       ::off_t offset)
+{
+	if (!fd->fd_path || offset < 0 || (offset & ((1 << PAGE_SHIFT) - 1)))
+		return nullptr;
+
+	Genode::Dataspace_capability const ds = _root_dir.dataspace(fd->fd_path);
+	if (!ds.valid())
+		return nullptr;
+
+	Mapping *mapping = nullptr;
+	try {
+		if ((Genode::size_t)offset + length <= Genode::Dataspace_client(ds).size()) {
+
+			mapping = new (_alloc) Mapping(ds, fd->fd_path);
+			mapping->addr = _rm.attach(ds, length, offset);
+
+			Genode::Lock::Guard guard(_mappings_lock);
+			_mappings.insert(mapping);
+			return mapping->addr;
+		}
+	} catch (...) { }
+
+	if (mapping)
+		destroy(_alloc, mapping);
+
+	_root_dir.release(fd->fd_path, ds);
+	return nullptr;
+}
+
+
 void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
                              Libc::File_descriptor *fd, ::off_t offset)
 {
@@ -1138,9 +1170,11 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 	}
 
 	/*
-	 * XXX attempt to obtain memory mapping via
-	 *     'Vfs::Directory_service::dataspace'.
+	 * Map the file content without copying if the file system exports the
+	 * file as dataspace, e.g., a file of a TAR archive.
 	 */
+	if (void *addr = _map_dataspace(length, fd, offset))
+		return addr;
 
 	void *addr = Libc::mem_alloc()->alloc(length, PAGE_SHIFT);
 	if (addr == (void *)-1) {
@@ -1161,7 +1195,26 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 
 int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 {
-	Libc::mem_alloc()->free(addr);
+	Mapping *mapping = nullptr;
+	{
+		Genode::Lock::Guard guard(_mappings_lock);
+
+		for (mapping = _mappings.first(); mapping; mapping = mapping->next())
+			if (mapping->addr == addr)
+				break;
+
+		if (mapping)
+			_mappings.remove(mapping);
+	}
+
+	if (!mapping) {
+		Libc::mem_alloc()->free(addr);
+		return 0;
+	}
+
+	_rm.detach(addr);
+	_root_dir.release(mapping->path.base(), mapping->ds);
+	destroy(_alloc, mapping);
 	return 0;
 }
 
@@ -43,6 +43,33 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs::File_system &_root_dir;
 
+		Genode::Region_map &_rm;
+
+		/**
+		 * File content mapped via a dataspace obtained from the VFS
+		 */
+		struct Mapping : Genode::List<Mapping>::Element
+		{
+			Genode::Dataspace_capability const ds;
+			Vfs::Absolute_path           const path;
+
+			void *addr = nullptr;
+
+			Mapping(Genode::Dataspace_capability ds, char const *path)
+			: ds(ds), path(path) { }
+		};
+
+		Genode::Lock          _mappings_lock { };
+		Genode::List<Mapping> _mappings      { };
+
+		/**
+		 * Attach the dataspace of the file if provided by the VFS
+		 *
+		 * \return  local address, or nullptr if the file content
+		 *          cannot be mapped directly
+		 */
+		void *_map_dataspace(::size_t, Libc::File_descriptor *, ::off_t);
+
 		void _open_stdio(Genode::Xml_node const &node, char const *attr,
 		                 int libc_fd, unsigned flags)
 		{
@@ -154,7 +181,7 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs_plugin(Libc::Env &env, Genode::Allocator &alloc)
 		:
-			_alloc(alloc), _root_dir(env.vfs())
+			_alloc(alloc), _root_dir(env.vfs()), _rm(env.rm())
 		{
 			using Genode::Xml_node;
 
@@ -15,7 +15,9 @@
 #include <base/log.h>
 #include <base/thread.h>
 #include <os/timed_semaphore.h>
+#include <util/fifo.h>
 #include <util/list.h>
+#include <cpu/atomic.h>
 
 #include <errno.h>
 #include <pthread.h>
@@ -273,155 +275,223 @@ extern "C" {
 	};
 
 
-	struct pthread_mutex
+	/*
+	 * Thread blocked at a mutex or a condition variable
+	 *
+	 * The waiter is located on the stack of the blocked thread.
+	 */
+	struct Waiter : Fifo<Waiter>::Element
 	{
-		pthread_mutex_attr mutexattr;
+		Lock lock { Lock::LOCKED };
 
-		Lock mutex_lock;
+		/* used instead of 'lock' by a timed wait for a condition variable */
+		Timed_semaphore *timed_sem = nullptr;
 
-		pthread_t owner;
-		int       lock_count;
-		Lock      owner_and_counter_lock;
+		/* mutex released by a waiter of a condition variable */
+		pthread_mutex *mutex = nullptr;
 
-		pthread_mutex(const pthread_mutexattr_t *__restrict attr)
-		: owner(0),
-		  lock_count(0)
+		/* set if the mutex was handed over to the waiter */
+		bool owns_mutex = false;
+
+		/* set if the waiter was dequeued from the condition variable */
+		bool signalled = false;
+
+		void block() { lock.lock(); }
+
+		void wake_up()
 		{
-			if (attr && *attr)
-				mutexattr = **attr;
+			if (timed_sem)
+				timed_sem->up();
+			else
+				lock.unlock();
 		}
+	};
 
-		int lock()
-		{
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+	struct pthread_mutex
+	{
+		/*
+		 * While threads are queued, the state is 'CONTENDED' and is modified
+		 * only while holding '_meta_lock'.
+		 */
+		enum { UNLOCKED = 0, LOCKED = 1, CONTENDED = 2 };
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					lock_count++;
-					mutex_lock.lock();
-					return 0;
-				}
+		int volatile _state = UNLOCKED;
 
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
-					mutex_lock.lock();
-					return 0;
+		Lock         _meta_lock { };
+		Fifo<Waiter> _waiters   { };
+
+		bool _try_acquire() { return cmpxchg(&_state, UNLOCKED, LOCKED); }
+
+		void _acquire()
+		{
+			/* uncontended case */
+			if (_try_acquire())
+				return;
+
+			_meta_lock.lock();
+
+			for (;;) {
+				if (_state == UNLOCKED && _try_acquire()) {
+					_meta_lock.unlock();
+					return;
 				}
+				if (_state == CONTENDED || cmpxchg(&_state, LOCKED, CONTENDED))
+					break;
 			}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
+			/* the mutex is handed over to us by the releasing thread */
+			Waiter waiter;
+			_waiters.enqueue(&waiter);
+			_meta_lock.unlock();
+			waiter.block();
+		}
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+		void _release()
+		{
+			/* no waiters */
+			if (cmpxchg(&_state, LOCKED, UNLOCKED))
+				return;
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
-					return 0;
-				}
+			Waiter *next = nullptr;
+			{
+				Lock::Guard guard(_meta_lock);
 
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					mutex_lock.lock();
-					return 0;
-				} else
-					return EDEADLK;
+				next   = _waiters.dequeue();
+				_state = !next             ? UNLOCKED
+				       : _waiters.empty() ? LOCKED : CONTENDED;
 			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.lock();
-			return 0;
+			if (next) {
+				next->owns_mutex = true;
+				next->wake_up();
+			}
 		}
 
-		int trylock()
+		pthread_mutex_attr mutexattr;
+
+		/*
+		 * The owner is written only by the owner itself. So a thread can
+		 * check whether it owns the mutex without synchronization.
+		 */
+		Thread  *owner      = nullptr;
+		unsigned lock_count = 0;
+
+		pthread_mutex(const pthread_mutexattr_t *__restrict attr)
 		{
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+			if (attr && *attr)
+				mutexattr = **attr;
+		}
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+		bool owned_by_myself() const { return owner == Thread::myself(); }
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					lock_count++;
-					mutex_lock.lock();
-					return 0;
-				}
+		/**
+		 * Acquire mutex for a thread that returns from a condition variable
+		 *
+		 * \param waiter      waiter of the condition variable
+		 * \param lock_count  lock count to restore
+		 */
+		void reacquire(Waiter const &waiter, unsigned lock_count)
+		{
+			if (!waiter.owns_mutex)
+				_acquire();
 
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
-					return EBUSY;
-				}
-			}
+			this->owner      = Thread::myself();
+			this->lock_count = lock_count;
+		}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
+		/**
+		 * Release mutex regardless of the lock count
+		 *
+		 * \return  lock count to restore via 'reacquire'
+		 */
+		unsigned release()
+		{
+			unsigned const count = lock_count;
+
+			owner      = nullptr;
+			lock_count = 0;
+			_release();
+
+			return count;
+		}
+
+		/**
+		 * Queue signalled waiter of a condition variable (wait morphing)
+		 *
+		 * The mutex must be held by the caller. The waiter is woken up when
+		 * the mutex is handed over to it.
+		 */
+		void enqueue(Waiter &waiter)
+		{
+			Lock::Guard guard(_meta_lock);
+
+			_state = CONTENDED;
+			_waiters.enqueue(&waiter);
+		}
+
+		int lock()
+		{
+			Thread * const myself = Thread::myself();
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+			if (owner == myself) {
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
+				if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+					lock_count++;
 					return 0;
 				}
 
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					return EBUSY;
-				} else
+				if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK)
 					return EDEADLK;
 			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			Lock::Guard lock_guard(owner_and_counter_lock);
-
-			if (lock_count == 0) {
-				owner = pthread_self();
-				mutex_lock.lock();
-				return 0;
-			}
+			_acquire();
 
-			return EBUSY;
+			owner      = myself;
+			lock_count = 1;
+			return 0;
 		}
 
-		int unlock()
+		int trylock()
 		{
+			Thread * const myself = Thread::myself();
 
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
-
-				Lock::Guard lock_guard(owner_and_counter_lock);
+			if (owner == myself) {
 
-				if (pthread_self() != owner)
-					return EPERM;
-
-				lock_count--;
-
-				if (lock_count == 0) {
-					owner = 0;
-					mutex_lock.unlock();
+				if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+					lock_count++;
+					return 0;
 				}
 
-				return 0;
-			}
+				if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK)
+					return EDEADLK;
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
+				return EBUSY;
+			}
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+			if (!_try_acquire())
+				return EBUSY;
 
-				if (pthread_self() != owner)
-					return EPERM;
+			owner      = myself;
+			lock_count = 1;
+			return 0;
+		}
 
-				owner = 0;
-				mutex_lock.unlock();
+		int unlock()
+		{
+			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
+			if (mutexattr.type != PTHREAD_MUTEX_RECURSIVE &&
+			    mutexattr.type != PTHREAD_MUTEX_ERRORCHECK) {
+				release();
 				return 0;
 			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.unlock();
+			if (!owned_by_myself())
+				return EPERM;
+
+			if (--lock_count == 0)
+				release();
+
 			return 0;
 		}
 	};
@@ -485,17 +555,33 @@ extern "C" {
 	}
 
 
-	int pthread_mutex_lock(pthread_mutex_t *mutex)
+	/*
+	 * Initialize mutex statically initialized via PTHREAD_MUTEX_INITIALIZER
+	 *
+	 * Threads may use such a mutex concurrently for the first time. So the
+	 * mutex object is allocated only once.
+	 */
+	static pthread_mutex &initialized_mutex(pthread_mutex_t *mutex)
 	{
-		if (!mutex)
-			return EINVAL;
+		if (*mutex != PTHREAD_MUTEX_INITIALIZER)
+			return **mutex;
+
+		static Lock lock;
+		Lock::Guard guard(lock);
 
 		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
 			pthread_mutex_init(mutex, 0);
 
-		(*mutex)->lock();
+		return **mutex;
+	}
+
 
-		return 0;
+	int pthread_mutex_lock(pthread_mutex_t *mutex)
+	{
+		if (!mutex)
+			return EINVAL;
+
+		return initialized_mutex(mutex).lock();
 	}
 
 
@@ -504,10 +590,7 @@ extern "C" {
 		if (!mutex)
 			return EINVAL;
 
-		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
-			pthread_mutex_init(mutex, 0);
-
-		return (*mutex)->trylock();
+		return initialized_mutex(mutex).trylock();
 	}
 
 
@@ -516,12 +599,7 @@ extern "C" {
 		if (!mutex)
 			return EINVAL;
 
-		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
-			pthread_mutex_init(mutex, 0);
-
-		(*mutex)->unlock();
-
-		return 0;
+		return initialized_mutex(mutex).unlock();
 	}
 
 
@@ -529,22 +607,31 @@ extern "C" {
 
 
 	/*
-	 * Implementation based on
-	 * http://web.archive.org/web/20010914175514/http://www-classic.be.com/aboutbe/benewsletter/volume_III/Issue40.html#Workshop
+	 * Waiters are queued in the order of their arrival. If the signalling
+	 * thread holds the mutex, a signalled waiter is moved to the waiter queue
+	 * of the mutex instead of being woken up (wait morphing). So it does not
+	 * compete for the mutex but gets it handed over when the signalling thread
+	 * releases the mutex.
 	 */
 
 	struct pthread_cond
 	{
-		int num_waiters;
-		int num_signallers;
-		Lock counter_lock;
-		Timed_semaphore signal_sem;
-		Semaphore handshake_sem;
-
-		pthread_cond() : num_waiters(0), num_signallers(0) { }
+		Lock         meta_lock { };
+		Fifo<Waiter> waiters   { };
 	};
 
 
+	static void wake_up_signalled(Waiter &waiter)
+	{
+		pthread_mutex &mutex = *waiter.mutex;
+
+		if (mutex.owned_by_myself())
+			mutex.enqueue(waiter);
+		else
+			waiter.wake_up();
+	}
+
+
 	int pthread_condattr_init(pthread_condattr_t *attr)
 	{
 		if (!attr)
@@ -650,19 +737,34 @@ extern "C" {
 	{
 		int result = 0;
 
-		if (!cond || !*cond)
+		if (!cond || !*cond || !mutex || !*mutex)
 			return EINVAL;
 
-		pthread_cond *c = *cond;
+		pthread_cond  &c = **cond;
+		pthread_mutex &m = **mutex;
+
+		if (!m.owned_by_myself())
+			return EPERM;
+
+		Constructible<Timed_semaphore> timed_sem;
 
-		c->counter_lock.lock();
-		c->num_waiters++;
-		c->counter_lock.unlock();
+		Waiter waiter;
+		waiter.mutex = &m;
 
-		pthread_mutex_unlock(mutex);
+		if (abstime) {
+			timed_sem.construct();
+			waiter.timed_sem = &*timed_sem;
+		}
+
+		{
+			Lock::Guard guard(c.meta_lock);
+			c.waiters.enqueue(&waiter);
+		}
+
+		unsigned const lock_count = m.release();
 
 		if (!abstime)
-			c->signal_sem.down();
+			waiter.block();
 		else {
 			struct timespec currtime;
 			clock_gettime(CLOCK_REALTIME, &currtime);
@@ -670,26 +772,34 @@ extern "C" {
 			Alarm::Time timeout = timeout_ms(currtime, *abstime);
 
 			try {
-				c->signal_sem.down(timeout);
+				timed_sem->down(timeout);
 			} catch (Timeout_exception) {
 				result = ETIMEDOUT;
 			} catch (Genode::Nonblocking_exception) {
 				errno  = ETIMEDOUT;
 				result = ETIMEDOUT;
 			}
-		}
 
-		c->counter_lock.lock();
-		if (c->num_signallers > 0) {
-			if (result == ETIMEDOUT) /* timeout occured */
-				c->signal_sem.down();
-			c->handshake_sem.up();
-			--c->num_signallers;
+			if (result == ETIMEDOUT) {
+
+				bool signalled = false;
+				{
+					Lock::Guard guard(c.meta_lock);
+
+					signalled = waiter.signalled;
+					if (!signalled)
+						c.waiters.remove(&waiter);
+				}
+
+				/* a signal raced with the timeout, await its wake-up */
+				if (signalled) {
+					timed_sem->down();
+					result = 0;
+				}
+			}
 		}
-		c->num_waiters--;
-		c->counter_lock.unlock();
 
-		pthread_mutex_lock(mutex);
+		m.reacquire(waiter, lock_count);
 
 		return result;
 	}
@@ -707,18 +817,21 @@ extern "C" {
 		if (!cond || !*cond)
 			return EINVAL;
 
-		pthread_cond *c = *cond;
+		pthread_cond &c = **cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-		  ++c->num_signallers;
-		  c->signal_sem.up();
-		  c->counter_lock.unlock();
-		  c->handshake_sem.down();
-		} else
-		  c->counter_lock.unlock();
+		Waiter *waiter = nullptr;
+		{
+			Lock::Guard guard(c.meta_lock);
 
-	   return 0;
+			waiter = c.waiters.dequeue();
+			if (waiter)
+				waiter->signalled = true;
+		}
+
+		if (waiter)
+			wake_up_signalled(*waiter);
+
+		return 0;
 	}
 
 
@@ -727,55 +840,88 @@ extern "C" {
 		if (!cond || !*cond)
 			return EINVAL;
 
-		pthread_cond *c = *cond;
-
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-			int still_waiting = c->num_waiters - c->num_signallers;
-			c->num_signallers = c->num_waiters;
-			for (int i = 0; i < still_waiting; i++)
-				c->signal_sem.up();
-			c->counter_lock.unlock();
-			for (int i = 0; i < still_waiting; i++)
-				c->handshake_sem.down();
-		} else
-			c->counter_lock.unlock();
+		pthread_cond &c = **cond;
+
+		Fifo<Waiter> signalled;
+		{
+			Lock::Guard guard(c.meta_lock);
+
+			while (Waiter *waiter = c.waiters.dequeue()) {
+				waiter->signalled = true;
+				signalled.enqueue(waiter);
+			}
+		}
+
+		/* a woken waiter may vanish, so dequeue it first */
+		while (Waiter *waiter = signalled.dequeue())
+			wake_up_signalled(*waiter);
 
 		return 0;
 	}
 
+
 	/* TLS */
 
 
+	/*
+	 * Sequence number of each key, odd while the key is allocated
+	 *
+	 * A value stored for a key is valid only as long as the sequence number
+	 * of the key is unchanged. So deleting a key invalidates the values of all
+	 * threads without visiting them.
+	 */
+	static int volatile key_sequence[PTHREAD_KEYS_MAX];
+
+
+	static bool key_valid(pthread_key_t key)
+	{
+		return key >= 0 && key < PTHREAD_KEYS_MAX;
+	}
+
+
+	/**
+	 * Return pthread object of the calling thread
+	 *
+	 * \return  nullptr if called by an alien thread
+	 */
+	static pthread_t pthread_myself()
+	{
+		if (Thread::Tls::Base *tls = Thread::Tls::Base::tls_ptr())
+			return static_cast<pthread_t>(tls);
+
+		/* create pthread object of the main thread on first use */
+		return _pthread_main_np() ? pthread_self() : nullptr;
+	}
+
+
+	/*
+	 * Values of alien threads, which have no pthread object
+	 */
 	struct Key_element : List<Key_element>::Element
 	{
 		const void *thread_base;
+		int         sequence;
 		const void *value;
 
-		Key_element(const void *thread_base, const void *value)
-		: thread_base(thread_base),
-		  value(value) { }
+		Key_element(const void *thread_base, int sequence, const void *value)
+		: thread_base(thread_base), sequence(sequence), value(value) { }
 	};
 
 
 	static Lock key_list_lock;
 	List<Key_element> key_list[PTHREAD_KEYS_MAX];
 
+
 	int pthread_key_create(pthread_key_t *key, void (*destructor)(void*))
 	{
 		if (!key)
 			return EINVAL;
 
-		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
-
 		for (int k = 0; k < PTHREAD_KEYS_MAX; k++) {
-			/*
-			 * Find an empty key slot and insert an element for the current
-			 * thread to mark the key slot as used.
-			 */
-			if (!key_list[k].first()) {
-				Key_element *key_element = new Key_element(Thread::myself(), 0);
-				key_list[k].insert(key_element);
+
+			int const sequence = key_sequence[k];
+
+			if (!(sequence & 1) && cmpxchg(&key_sequence[k], sequence, sequence + 1)) {
 				*key = k;
 				return 0;
 			}
@@ -787,7 +933,12 @@ extern "C" {
 
 	int pthread_key_delete(pthread_key_t key)
 	{
-		if (key < 0 || key >= PTHREAD_KEYS_MAX || !key_list[key].first())
+		if (!key_valid(key))
+			return EINVAL;
+
+		int const sequence = key_sequence[key];
+
+		if (!(sequence & 1) || !cmpxchg(&key_sequence[key], sequence, sequence + 1))
 			return EINVAL;
 
 		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
@@ -803,9 +954,19 @@ extern "C" {
 
 	int pthread_setspecific(pthread_key_t key, const void *value)
 	{
-		if (key < 0 || key >= PTHREAD_KEYS_MAX)
+		if (!key_valid(key))
+			return EINVAL;
+
+		int const sequence = key_sequence[key];
+
+		if (!(sequence & 1))
 			return EINVAL;
 
+		if (pthread_t myself = pthread_myself()) {
+			myself->specific(key, sequence, value);
+			return 0;
+		}
+
 		void *myself = Thread::myself();
 
 		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
@@ -813,12 +974,13 @@ extern "C" {
 		for (Key_element *key_element = key_list[key].first(); key_element;
 		     key_element = key_element->next())
 			if (key_element->thread_base == myself) {
-				key_element->value = value;
+				key_element->sequence = sequence;
+				key_element->value    = value;
 				return 0;
 			}
 
 		/* key element does not exist yet - create a new one */
-		Key_element *key_element = new Key_element(Thread::myself(), value);
+		Key_element *key_element = new Key_element(myself, sequence, value);
 		key_list[key].insert(key_element);
 		return 0;
 	}
@@ -826,16 +988,22 @@ extern "C" {
 
 	void *pthread_getspecific(pthread_key_t key)
 	{
-		if (key < 0 || key >= PTHREAD_KEYS_MAX)
+		if (!key_valid(key))
 			return nullptr;
 
+		int const sequence = key_sequence[key];
+
+		if (pthread_t myself = pthread_myself())
+			return (void *)myself->specific(key, sequence);
+
 		void *myself = Thread::myself();
 
 		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
 
 		for (Key_element *key_element = key_list[key].first(); key_element;
 		     key_element = key_element->next())
-			if (key_element->thread_base == myself)
+			if (key_element->thread_base == myself &&
+			    key_element->sequence    == sequence)
 				return (void*)(key_element->value);
 
 		return 0;
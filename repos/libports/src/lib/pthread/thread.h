@@ -92,6 +92,18 @@ struct Genode::Thread::Tls::Base
 
 		return *myself._tls.ptr;
 	}
+
+	/**
+	 * Obtain thread-local-storage object for the calling thread
+	 *
+	 * \return  nullptr if no object is registered
+	 */
+	static Tls::Base *tls_ptr()
+	{
+		Thread *myself = Thread::myself();
+
+		return myself ? myself->_tls.ptr : nullptr;
+	}
 };
 
 
@@ -143,6 +155,18 @@ struct pthread : Genode::Noncopyable, Genode::Thread::Tls::Base
 
 		pthread_attr_t _attr;
 
+		/*
+		 * Values of the thread-specific data keys, each tagged with the
+		 * sequence number of the key at the time the value was stored
+		 */
+		struct Specific
+		{
+			int         sequence;
+			void const *value;
+		};
+
+		Specific _specific[PTHREAD_KEYS_MAX] { };
+
 		void _associate_thread_with_pthread()
 		{
 			if (_attr)
@@ -192,6 +216,23 @@ struct pthread : Genode::Noncopyable, Genode::Thread::Tls::Base
 		void *stack_base() const { return _thread.stack_base(); }
 
 		pthread_attr_t attr() { return _attr; }
+
+		/**
+		 * Return value of thread-specific data key
+		 *
+		 * \param sequence  current sequence number of the key
+		 */
+		void const *specific(pthread_key_t key, int sequence) const
+		{
+			Specific const &s = _specific[key];
+
+			return s.sequence == sequence ? s.value : nullptr;
+		}
+
+		void specific(pthread_key_t key, int sequence, void const *value)
+		{
+			_specific[key] = Specific { sequence, value };
+		}
 };
 
 #endif /* _INCLUDE__SRC_LIB_PTHREAD_THREAD_H_ */
@@ -11,10 +11,12 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <errno.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 
 enum { NUM_THREADS = 2 };
@@ -62,6 +64,185 @@ static inline void compare_semaphore_values(int reported_value, int expected_val
     }
 }
 
+
+/*
+ * Mutex and condition-variable test
+ *
+ * The worker threads increment a counter protected by a mutex. Each worker
+ * waits for its turn via a condition variable, so the signalled threads
+ * repeatedly hand the mutex over to each other.
+ */
+
+enum { NUM_WORKERS = 4, NUM_ROUNDS = 10000 };
+
+static pthread_mutex_t turn_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  turn_cond;
+static unsigned        turn;
+
+
+static void *worker_func(void *arg)
+{
+	unsigned const id = (unsigned)(unsigned long)arg;
+
+	for (unsigned i = 0; i < NUM_ROUNDS; i++) {
+
+		pthread_mutex_lock(&turn_mutex);
+
+		while (turn % NUM_WORKERS != id)
+			pthread_cond_wait(&turn_cond, &turn_mutex);
+
+		turn++;
+
+		pthread_cond_broadcast(&turn_cond);
+		pthread_mutex_unlock(&turn_mutex);
+	}
+	return 0;
+}
+
+
+static int test_mutex()
+{
+	printf("main thread: testing mutex types\n");
+
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+
+	pthread_mutex_t mutex;
+
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mutex, &attr);
+	if (pthread_mutex_lock(&mutex)    != 0 ||
+	    pthread_mutex_lock(&mutex)    != 0 ||
+	    pthread_mutex_trylock(&mutex) != 0 ||
+	    pthread_mutex_unlock(&mutex)  != 0 ||
+	    pthread_mutex_unlock(&mutex)  != 0 ||
+	    pthread_mutex_unlock(&mutex)  != 0 ||
+	    pthread_mutex_unlock(&mutex)  != EPERM) {
+		printf("error: recursive mutex misbehaves\n");
+		return -1;
+	}
+	pthread_mutex_destroy(&mutex);
+
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+	pthread_mutex_init(&mutex, &attr);
+	if (pthread_mutex_lock(&mutex)   != 0       ||
+	    pthread_mutex_lock(&mutex)   != EDEADLK ||
+	    pthread_mutex_unlock(&mutex) != 0       ||
+	    pthread_mutex_unlock(&mutex) != EPERM) {
+		printf("error: error-checking mutex misbehaves\n");
+		return -1;
+	}
+	pthread_mutex_destroy(&mutex);
+
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL);
+	pthread_mutex_init(&mutex, &attr);
+	if (pthread_mutex_trylock(&mutex) != 0     ||
+	    pthread_mutex_trylock(&mutex) != EBUSY ||
+	    pthread_mutex_unlock(&mutex)  != 0     ||
+	    pthread_mutex_trylock(&mutex) != 0     ||
+	    pthread_mutex_unlock(&mutex)  != 0) {
+		printf("error: normal mutex misbehaves\n");
+		return -1;
+	}
+	pthread_mutex_destroy(&mutex);
+
+	pthread_mutexattr_destroy(&attr);
+	return 0;
+}
+
+
+static int test_cond()
+{
+	printf("main thread: testing condition variables\n");
+
+	pthread_cond_init(&turn_cond, 0);
+
+	pthread_t workers[NUM_WORKERS];
+	for (unsigned i = 0; i < NUM_WORKERS; i++)
+		if (pthread_create(&workers[i], 0, worker_func, (void *)(unsigned long)i) != 0) {
+			printf("error: pthread_create() failed\n");
+			return -1;
+		}
+
+	pthread_mutex_lock(&turn_mutex);
+	while (turn < NUM_WORKERS*NUM_ROUNDS)
+		pthread_cond_wait(&turn_cond, &turn_mutex);
+	pthread_mutex_unlock(&turn_mutex);
+
+	printf("main thread: %u turns completed\n", turn);
+
+	/* nobody signals, so the wait must time out with the mutex held */
+	struct timespec abstime;
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_nsec += 100*1000*1000;
+
+	pthread_mutex_lock(&turn_mutex);
+	int const result = pthread_cond_timedwait(&turn_cond, &turn_mutex, &abstime);
+	if (result != ETIMEDOUT || pthread_mutex_trylock(&turn_mutex) != EBUSY) {
+		printf("error: pthread_cond_timedwait() did not time out\n");
+		return -1;
+	}
+	pthread_mutex_unlock(&turn_mutex);
+
+	return 0;
+}
+
+
+static pthread_key_t tls_key;
+static sem_t         tls_sem;
+static bool          tls_separated;
+
+
+static void *tls_func(void *arg)
+{
+	if (pthread_getspecific(tls_key) == 0) {
+		pthread_setspecific(tls_key, arg);
+		tls_separated = (pthread_getspecific(tls_key) == arg);
+	}
+
+	sem_post(&tls_sem);
+	return 0;
+}
+
+
+static int test_tls()
+{
+	printf("main thread: testing thread-specific data\n");
+
+	if (pthread_key_create(&tls_key, 0) != 0) {
+		printf("error: pthread_key_create() failed\n");
+		return -1;
+	}
+
+	int main_value = 0, thread_value = 0;
+	pthread_setspecific(tls_key, &main_value);
+
+	sem_init(&tls_sem, 0, 0);
+
+	pthread_t t;
+	pthread_create(&t, 0, tls_func, &thread_value);
+	sem_wait(&tls_sem);
+	sem_destroy(&tls_sem);
+
+	if (!tls_separated || pthread_getspecific(tls_key) != &main_value) {
+		printf("error: thread-specific values are not separated\n");
+		return -1;
+	}
+
+	/* values of a deleted key must not reappear for a new key */
+	pthread_key_delete(tls_key);
+	pthread_key_create(&tls_key, 0);
+
+	if (pthread_getspecific(tls_key) != 0) {
+		printf("error: stale value of deleted key\n");
+		return -1;
+	}
+	pthread_key_delete(tls_key);
+
+	return 0;
+}
+
+
 int main(int argc, char **argv)
 {
 	printf("--- pthread test ---\n");
@@ -142,6 +323,9 @@ int main(int argc, char **argv)
 		}
 	}
 
+	if (test_mutex() || test_cond() || test_tls())
+		return -1;
+
 	printf("--- returning from main ---\n");
 	return 0;
 }
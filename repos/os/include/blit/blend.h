@@ -0,0 +1,62 @@
+/*
+ * \brief  Interface of pixel-blending functions of the blit library
+ * \date   2026-10-18
+ *
+ * The functions process one row of pixels each. They produce the same pixel
+ * values as the corresponding per-pixel operations of the pixel types but
+ * use the vector unit of the CPU. The best implementation available on the
+ * CPU is selected at the first use.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BLIT__BLEND_H_
+#define _INCLUDE__BLIT__BLEND_H_
+
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+namespace Blit {
+
+	using Genode::Pixel_rgb565;
+	using Genode::Pixel_rgb888;
+
+	/**
+	 * Mix source pixels into destination pixels according to alpha values
+	 *
+	 * Corresponds to 'dst[i] = PT::mix(dst[i], src[i], alpha[i])' for all
+	 * pixels with a non-zero alpha value.
+	 */
+	void mix(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	         unsigned char const *alpha, unsigned count);
+
+	void mix(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	         unsigned char const *alpha, unsigned count);
+
+	/**
+	 * Store average of source pixels and 'color' at the destination
+	 *
+	 * Corresponds to 'dst[i] = PT::avr(color, src[i])'.
+	 */
+	void avr(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	         Pixel_rgb565 color, unsigned count);
+
+	/**
+	 * Copy source pixels that differ from the mask color black
+	 */
+	void mask(Pixel_rgb565 *dst, Pixel_rgb565 const *src, unsigned count);
+
+	void mask(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned count);
+
+	/**
+	 * Return name of the selected implementation, e.g., "avx2"
+	 */
+	char const *blend_kernels();
+}
+
+#endif /* _INCLUDE__BLIT__BLEND_H_ */
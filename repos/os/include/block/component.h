@@ -78,6 +78,30 @@ class Block::Session_component : public Block::Session_component_base,
 		unsigned                          _p_in_fly;
 		bool                              _writeable;
 
+		/*
+		 * Requests handed over to the driver but not yet acknowledged
+		 */
+		unsigned                          _p_in_driver = 0;
+		unsigned                    const _queue_depth;
+
+		/*
+		 * Packet processing is in progress, which is the case when a
+		 * synchronous driver acknowledges a request immediately
+		 */
+		bool                              _processing = false;
+
+		bool _driver_queue_full() const {
+			return _queue_depth && _p_in_driver >= _queue_depth; }
+
+		/*
+		 * Packets taken from the submit queue at once but not yet
+		 * handed over to the driver
+		 */
+		enum { BATCH = 16 };
+		Packet_descriptor                 _batch[BATCH] { };
+		unsigned                          _batch_pos = 0;
+		unsigned                          _batch_num = 0;
+
 		/**
 		 * Acknowledge a packet already handled
 		 */
@@ -111,6 +135,8 @@ class Block::Session_component : public Block::Session_component_base,
 				return;
 			}
 
+			_p_in_driver++;
+
 			try {
 				switch (_p_to_handle.operation()) {
 
@@ -129,6 +155,7 @@ class Block::Session_component : public Block::Session_component_base,
 
 				case Block::Packet_descriptor::WRITE:
 					if (!_writeable) {
+						_p_in_driver--;
 						_ack_packet(_p_to_handle);
 						break;
 					}
@@ -148,8 +175,10 @@ class Block::Session_component : public Block::Session_component_base,
 					throw Driver::Io_error();
 				}
 			} catch (Driver::Request_congestion) {
+				_p_in_driver--;
 				_req_queue_full = true;
 			} catch (Driver::Io_error) {
+				_p_in_driver--;
 				_ack_packet(_p_to_handle);
 			}
 		}
@@ -159,16 +188,36 @@ class Block::Session_component : public Block::Session_component_base,
 		 */
 		void _signal()
 		{
+			_processing = true;
+
 			/*
 			 * as long as more packets are available, and we're able to ack
 			 * them, and the driver's request queue isn't full,
 			 * direct the packet request to the driver backend
 			 */
 			for (_ack_queue_full = (_p_in_fly >= tx_sink()->ack_slots_free());
-			     !_req_queue_full && !_ack_queue_full
-			     && tx_sink()->packet_avail();
-				 _ack_queue_full = (++_p_in_fly >= tx_sink()->ack_slots_free()))
-				_handle_packet(tx_sink()->get_packet());
+			     !_req_queue_full && !_ack_queue_full && !_driver_queue_full();
+				 _ack_queue_full = (++_p_in_fly >= tx_sink()->ack_slots_free())) {
+
+				/*
+				 * Fetch a batch of packets from the submit queue, but not
+				 * more than we are able to acknowledge
+				 */
+				if (_batch_pos == _batch_num) {
+					unsigned const max =
+						min((unsigned)BATCH,
+						    tx_sink()->ack_slots_free() - _p_in_fly);
+
+					_batch_pos = 0;
+					_batch_num = tx_sink()->get_packets(_batch, max);
+					if (!_batch_num)
+						break;
+				}
+
+				_handle_packet(_batch[_batch_pos++]);
+			}
+
+			_processing = false;
 		}
 
 	public:
@@ -192,7 +241,8 @@ class Block::Session_component : public Block::Session_component_base,
 		  _sink_submit(ep, *this, &Session_component::_signal),
 		  _req_queue_full(false),
 		  _p_in_fly(0),
-		  _writeable(writeable)
+		  _writeable(writeable),
+		  _queue_depth(_driver.queue_depth())
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
@@ -212,10 +262,17 @@ class Block::Session_component : public Block::Session_component_base,
 		 */
 		void ack_packet(Packet_descriptor &packet, bool success)
 		{
+			bool const driver_queue_full = _driver_queue_full();
+
 			packet.succeeded(success);
+			_p_in_driver--;
 			_ack_packet(packet);
 
-			if (!_req_queue_full && !_ack_queue_full)
+			/* packet processing continues after the driver returned */
+			if (_processing)
+				return;
+
+			if (!_req_queue_full && !_ack_queue_full && !driver_queue_full)
 				return;
 
 			/*
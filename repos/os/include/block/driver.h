@@ -19,6 +19,7 @@
 #include <base/exception.h>
 #include <base/stdint.h>
 #include <base/signal.h>
+#include <util/misc_math.h>
 
 #include <ram_session/ram_session.h>
 #include <block_session/rpc_object.h>
@@ -27,6 +28,7 @@ namespace Block {
 	class Driver_session_base;
 	class Driver_session;
 	class Driver;
+	template <unsigned> class Request_table;
 	struct Driver_factory;
 };
 
@@ -208,6 +210,18 @@ class Block::Driver : Genode::Interface
 		 */
 		virtual bool dma_enabled() { return false; }
 
+		/**
+		 * Return number of requests the driver is able to process at once
+		 *
+		 * The session component hands no more than this number of
+		 * outstanding requests to the driver. The requests may be
+		 * acknowledged in any order. The default value 0 sets no limit,
+		 * leaving it to the driver to throw 'Request_congestion'.
+		 *
+		 * Note: should be overridden by devices with a command queue
+		 */
+		virtual unsigned queue_depth() { return 0; }
+
 		/**
 		 * Allocate buffer which is suitable for DMA.
 		 *
@@ -259,6 +273,89 @@ class Block::Driver : Genode::Interface
 };
 
 
+/**
+ * Outstanding requests of a driver, indexed by tag
+ *
+ * \param MAX  maximum number of outstanding requests
+ *
+ * A driver that processes several requests at once, e.g., by using the
+ * command slots of a controller, stores each request under a free tag.
+ * The tag is passed to the device and identifies the packet of the request
+ * when the device reports its completion, which may happen in any order.
+ */
+template <unsigned MAX>
+class Block::Request_table
+{
+	private:
+
+		Packet_descriptor _packets[MAX] { };
+		bool              _used[MAX]    { };
+		unsigned          _depth = MAX;
+		unsigned          _num   = 0;
+
+	public:
+
+		/**
+		 * Limit number of usable tags, e.g., to the command slots of a device
+		 */
+		void depth(unsigned depth) { _depth = Genode::min(depth, MAX); }
+
+		unsigned depth()       const { return _depth; }
+		unsigned num_pending() const { return _num; }
+		bool     full()        const { return _num >= _depth; }
+
+		bool pending(unsigned tag) const { return tag < MAX && _used[tag]; }
+
+		/**
+		 * Store packet of a new request
+		 *
+		 * \return  tag of the request
+		 * \throw   Driver::Request_congestion
+		 */
+		unsigned alloc(Packet_descriptor const &packet)
+		{
+			for (unsigned tag = 0; tag < _depth; tag++) {
+				if (_used[tag])
+					continue;
+
+				_packets[tag] = packet;
+				_used[tag]    = true;
+				_num++;
+				return tag;
+			}
+			throw Driver::Request_congestion();
+		}
+
+		/**
+		 * Remove completed request
+		 *
+		 * \return  packet stored for the tag
+		 */
+		Packet_descriptor release(unsigned tag)
+		{
+			if (!pending(tag))
+				return Packet_descriptor();
+
+			_used[tag] = false;
+			_num--;
+			return _packets[tag];
+		}
+
+		/**
+		 * Call 'fn(tag, packet)' for each outstanding request
+		 *
+		 * The functor may release the request of the current tag.
+		 */
+		template <typename FN>
+		void for_each_pending(FN const &fn) const
+		{
+			for (unsigned tag = 0; tag < MAX && _num; tag++)
+				if (_used[tag])
+					fn(tag, _packets[tag]);
+		}
+};
+
+
 /**
  * Interface for constructing the driver object
  */
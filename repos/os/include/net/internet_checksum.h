@@ -0,0 +1,88 @@
+/*
+ * \brief  Computation of the internet checksum (RFC 1071, RFC 1624)
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NET__INTERNET_CHECKSUM_H_
+#define _NET__INTERNET_CHECKSUM_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+namespace Net {
+
+	class Ipv4_address;
+
+	/**
+	 * Return the one's complement sum of a byte sequence
+	 *
+	 * \param data  start of the sequence, no alignment required
+	 * \param size  size of the sequence in bytes, an odd size is padded
+	 *              with a zero byte
+	 * \param sum   one's complement sum to continue with
+	 *
+	 * The sequence is interpreted as 16-bit words in network byte order.
+	 * The result is the folded 16-bit sum in host byte order. For sequences
+	 * of more than a few words, the sum is calculated in 16-byte vectors
+	 * (SSE2 on x86, NEON on ARM).
+	 */
+	Genode::uint16_t internet_sum(void const       *data,
+	                              Genode::size_t    size,
+	                              Genode::uint16_t  sum = 0);
+
+	/**
+	 * Return the internet checksum of a byte sequence in host byte order
+	 */
+	inline Genode::uint16_t internet_checksum(void const       *data,
+	                                          Genode::size_t    size,
+	                                          Genode::uint16_t  sum = 0)
+	{
+		return (Genode::uint16_t)~internet_sum(data, size, sum);
+	}
+
+	/**
+	 * Return the one's complement sum of an IPv4 pseudo header
+	 *
+	 * \param prot  IP protocol number
+	 * \param size  size of the transport packet in bytes
+	 */
+	Genode::uint16_t internet_sum_ipv4_pseudo_header(Ipv4_address const &src,
+	                                                 Ipv4_address const &dst,
+	                                                 Genode::uint8_t     prot,
+	                                                 Genode::size_t      size);
+
+	/**
+	 * Return checksum adapted to the replacement of one 16-bit word
+	 *
+	 * The update is done according to equation 3 of RFC 1624, which is also
+	 * correct if the old checksum was 0xffff. All values are in host byte
+	 * order.
+	 */
+	inline Genode::uint16_t internet_checksum_update(Genode::uint16_t checksum,
+	                                                 Genode::uint16_t old_word,
+	                                                 Genode::uint16_t new_word)
+	{
+		Genode::uint32_t sum = (Genode::uint16_t)~checksum;
+		sum += (Genode::uint16_t)~old_word;
+		sum += new_word;
+		sum  = (sum & 0xffff) + (sum >> 16);
+		sum  = (sum & 0xffff) + (sum >> 16);
+		return (Genode::uint16_t)~sum;
+	}
+
+	/**
+	 * Return checksum adapted to the replacement of an IPv4 address
+	 */
+	Genode::uint16_t internet_checksum_update(Genode::uint16_t    checksum,
+	                                          Ipv4_address const &old_ip,
+	                                          Ipv4_address const &new_ip);
+}
+
+#endif /* _NET__INTERNET_CHECKSUM_H_ */
@@ -21,6 +21,7 @@
 #include <util/endian.h>
 #include <net/ethernet.h>
 #include <net/ipv4.h>
+#include <net/internet_checksum.h>
 
 namespace Net { class Udp_packet; }
 
@@ -82,6 +83,7 @@ class Net::Udp_packet
 		void length(Genode::uint16_t v) { _length = host_to_big_endian(v); }
 		void src_port(Port p)           { _src_port = host_to_big_endian(p.value); }
 		void dst_port(Port p)           { _dst_port = host_to_big_endian(p.value); }
+		void checksum(Genode::uint16_t v) { _checksum = host_to_big_endian(v); }
 
 
 		/***************************
@@ -104,43 +106,12 @@ class Net::Udp_packet
 		{
 			/* have to reset the checksum field for calculation */
 			_checksum = 0;
+			Genode::uint16_t const sum = internet_checksum(this, length(),
+				internet_sum_ipv4_pseudo_header(src, dst,
+					(Genode::uint8_t)Ipv4_packet::Protocol::UDP, length()));
 
-			/*
-			 * sum up pseudo header
-			 */
-			Genode::uint32_t sum = 0;
-			for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i=i+2) {
-				Genode::uint16_t s = src.addr[i] << 8 | src.addr[i + 1];
-				Genode::uint16_t d = dst.addr[i] << 8 | dst.addr[i + 1];
-				sum += s + d;
-			}
-			Genode::uint8_t prot[] = { 0, (Genode::uint8_t)Ipv4_packet::Protocol::UDP };
-			sum += host_to_big_endian(*(Genode::uint16_t*)&prot) + length();
-
-			/*
-			 * sum up udp packet itself
-			 */
-			unsigned max = (length() & 1) ? (length() - 1) : length();
-			Genode::uint16_t *udp = (Genode::uint16_t*) this;
-			for (unsigned i = 0; i < max; i=i+2)
-				sum += host_to_big_endian(*udp++);
-
-			/* if udp length is odd, append a zero byte */
-			if (length() & 1) {
-				Genode::uint8_t last[] =
-					{ *((Genode::uint8_t*)this + (length()-1)), 0 };
-				sum += host_to_big_endian(*(Genode::uint16_t*)&last);
-			}
-
-			/*
-			 * keep only the last 16 bits of the 32 bit calculated sum
-			 * and add the carries
-			 */
-			while (sum >> 16)
-				sum = (sum & 0xffff) + (sum >> 16);
-
-			/* one's complement of sum */
-			_checksum = host_to_big_endian((Genode::uint16_t) ~sum);
+			/* a checksum of zero denotes that no checksum was computed */
+			_checksum = host_to_big_endian((Genode::uint16_t)(sum ? sum : 0xffff));
 		}
 
 
@@ -17,6 +17,7 @@
 #include <util/noncopyable.h>
 #include <base/stdint.h>
 #include <os/surface.h>
+#include <nitpicker_gfx/mix_row.h>
 
 
 struct Glyph_painter
@@ -103,44 +104,44 @@ struct Glyph_painter
 
 		unsigned const glyph_line_len = 4*glyph.width;
 
-		PT *dst_column   = dst + dst_x
-		                 + dst_line_len*(dst_y1 + clipped_from_top);
+		PT *dst_line = dst + dst_x
+		             + dst_line_len*(dst_y1 + clipped_from_top);
 
 		typedef Glyph::Opacity Opacity;
-		Opacity const *glyph_column = glyph.values + glyph_x
-		                            + glyph_line_len*clipped_from_top;
+		Opacity const *glyph_line = glyph.values + glyph_x
+		                          + glyph_line_len*clipped_from_top;
 
-		/* iterate over the visible columns of the glyph */
-		for (int i = start; i < end; i++) {
+		/* weights of the two sampled values (horizontal neighbors)*/
+		int const u0 = x.value*4 & 0xff;
+		int const u1 = 0x100 - u0;
 
-			/* weights of the two sampled values (horizontal neighbors)*/
-			int const u0 = x.value*4 & 0xff;
-			int const u1 = 0x100 - u0;
+		/*
+		 * The glyph is painted line by line so that the destination is
+		 * accessed sequentially. The opacity values of a line are sampled
+		 * into 'row' in chunks, which are mixed into the destination at once.
+		 */
+		enum { CHUNK = 64 };
+		unsigned char row[CHUNK];
 
-			PT            *d = dst_column;
-			Opacity const *s = glyph_column;
+		unsigned const num_columns = end > start ? end - start : 0;
 
-			/* iterate over one column */
-			for (unsigned j = 0; j < num_lines; j++) {
+		/* iterate over the visible lines of the glyph */
+		for (unsigned j = 0; j < num_lines; j++) {
 
-				/* sample values from glyph image */
-				unsigned const v0 = s->value;
-				unsigned const v1 = (s + 1)->value;
+			for (unsigned i = 0; i < num_columns; i += CHUNK) {
 
-				/* apply weights */
-				int const value = (v0*u0 + v1*u1) >> 8;
+				unsigned const n = Genode::min((unsigned)CHUNK, num_columns - i);
 
-				/* transfer pixel */
-				if (value)
-					*d = (value == 255 && alpha == 255)
-					   ? color : PT::mix(*d, color, (alpha*value) >> 8);
+				/* sample values from glyph image and apply weights */
+				Opacity const *s = glyph_line + 4*i;
+				for (unsigned k = 0; k < n; k++, s += 4)
+					row[k] = (s->value*u0 + (s + 1)->value*u1) >> 8;
 
-				s += glyph_line_len;
-				d += dst_line_len;
+				mix_row(dst_line + i, row, n, color, alpha);
 			}
 
-			dst_column   += 1;
-			glyph_column += 4;
+			glyph_line += glyph_line_len;
+			dst_line   += dst_line_len;
 		}
 	}
 };
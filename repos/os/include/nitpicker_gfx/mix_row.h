@@ -0,0 +1,158 @@
+/*
+ * \brief  Mix a row of pixels with a color according to opacity values
+ * \date   2026-10-18
+ *
+ * The generic version applies 'PT::mix' per pixel. The versions for the
+ * RGB565 and RGB888 pixel formats process four pixels at once using the
+ * vector extensions of the compiler, which are translated to SSE2 on x86 and
+ * to NEON on ARM. They produce the same pixel values as the generic version.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__NITPICKER_GFX__MIX_ROW_H_
+#define _INCLUDE__NITPICKER_GFX__MIX_ROW_H_
+
+#include <base/stdint.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+
+namespace Mix_row {
+
+	typedef Genode::uint32_t Lanes __attribute__((vector_size(16)));
+
+	enum { NUM_LANES = 4 };
+
+	/**
+	 * Return true if none of the next four opacity values is set
+	 */
+	static inline bool transparent(unsigned char const *opacity)
+	{
+		return !(opacity[0] | opacity[1] | opacity[2] | opacity[3]);
+	}
+
+	static inline Lanes lanes(unsigned char const *opacity)
+	{
+		return Lanes { opacity[0], opacity[1], opacity[2], opacity[3] };
+	}
+
+	/**
+	 * Select 'a' for lanes where 'mask' is set, or 'b' otherwise
+	 */
+	static inline Lanes select(Lanes mask, Lanes a, Lanes b)
+	{
+		return (mask & a) | (~mask & b);
+	}
+
+	/**
+	 * Return lanes of pixels that keep their value or take the plain color
+	 *
+	 * A pixel keeps its value if its opacity is zero. It takes the color
+	 * if the opacity is 255 and the color is drawn opaquely.
+	 */
+	static inline Lanes special(Lanes mixed, Lanes dst, Lanes color,
+	                            Lanes opacity, int alpha)
+	{
+		if (alpha == 255)
+			mixed = select((Lanes)(opacity == 255), color, mixed);
+
+		return select((Lanes)(opacity == 0), dst, mixed);
+	}
+}
+
+
+/**
+ * Mix 'count' pixels at 'dst' with 'color' weighted by the 'opacity' values
+ *
+ * \param alpha  global opacity of the color
+ */
+template <typename PT>
+static inline void mix_row(PT *dst, unsigned char const *opacity,
+                           unsigned count, PT const color, int const alpha)
+{
+	for (unsigned i = 0; i < count; i++) {
+
+		int const value = opacity[i];
+
+		if (value)
+			dst[i] = (value == 255 && alpha == 255)
+			       ? color : PT::mix(dst[i], color, (alpha*value) >> 8);
+	}
+}
+
+
+static inline void mix_row(Genode::Pixel_rgb565 *dst, unsigned char const *opacity,
+                           unsigned count, Genode::Pixel_rgb565 const color,
+                           int const alpha)
+{
+	using namespace Mix_row;
+
+	Lanes const c = color.pixel - Lanes { };
+
+	/* blend function of 'Pixel_rgb565' applied to four pixels */
+	auto blend = [] (Lanes p, Lanes a) {
+		return ((((a >> 3) * (p & 0xf81f)) >> 5) & 0xf81f)
+		     | ((( a       * (p & 0x07c0)) >> 8) & 0x07c0); };
+
+	for (; count >= NUM_LANES; count -= NUM_LANES, dst += NUM_LANES,
+	                                             opacity += NUM_LANES) {
+
+		if (transparent(opacity))
+			continue;
+
+		Lanes const o = lanes(opacity);
+		Lanes const a = ((unsigned)alpha*o) >> 8;
+		Lanes const d = { dst[0].pixel, dst[1].pixel, dst[2].pixel, dst[3].pixel };
+
+		Lanes const mixed = blend(d, 264 - a) + blend(c, a);
+		Lanes const res   = special(mixed, d, c, o, alpha);
+
+		for (unsigned i = 0; i < NUM_LANES; i++)
+			dst[i].pixel = (unsigned short)res[i];
+	}
+
+	mix_row<Genode::Pixel_rgb565>(dst, opacity, count, color, alpha);
+}
+
+
+static inline void mix_row(Genode::Pixel_rgb888 *dst, unsigned char const *opacity,
+                           unsigned count, Genode::Pixel_rgb888 const color,
+                           int const alpha)
+{
+	using namespace Mix_row;
+
+	Lanes const c = color.pixel - Lanes { };
+
+	/* blend function of 'Pixel_rgb888' applied to four pixels */
+	auto blend = [] (Lanes p, Lanes a) {
+		return ((a * ((p & 0xff00) >> 8)) & 0xff00)
+		     | (((a * (p & 0xff00ff)) >> 8) & 0xff00ff); };
+
+	for (; count >= NUM_LANES; count -= NUM_LANES, dst += NUM_LANES,
+	                                             opacity += NUM_LANES) {
+
+		if (transparent(opacity))
+			continue;
+
+		Lanes const o = lanes(opacity);
+		Lanes const a = ((unsigned)alpha*o) >> 8;
+
+		Lanes d;
+		__builtin_memcpy(&d, (void const *)dst, sizeof(d));
+
+		Lanes const mixed = blend(d, 255 - a) + blend(c, a);
+		Lanes const res   = special(mixed, d, c, o, alpha);
+
+		__builtin_memcpy((void *)dst, &res, sizeof(res));
+	}
+
+	mix_row<Genode::Pixel_rgb888>(dst, opacity, count, color, alpha);
+}
+
+#endif /* _INCLUDE__NITPICKER_GFX__MIX_ROW_H_ */
@@ -15,6 +15,7 @@
 #define _INCLUDE__NITPICKER_GFX__TEXTURE_PAINTER_H_
 
 #include <blit/blit.h>
+#include <blit/blend.h>
 #include <os/texture.h>
 
 
@@ -43,6 +44,55 @@ struct Texture_painter
 	typedef Genode::Surface_base::Rect  Rect;
 
 
+	/*
+	 * Row operations
+	 *
+	 * The generic versions apply the operations of the pixel type to each
+	 * pixel. For the RGB565 and RGB888 formats, the vectorized versions of
+	 * the blit library are used.
+	 */
+
+	template <typename PT>
+	static inline void _mix_row(PT *d, PT const *s, unsigned char const *a, int n)
+	{
+		for (; n--; s++, d++, a++)
+			if (*a)
+				*d = PT::mix(*d, *s, *a);
+	}
+
+	template <typename PT>
+	static inline void _avr_row(PT *d, PT const *s, PT const mix_pixel, int n)
+	{
+		for (; n--; s++, d++)
+			*d = PT::avr(mix_pixel, *s);
+	}
+
+	template <typename PT>
+	static inline void _mask_row(PT *d, PT const *s, int n)
+	{
+		for (; n--; s++, d++)
+			if (s->pixel) *d = *s;
+	}
+
+	static inline void _mix_row(Genode::Pixel_rgb565 *d, Genode::Pixel_rgb565 const *s,
+	                            unsigned char const *a, int n) {
+		Blit::mix(d, s, a, n); }
+
+	static inline void _mix_row(Genode::Pixel_rgb888 *d, Genode::Pixel_rgb888 const *s,
+	                            unsigned char const *a, int n) {
+		Blit::mix(d, s, a, n); }
+
+	static inline void _avr_row(Genode::Pixel_rgb565 *d, Genode::Pixel_rgb565 const *s,
+	                            Genode::Pixel_rgb565 const mix_pixel, int n) {
+		Blit::avr(d, s, mix_pixel, n); }
+
+	static inline void _mask_row(Genode::Pixel_rgb565 *d, Genode::Pixel_rgb565 const *s, int n) {
+		Blit::mask(d, s, n); }
+
+	static inline void _mask_row(Genode::Pixel_rgb888 *d, Genode::Pixel_rgb888 const *s, int n) {
+		Blit::mask(d, s, n); }
+
+
 	template <typename PT>
 	static inline void paint(Genode::Surface<PT>       &surface,
 	                         Genode::Texture<PT> const &texture,
@@ -74,10 +124,8 @@ struct Texture_painter
 
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
-		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		int const w = clipped.w();
+		int j;
 
 		switch (mode) {
 
@@ -98,23 +146,19 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++)
-					if (*a)
-						*d = PT::mix(*d, *s, *a);
+				_mix_row(dst, src, alpha, w);
 			break;
 
 		case MIXED:
 	
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					*d = PT::avr(mix_pixel, *s);
+				_avr_row(dst, src, mix_pixel, w);
 			break;
 
 		case MASKED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					if (s->pixel) *d = *s;
+				_mask_row(dst, src, w);
 			break;
 		}
 
@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__ALARM_H_
 
 #include <base/lock.h>
+#include <util/pairing_heap.h>
 
 namespace Genode {
 	class Alarm_scheduler;
@@ -22,7 +23,7 @@ namespace Genode {
 }
 
 
-class Genode::Alarm
+class Genode::Alarm : private Pairing_heap_element<Alarm>
 {
 	public:
 
@@ -31,6 +32,7 @@ class Genode::Alarm
 	private:
 
 		friend class Alarm_scheduler;
+		friend class Pairing_heap<Alarm>;
 
 		struct Raw
 		{
@@ -44,7 +46,6 @@ class Genode::Alarm
 		Lock             _dispatch_lock { };          /* taken during handle method   */
 		Raw              _raw           { };
 		int              _active        { 0 };        /* set to one when active       */
-		Alarm           *_next          { nullptr };  /* next alarm in alarm list     */
 		Alarm_scheduler *_scheduler     { nullptr };  /* currently assigned scheduler */
 
 		void _assign(Time             period,
@@ -59,7 +60,14 @@ class Genode::Alarm
 		}
 
 		void _reset() {
-			_assign(0, 0, false, 0), _active = 0, _next = 0; }
+			_assign(0, 0, false, 0), _active = 0; }
+
+		/**
+		 * Order of alarms in the schedule, used by 'Pairing_heap'
+		 */
+		bool earlier(Alarm const &other) const {
+			return _raw.is_pending_at(other._raw.deadline,
+			                          other._raw.deadline_period); }
 
 		/*
 		 * Noncopyable
@@ -90,11 +98,11 @@ class Genode::Alarm_scheduler
 {
 	private:
 
-		Lock         _lock       { };         /* protect alarm list                     */
-		Alarm       *_head       { nullptr }; /* head of alarm list                     */
-		Alarm::Time  _now        { 0UL };     /* recent time (updated by handle method) */
-		bool         _now_period { false };
-		Alarm::Raw   _min_handle_period { };
+		Lock                 _lock       { };     /* protect alarm heap                     */
+		Pairing_heap<Alarm>  _alarms     { };     /* scheduled alarms, earliest first       */
+		Alarm::Time          _now        { 0UL }; /* recent time (updated by handle method) */
+		bool                 _now_period { false };
+		Alarm::Raw           _min_handle_period { };
 
 		/**
 		 * Enqueue alarm into alarm queue
@@ -109,7 +117,7 @@ class Genode::Alarm_scheduler
 		void _unsynchronized_dequeue(Alarm *alarm);
 
 		/**
-		 * Dequeue next pending alarm from alarm list
+		 * Dequeue next pending alarm from alarm heap
 		 *
 		 * \return  dequeued pending alarm
 		 * \retval  0  no alarm pending
@@ -183,7 +191,7 @@ class Genode::Alarm_scheduler
 		 * \param alarm  alarm object
 		 * \return true if alarm is head element of timeout queue
 		 */
-		bool head_timeout(const Alarm * alarm) { return _head == alarm; }
+		bool head_timeout(const Alarm * alarm) { return _alarms.first() == alarm; }
 };
 
 #endif /* _INCLUDE__OS__ALARM_H_ */
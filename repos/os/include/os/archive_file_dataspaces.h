@@ -0,0 +1,187 @@
+/*
+ * \brief  Dataspaces with the content of files contained in an archive ROM
+ * \date   2026-10-18
+ *
+ * If the content of a file starts at a page boundary of the archive and
+ * spans at least one page, the file is provided as a managed dataspace that
+ * maps the corresponding part of the archive ROM. Otherwise, the content is
+ * copied into a RAM dataspace.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__ARCHIVE_FILE_DATASPACES_H_
+#define _INCLUDE__OS__ARCHIVE_FILE_DATASPACES_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+#include <util/reconstructible.h>
+#include <util/retry.h>
+
+namespace Genode { class Archive_file_dataspaces; }
+
+
+class Genode::Archive_file_dataspaces
+{
+	public:
+
+		/**
+		 * Dataspace of one file and the resources backing it
+		 */
+		struct File
+		{
+			Dataspace_capability     ds  { };
+			Capability<Region_map>   rm  { };
+			Ram_dataspace_capability ram { };
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Archive_file_dataspaces(Archive_file_dataspaces const &);
+		Archive_file_dataspaces &operator = (Archive_file_dataspaces const &);
+
+		enum { PAGE_SIZE_LOG2 = 12, PAGE_SIZE = 1 << PAGE_SIZE_LOG2 };
+
+		/* number of quota upgrades of the RM session per file */
+		enum { UPGRADE_ATTEMPTS = 4 };
+
+		Env &_env;
+
+		Attached_rom_dataspace const &_archive;
+
+		/* created on demand as the RM service may be unavailable */
+		Constructible<Rm_connection> _rm { };
+
+		void _destroy_rm(File &file)
+		{
+			if (file.rm.valid())
+				_rm->destroy(file.rm);
+
+			file.rm = Capability<Region_map>();
+		}
+
+		/**
+		 * Map file content from the archive ROM
+		 *
+		 * Only the whole pages of the content are mapped from the archive.
+		 * The last partial page is backed by a zero-padded copy. Otherwise,
+		 * the remainder of the page would expose the subsequent archive
+		 * records. If the quota of the RM session is exhausted, the session
+		 * is upgraded and the attempt repeated.
+		 *
+		 * \return false if the content is not page-aligned within the archive
+		 *         or smaller than a page
+		 */
+		bool _map(File &file, char const *content, size_t size)
+		{
+			size_t const offset = content - _archive.local_addr<char const>();
+			size_t const mapped = size & ~(size_t)(PAGE_SIZE - 1);
+			size_t const tail   = size - mapped;
+
+			if (!mapped || (offset & (PAGE_SIZE - 1)) || offset + mapped > _archive.size())
+				return false;
+
+			try {
+				if (!_rm.constructed())
+					_rm.construct(_env);
+
+				if (tail) {
+					file.ram = _env.ram().alloc(PAGE_SIZE);
+
+					Attached_dataspace ds(_env.rm(), file.ram);
+					memcpy(ds.local_addr<char>(), content + mapped, tail);
+				}
+
+				auto create = [&] () {
+					file.rm = _rm->create(align_addr(size, PAGE_SIZE_LOG2));
+
+					Region_map_client rm(file.rm);
+					rm.attach_at(_archive.cap(), 0, mapped, offset);
+
+					if (tail)
+						rm.attach_at(file.ram, mapped, PAGE_SIZE, 0);
+
+					file.ds = rm.dataspace();
+				};
+
+				retry<Out_of_caps>(
+					[&] () {
+						retry<Out_of_ram>(create,
+							[&] () {
+								_destroy_rm(file);
+								_rm->upgrade_ram(8*1024);
+							}, UPGRADE_ATTEMPTS);
+					},
+					[&] () {
+						_destroy_rm(file);
+						_rm->upgrade_caps(2);
+					}, UPGRADE_ATTEMPTS);
+
+				return true;
+			}
+			catch (...) {
+				free(file);
+				return false;
+			}
+		}
+
+		/**
+		 * Copy file content into a RAM dataspace
+		 */
+		bool _copy(File &file, char const *content, size_t size)
+		{
+			try {
+				file.ram = _env.ram().alloc(size);
+				file.ds  = file.ram;
+
+				Attached_dataspace ds(_env.rm(), file.ram);
+				memcpy(ds.local_addr<char>(), content, min(size, ds.size()));
+				return true;
+			}
+			catch (...) {
+				free(file);
+				return false;
+			}
+		}
+
+	public:
+
+		Archive_file_dataspaces(Env &env, Attached_rom_dataspace const &archive)
+		: _env(env), _archive(archive) { }
+
+		/**
+		 * Provide dataspace with file content located within the archive
+		 *
+		 * \return false if the resources for the dataspace are exhausted
+		 */
+		bool alloc(File &file, char const *content, size_t size)
+		{
+			return _map(file, content, size) || _copy(file, content, size);
+		}
+
+		/**
+		 * Release the dataspace of a file
+		 */
+		void free(File &file)
+		{
+			_destroy_rm(file);
+
+			if (file.ram.valid())
+				_env.ram().free(file.ram);
+
+			file = File();
+		}
+};
+
+#endif /* _INCLUDE__OS__ARCHIVE_FILE_DATASPACES_H_ */
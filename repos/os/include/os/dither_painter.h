@@ -18,10 +18,121 @@
 #include <util/dither_matrix.h>
 #include <os/surface.h>
 #include <os/texture.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <os/pixel_alpha8.h>
 
 
 struct Dither_painter
 {
+	typedef Genode::Dither_matrix::Row Dither_row;
+
+	/**
+	 * Convert row of 'count' pixels starting at the horizontal position 'x'
+	 *
+	 * \param alpha  alpha values of the source pixels, or nullptr
+	 */
+	template <typename DST_PT, typename SRC_PT>
+	static inline void dither_row(DST_PT *dst, SRC_PT const *src,
+	                              unsigned char const *alpha,
+	                              Dither_row const row, unsigned x, unsigned count)
+	{
+		using Genode::max;
+
+		for (; count--; x++) {
+
+			int const v = row.value(x) >> 4;
+
+			SRC_PT const pixel = *src++;
+
+			int const r = pixel.r() - v;
+			int const g = pixel.g() - v;
+			int const b = pixel.b() - v;
+
+			if (alpha) {
+				int const a = *alpha ? (int)*alpha - v : 0;
+				alpha++;
+
+				*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
+			} else {
+				*dst++ = DST_PT(max(0, r), max(0, g), max(0, b));
+			}
+		}
+	}
+
+	/*
+	 * The following versions convert four pixels at once using the vector
+	 * extensions of the compiler. They produce the same pixel values as the
+	 * generic version.
+	 */
+
+	typedef int Lanes __attribute__((vector_size(16)));
+
+	enum { NUM_LANES = 4 };
+
+	static inline void dither_row(Genode::Pixel_rgb565 *dst,
+	                              Genode::Pixel_rgb888 const *src,
+	                              unsigned char const *alpha,
+	                              Dither_row const row, unsigned x, unsigned count)
+	{
+		/* the alpha value does not affect RGB565 pixels */
+		for (; count >= NUM_LANES; count -= NUM_LANES, x += NUM_LANES,
+		                           src += NUM_LANES, dst += NUM_LANES,
+		                           alpha += alpha ? NUM_LANES : 0) {
+			Lanes p { }, v { };
+			for (unsigned i = 0; i < NUM_LANES; i++) {
+				p[i] = src[i].pixel;
+				v[i] = row.value(x + i) >> 4;
+			}
+
+			Lanes r = ((p >> 16) & 0xff) - v,
+			      g = ((p >>  8) & 0xff) - v,
+			      b = ( p        & 0xff) - v;
+
+			/* clamp negative values to zero */
+			r &= ~(r >> 31);
+			g &= ~(g >> 31);
+			b &= ~(b >> 31);
+
+			Lanes const res = ((r << 8) & 0xf800) | ((g << 3) & 0x07e0) | (b >> 3);
+
+			for (unsigned i = 0; i < NUM_LANES; i++)
+				dst[i].pixel = (unsigned short)res[i];
+		}
+
+		dither_row<Genode::Pixel_rgb565, Genode::Pixel_rgb888>(dst, src, alpha,
+		                                                       row, x, count);
+	}
+
+	static inline void dither_row(Genode::Pixel_alpha8 *dst,
+	                              Genode::Pixel_rgb888 const *src,
+	                              unsigned char const *alpha,
+	                              Dither_row const row, unsigned x, unsigned count)
+	{
+		/* without alpha values, all pixels become opaque */
+		if (alpha) {
+			for (; count >= NUM_LANES; count -= NUM_LANES, x += NUM_LANES,
+			                           src += NUM_LANES, dst += NUM_LANES,
+			                           alpha += NUM_LANES) {
+				Lanes a { }, v { };
+				for (unsigned i = 0; i < NUM_LANES; i++) {
+					a[i] = alpha[i];
+					v[i] = row.value(x + i) >> 4;
+				}
+
+				/* keep transparent pixels, clamp negative values to zero */
+				Lanes res = (a - v) & ~(Lanes)(a == 0);
+				res &= ~(res >> 31);
+
+				for (unsigned i = 0; i < NUM_LANES; i++)
+					dst[i].pixel = (unsigned char)res[i];
+			}
+		}
+
+		dither_row<Genode::Pixel_alpha8, Genode::Pixel_rgb888>(dst, src, alpha,
+		                                                       row, x, count);
+	}
+
 	/*
 	 * Surface and texture must have the same size
 	 */
@@ -46,49 +157,21 @@ struct Dither_painter
 		unsigned const src_line_len = texture.size().w();
 		unsigned const src_offset = src_line_len*clipped.y1() + clipped.x1();
 
-		DST_PT              *dst,       *dst_line       = surface.addr()  + dst_offset;
-		SRC_PT        const *src_pixel, *src_pixel_line = texture.pixel() + src_offset;
-		unsigned char const *src_alpha, *src_alpha_line = texture.alpha() + src_offset;
-		bool          const  src_has_alpha = texture.alpha() != nullptr;
+		DST_PT              *dst_line       = surface.addr()  + dst_offset;
+		SRC_PT        const *src_pixel_line = texture.pixel() + src_offset;
+		unsigned char const *src_alpha_line = texture.alpha() + src_offset;
+		bool          const  src_has_alpha  = texture.alpha() != nullptr;
 
 		unsigned const x_max = min((unsigned)clipped.x2(), dst_x + texture.size().w() - 1);
 		unsigned const y_max = min((unsigned)clipped.y2(), dst_y + texture.size().h() - 1);
 
-		for (unsigned y = dst_y; y <= y_max; y++) {
+		if (x_max < dst_x) return;
 
-			src_pixel = src_pixel_line;
-			src_alpha = src_alpha_line;
-			dst       = dst_line;
-
-			if (src_has_alpha) {
-				for (unsigned x = dst_x; x <= x_max; x++) {
-
-					int const v = Genode::Dither_matrix::value(x, y) >> 4;
-
-					SRC_PT        const pixel = *src_pixel++;
-					unsigned char const alpha = *src_alpha++;
-
-					int const r = pixel.r() - v;
-					int const g = pixel.g() - v;
-					int const b = pixel.b() - v;
-					int const a = alpha ? (int)alpha - v : 0;
-
-					*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
-				}
-			} else {
-				for (unsigned x = dst_x; x <= x_max; x++) {
-
-					int const v = Genode::Dither_matrix::value(x, y) >> 4;
-
-					SRC_PT const pixel = *src_pixel++;
-
-					int const r = pixel.r() - v;
-					int const g = pixel.g() - v;
-					int const b = pixel.b() - v;
+		for (unsigned y = dst_y; y <= y_max; y++) {
 
-					*dst++ = DST_PT(max(0, r), max(0, g), max(0, b));
-				}
-			}
+			dither_row(dst_line, src_pixel_line,
+			           src_has_alpha ? src_alpha_line : nullptr,
+			           Genode::Dither_matrix::row(y), dst_x, x_max - dst_x + 1);
 
 			src_pixel_line += src_line_len;
 			src_alpha_line += src_line_len;
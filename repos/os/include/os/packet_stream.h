@@ -38,14 +38,13 @@
  *
  * :submit queue is full: when the source is trying to submit a new packet.
  *   In this case, the source blocks and waits for the sink to remove packets
- *   from the submit queue. If the sink observes such a condition (calling
- *   'get_packet' on a full submit queue, it delivers a 'ready_to_submit'
- *   signal to wake up the source.
+ *   from the submit queue. If the sink removes a packet while the source is
+ *   waiting, it delivers a 'ready_to_submit' signal to wake up the source.
  *
  * :submit queue is empty: when the sink tries to obtain a packet via
  *   'get_packet'. The sink is going to block. If the source places a
- *   packet into an empty submit queue, it delivers a 'packet_avail'
- *   signal to wake up the sink.
+ *   packet into the submit queue while the sink is waiting, it delivers a
+ *   'packet_avail' signal to wake up the sink.
  *
  * :acknowledgement queue is full: when the sink tries to acknowledge a packet
  *   using 'acknowledge_packet'. The sink is going to block until the source
@@ -55,11 +54,20 @@
  * :acknowledgement queue is empty: when the source tries to obtain an
  *   acknowledged packet using 'get_acked_packet'. In this case, the source
  *   will block until the sink places another acknowledged packet into the
- *   empty acknowledgement queue and delivers a 'ack_avail' signal.
+ *   acknowledgement queue and delivers a 'ack_avail' signal.
  *
  * These conditions can be avoided by querying the state of the submit and
  * acknowledge buffers using the methods 'packet_avail',
- * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
+ * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'. A query that finds
+ * the queue empty (or full respectively) registers the caller as waiting,
+ * so that the peer delivers the corresponding signal once the condition
+ * changes. Signals are not delivered while the peer is not waiting. Hence,
+ * a party driven by signals must process packets until such a query fails
+ * before returning to its entrypoint.
+ *
+ * Each queue has a single producer and a single consumer. The queue indices
+ * are updated without locking, so each side of a packet stream must be
+ * driven by one thread at a time.
  *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
@@ -81,6 +89,9 @@
 #include <dataspace/client.h>
 #include <util/string.h>
 #include <util/construct_at.h>
+#include <util/misc_math.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode {
 
@@ -149,6 +160,17 @@ class Genode::Packet_descriptor
 /**
  * Ring buffer shared between source and sink, containing packet descriptors
  *
+ * The queue is a lock-free single-producer single-consumer ring. The head
+ * index is written by the producer only, the tail index by the consumer only.
+ * Both indices reside in distinct cache lines to avoid false sharing. Each
+ * side publishes its index after accessing the corresponding queue element
+ * (release) and reads the index of the peer before accessing an element
+ * (acquire).
+ *
+ * In addition, each side may announce that it waits for the peer. The
+ * peer clears the announcement atomically when it changes the state of the
+ * queue and delivers a wakeup signal only if the announcement was present.
+ *
  * This class is private to the packet-stream interface.
  */
 template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
@@ -156,14 +178,24 @@ class Genode::Packet_descriptor_queue
 {
 	private:
 
+		enum { CACHE_LINE_SIZE = 64 };
+
 		/*
 		 * The anonymous struct is needed to skip the initialization of the
 		 * members, which are shared by both sides of the packet stream.
 		 */
 		struct
 		{
-			unsigned          _head;
-			unsigned          _tail;
+			unsigned volatile _head;
+			char              _head_pad[CACHE_LINE_SIZE - sizeof(unsigned)];
+
+			unsigned volatile _tail;
+			char              _tail_pad[CACHE_LINE_SIZE - sizeof(unsigned)];
+
+			int volatile      _consumer_waits;
+			int volatile      _producer_waits;
+			char              _waits_pad[CACHE_LINE_SIZE - 2*sizeof(int)];
+
 			PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
 		};
 
@@ -180,14 +212,19 @@ class Genode::Packet_descriptor_queue
 		 * source and at the sink) inside a shared-memory block, the
 		 * constructor must know the role of the instance to initialize only
 		 * those members that are driven by the respective role.
+		 *
+		 * The consumer starts in waiting state because the queue is empty.
 		 */
 		Packet_descriptor_queue(Role role)
 		{
 			if (role == PRODUCER) {
 				_head = 0;
+				_producer_waits = 0;
 				Genode::memset(_queue, 0, sizeof(_queue));
-			} else
+			} else {
 				_tail = 0;
+				_consumer_waits = 1;
+			}
 		}
 
 		/**
@@ -200,8 +237,13 @@ class Genode::Packet_descriptor_queue
 		{
 			if (full()) return false;
 
-			_queue[_head%QUEUE_SIZE] = packet;
-			_head = (_head + 1)%QUEUE_SIZE;
+			unsigned const head = _head;
+
+			_queue[head%QUEUE_SIZE] = packet;
+
+			/* publish element before advancing the head */
+			Genode::memory_barrier();
+			_head = (head + 1)%QUEUE_SIZE;
 			return true;
 		}
 
@@ -212,16 +254,68 @@ class Genode::Packet_descriptor_queue
 		 */
 		PACKET_DESCRIPTOR get()
 		{
-			PACKET_DESCRIPTOR packet = _queue[_tail%QUEUE_SIZE];
-			_tail = (_tail + 1)%QUEUE_SIZE;
+			unsigned const tail = _tail;
+
+			/* read element only after observing the head */
+			Genode::memory_barrier();
+			PACKET_DESCRIPTOR packet = _queue[tail%QUEUE_SIZE];
+
+			/* release the slot not before the element was read */
+			Genode::memory_barrier();
+			_tail = (tail + 1)%QUEUE_SIZE;
 			return packet;
 		}
 
+		/**
+		 * Place up to 'count' packet descriptors into queue
+		 *
+		 * The descriptors are published with a single update of the head.
+		 *
+		 * \return number of descriptors added
+		 */
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned count)
+		{
+			unsigned const n    = Genode::min(count, slots_free());
+			unsigned const head = _head;
+
+			for (unsigned i = 0; i < n; i++)
+				_queue[(head + i)%QUEUE_SIZE] = packets[i];
+
+			/* publish elements before advancing the head */
+			Genode::memory_barrier();
+			_head = (head + n)%QUEUE_SIZE;
+			return n;
+		}
+
+		/**
+		 * Take up to 'max' packet descriptors from queue
+		 *
+		 * The slots are released with a single update of the tail.
+		 *
+		 * \return number of descriptors taken
+		 */
+		unsigned get(PACKET_DESCRIPTOR *out, unsigned max)
+		{
+			unsigned const n    = Genode::min(max, avail());
+			unsigned const tail = _tail;
+
+			/* read elements only after observing the head */
+			Genode::memory_barrier();
+			for (unsigned i = 0; i < n; i++)
+				out[i] = _queue[(tail + i)%QUEUE_SIZE];
+
+			/* release the slots not before the elements were read */
+			Genode::memory_barrier();
+			_tail = (tail + n)%QUEUE_SIZE;
+			return n;
+		}
+
 		/**
 		 * Return current packet descriptor
 		 */
 		PACKET_DESCRIPTOR peek() const
 		{
+			Genode::memory_barrier();
 			return _queue[_tail%QUEUE_SIZE];
 		}
 
@@ -236,22 +330,67 @@ class Genode::Packet_descriptor_queue
 		bool full() { return (_head + 1)%QUEUE_SIZE == _tail; }
 
 		/**
-		 * Return true if a single element is stored in the queue
+		 * Return number of slots left to be put into the queue
+		 */
+		unsigned slots_free()
+		{
+			unsigned const head = _head, tail = _tail;
+			return ((tail > head) ? tail - head
+			                      : QUEUE_SIZE - head + tail) - 1;
+		}
+
+		/**
+		 * Return number of packet descriptors stored in the queue
 		 */
-		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
+		unsigned avail() { return QUEUE_SIZE - 1 - slots_free(); }
 
+		/**
+		 * Announce that the consumer waits for the queue to become non-empty
+		 *
+		 * The caller must re-check 'empty' afterwards. The atomic operation
+		 * acts as full memory barrier between the announcement and the
+		 * re-check.
+		 */
+		void consumer_wait() { Genode::cmpxchg(&_consumer_waits, 0, 1); }
 
 		/**
-		 * Return true if a single slot is left to be put into the queue
+		 * Announce that the producer waits for the queue to become non-full
 		 */
-		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+		void producer_wait() { Genode::cmpxchg(&_producer_waits, 0, 1); }
 
 		/**
-		 * Return number of slots left to be put into the queue
+		 * Withdraw the consumer's announcement
+		 *
+		 * Must be called after advancing the head. The wakeup relies on the
+		 * store of the head being ordered before the load of the waiter
+		 * flag. Otherwise, the consumer could announce its waiting, still
+		 * observe the old head, and block while the producer misses the
+		 * announcement. Because 'cmpxchg' does not imply a barrier before
+		 * the load on all architectures, e.g., ARM, a full barrier is
+		 * executed first.
+		 *
+		 * \return true if the consumer was waiting and needs a wakeup
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		bool consumer_wakeup()
+		{
+			Genode::memory_barrier();
+			return Genode::cmpxchg(&_consumer_waits, 1, 0);
+		}
+
+		/**
+		 * Withdraw the producer's announcement
+		 *
+		 * Must be called after advancing the tail. The store of the tail is
+		 * ordered before the load of the waiter flag as for
+		 * 'consumer_wakeup'.
+		 *
+		 * \return true if the producer was waiting and needs a wakeup
+		 */
+		bool producer_wakeup()
+		{
+			Genode::memory_barrier();
+			return Genode::cmpxchg(&_producer_waits, 1, 0);
+		}
 };
 
 
@@ -273,8 +412,7 @@ class Genode::Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Genode::Signal_transmitter         _rx_ready { };
 
-		Genode::Lock _tx_queue_lock { };
-		TX_QUEUE    *_tx_queue;
+		TX_QUEUE *_tx_queue;
 
 		/*
 		 * Noncopyable
@@ -318,35 +456,73 @@ class Genode::Packet_descriptor_transmitter
 
 		bool ready_for_tx()
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			if (!_tx_queue->full())
+				return true;
+
+			/* ask the receiver for a signal once a slot becomes free */
+			_tx_queue->producer_wait();
 			return !_tx_queue->full();
 		}
 
 		void tx(typename TX_QUEUE::Packet_descriptor packet)
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			while (_tx_queue->add(packet) == false) {
 
-			do {
-				/* block for signal if tx queue is full */
+				/*
+				 * Block for signal if tx queue is full. It could happen that
+				 * pending signals do not refer to the current queue
+				 * situation. Therefore, we need to double check if the queue
+				 * insertion succeeds and retry if needed.
+				 */
+				_tx_queue->producer_wait();
 				if (_tx_queue->full())
 					_tx_ready.wait_for_signal();
+			}
 
-				/*
-				 * It could happen that pending signals do not refer to the
-				 * current queue situation. Therefore, we need to double check
-				 * if the queue insertion succeeds and retry if needed.
-				 */
+			if (_tx_queue->consumer_wakeup())
+				_rx_ready.submit();
+		}
 
-			} while (_tx_queue->add(packet) == false);
+		/**
+		 * Transmit 'count' packets, blocking while the tx queue is full
+		 *
+		 * The receiver is woken up at most once for each chunk of packets
+		 * that fits into the queue.
+		 */
+		void tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		        unsigned count)
+		{
+			while (count) {
 
-			if (_tx_queue->single_element())
-				_rx_ready.submit();
+				unsigned const n = _tx_queue->add(packets, count);
+
+				packets += n;
+				count   -= n;
+
+				if (n && _tx_queue->consumer_wakeup())
+					_rx_ready.submit();
+
+				if (!count)
+					break;
+
+				_tx_queue->producer_wait();
+				if (_tx_queue->full())
+					_tx_ready.wait_for_signal();
+			}
 		}
 
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
-		unsigned tx_slots_free() { return _tx_queue->slots_free(); }
+		unsigned tx_slots_free()
+		{
+			unsigned const slots = _tx_queue->slots_free();
+			if (slots)
+				return slots;
+
+			_tx_queue->producer_wait();
+			return _tx_queue->slots_free();
+		}
 };
 
 
@@ -368,8 +544,7 @@ class Genode::Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Genode::Signal_transmitter        _tx_ready { };
 
-		Genode::Lock mutable  _rx_queue_lock { };
-		RX_QUEUE             *_rx_queue;
+		RX_QUEUE *_rx_queue;
 
 		/*
 		 * Noncopyable
@@ -413,26 +588,45 @@ class Genode::Packet_descriptor_receiver
 
 		bool ready_for_rx()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			if (!_rx_queue->empty())
+				return true;
+
+			/* ask the transmitter for a signal once a packet arrives */
+			_rx_queue->consumer_wait();
 			return !_rx_queue->empty();
 		}
 
 		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
-
-			while (_rx_queue->empty())
+			while (!ready_for_rx())
 				_rx_ready.wait_for_signal();
 
 			*out_packet = _rx_queue->get();
 
-			if (_rx_queue->single_slot_free())
+			if (_rx_queue->producer_wakeup())
+				_tx_ready.submit();
+		}
+
+		/**
+		 * Receive up to 'max' packets without blocking
+		 *
+		 * \return number of packets received
+		 */
+		unsigned rx(typename RX_QUEUE::Packet_descriptor *out, unsigned max)
+		{
+			if (!max || !ready_for_rx())
+				return 0;
+
+			unsigned const n = _rx_queue->get(out, max);
+
+			if (_rx_queue->producer_wakeup())
 				_tx_ready.submit();
+
+			return n;
 		}
 
 		typename RX_QUEUE::Packet_descriptor rx_peek() const
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
 			return _rx_queue->peek();
 		}
 };
@@ -716,6 +910,17 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about multiple packets to process
+		 *
+		 * The packets are published at once and the sink receives at most
+		 * one signal. This method blocks while the submit queue is full.
+		 */
+		void submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			_submit_transmitter.tx(packets, count);
+		}
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -731,6 +936,16 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max' acknowledged packets without blocking
+		 *
+		 * \return number of packets stored at 'out'
+		 */
+		unsigned get_acked_packets(Packet_descriptor *out, unsigned max)
+		{
+			return _ack_receiver.rx(out, max);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -849,6 +1064,16 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max' packets from source without blocking
+		 *
+		 * \return number of packets stored at 'out'
+		 */
+		unsigned get_packets(Packet_descriptor *out, unsigned max)
+		{
+			return _submit_receiver.rx(out, max);
+		}
+
 		/**
 		 * Return but do not dequeue next packet
 		 *
@@ -893,6 +1118,18 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			_ack_transmitter.tx(packet);
 		}
 
+		/**
+		 * Acknowledge multiple packets at once
+		 *
+		 * The acknowledgements are published at once and the source receives
+		 * at most one signal. This method blocks while the acknowledgement
+		 * queue is full.
+		 */
+		void acknowledge_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			_ack_transmitter.tx(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -26,6 +26,7 @@ namespace Rom {
 	using Genode::Interface;
 
 	class Module;
+	class Version;
 	class Readable_module;
 	class Registry;
 	class Writer;
@@ -35,6 +36,7 @@ namespace Rom {
 	typedef Genode::List<Module> Module_list;
 	typedef Genode::List<Reader> Reader_list;
 	typedef Genode::List<Writer> Writer_list;
+	typedef Genode::List<Version> Version_list;
 }
 
 
@@ -57,6 +59,46 @@ struct Rom::Reader : private Reader_list::Element, Interface
 };
 
 
+/**
+ * Snapshot of the module content
+ *
+ * If the module shares its versions, the content of a published version is
+ * never modified. Hence, ROM sessions can hand out the dataspace of a version
+ * to their clients directly instead of copying the content. A version is kept
+ * as long as it is the current version of its module or referenced by a ROM
+ * session.
+ */
+class Rom::Version : private Version_list::Element
+{
+	private:
+
+		friend class Module;
+		friend class Genode::List<Version>;
+
+		Attached_ram_dataspace _ds;
+
+		/**
+		 * Content size, which may be less than the capacity of '_ds'
+		 */
+		size_t _size = 0;
+
+		/**
+		 * Number of ROM sessions referring to the version
+		 */
+		unsigned mutable _refs = 0;
+
+		Version(Genode::Ram_session &ram, Genode::Region_map &rm,
+		        size_t capacity)
+		: _ds(ram, rm, capacity) { }
+
+	public:
+
+		Genode::Dataspace_capability cap() const { return _ds.cap(); }
+
+		size_t size() const { return _size; }
+};
+
+
 struct Rom::Readable_module : Interface
 {
 	/**
@@ -75,6 +117,19 @@ struct Rom::Readable_module : Interface
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Obtain reference to the current version of the content
+	 *
+	 * \return  current version, or nullptr if the module has no content,
+	 *          does not share its versions, or if the reader is not
+	 *          permitted to read it
+	 *
+	 * Each acquired version must be released via 'release_version'.
+	 */
+	virtual Version const *acquire_version(Reader const &reader) const = 0;
+
+	virtual void release_version(Version const &version) const = 0;
 };
 
 
@@ -136,6 +191,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 		Name _name;
 
+		Genode::Allocator   &_alloc;
 		Genode::Ram_session &_ram;
 		Genode::Region_map  &_rm;
 
@@ -151,18 +207,83 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		Writer const *_last_writer = nullptr;
 
 		/**
-		 * Dataspace used as backing store
+		 * Versions used as backing store
 		 *
-		 * The buffer for the content is not allocated from the heap to
-		 * allow for the immediate release of the underlying backing store when
-		 * the module gets destructed.
+		 * If versions are shared with ROM sessions, a new report is written
+		 * to a spare version, which becomes the current version afterwards.
+		 * So the content of versions referenced by ROM sessions is never
+		 * modified. With no lagging readers, the module alternates between
+		 * two versions. Otherwise, the readers copy the content and a new
+		 * report overwrites the current version if it is large enough. The
+		 * buffers for the content are not allocated from the heap to allow
+		 * for the immediate release of the underlying backing store once a
+		 * version is no longer referenced.
 		 */
-		Constructible<Attached_ram_dataspace> _ds { };
+		Version_list mutable _versions { };
+
+		Version *_current = nullptr;
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * True once a ROM session obtained a version via 'acquire_version'
 		 */
-		size_t _size = 0;
+		bool mutable _shared = false;
+
+		void _destroy(Version &version) const
+		{
+			_versions.remove(&version);
+			Genode::destroy(&_alloc, &version);
+		}
+
+		/**
+		 * Destroy versions that are neither current nor referenced
+		 *
+		 * While the module has a writer and shares its versions, one
+		 * unreferenced version is kept as spare buffer for the next report.
+		 */
+		void _collect() const
+		{
+			bool keep_spare = _shared && (_last_writer != nullptr);
+
+			for (Version *v = _versions.first(), *next = nullptr; v; v = next) {
+				next = v->next();
+
+				if (v == _current || v->_refs)
+					continue;
+
+				if (keep_spare) {
+					keep_spare = false;
+					continue;
+				}
+				_destroy(*v);
+			}
+		}
+
+		/**
+		 * Return version with at least 'capacity' bytes for the next report
+		 */
+		Version &_writable_version(size_t capacity)
+		{
+			/* write in place if no ROM session refers to the current version */
+			if (!_shared && _current && !_current->_refs &&
+			    _current->_ds.size() >= capacity)
+				return *_current;
+
+			for (Version *v = _versions.first(); v; v = v->next()) {
+
+				if (v == _current || v->_refs)
+					continue;
+
+				if (v->_ds.size() >= capacity)
+					return *v;
+
+				_destroy(*v);
+				break;
+			}
+
+			Version * const version = new (&_alloc) Version(_ram, _rm, capacity);
+			_versions.insert(version);
+			return *version;
+		}
 
 
 		/********************************
@@ -174,6 +295,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		/**
 		 * Constructor
 		 *
+		 * \param alloc         allocator for the version meta data
 		 * \param ram           RAM session from which to allocate the module's
 		 *                      backing store
 		 * \param rm            region map of the local address space, needed
@@ -184,13 +306,14 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
 		 */
-		Module(Genode::Ram_session &ram,
+		Module(Genode::Allocator   &alloc,
+		       Genode::Ram_session &ram,
 		       Genode::Region_map  &rm,
 		       Name          const &name,
 		       Read_policy   const &read_policy,
 		       Write_policy  const &write_policy)
 		:
-			_name(name), _ram(ram), _rm(rm),
+			_name(name), _alloc(alloc), _ram(ram), _rm(rm),
 			_read_policy(read_policy), _write_policy(write_policy)
 		{ }
 
@@ -223,9 +346,9 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				_current     = nullptr;
 				_last_writer = nullptr;
+				_collect();
 			}
 		}
 
@@ -247,6 +370,12 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 	public:
 
+		~Module()
+		{
+			while (Version *v = _versions.first())
+				_destroy(*v);
+		}
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -257,26 +386,35 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
-
 			_last_writer = &writer;
 
 			/*
-			 * Realloc backing store if needed
-			 *
 			 * Take a terminating zero into account, which we append to each
 			 * report. This way, we do not need to trust report clients to
 			 * append a zero termination to textual reports.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			Version &version = _writable_version(src_len + 1);
+			char * const dst = version._ds.local_addr<char>();
 
-			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
+			/*
+			 * Copy content into backing store
+			 *
+			 * The report dataspace remains writeable by the report client.
+			 * Hence, this copy is needed to provide consistent content to
+			 * the readers.
+			 */
+			Genode::memcpy(dst, src, src_len);
+
+			/* clear remainder of the previous content of a recycled buffer */
+			if (version._size > src_len)
+				Genode::memset(dst + src_len, 0, version._size - src_len);
 
 			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			dst[src_len] = 0;
+
+			version._size = src_len;
+			_current      = &version;
+			_collect();
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -293,20 +431,50 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if (!_current || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
 				return 0;
 
-			if (dst_len < _size)
+			if (dst_len < _current->_size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
-			return _size;
+			Genode::memcpy(dst, _current->_ds.local_addr<char>(), _current->_size);
+			return _current->_size;
+		}
+
+		virtual size_t size() const override
+		{
+			return _current ? _current->_size : 0;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		Version const *acquire_version(Reader const &reader) const override
+		{
+			if (!_current || !_last_writer)
+				return nullptr;
+
+			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			_shared = true;
+			_current->_refs++;
+			return _current;
 		}
 
-		virtual size_t size() const override { return _size; }
+		/**
+		 * Readable_module interface
+		 */
+		void release_version(Version const &version) const override
+		{
+			if (version._refs)
+				version._refs--;
+
+			_collect();
+		}
 
 		Name name() const { return _name; }
 };
@@ -38,6 +38,16 @@ struct Rom::Registry_for_reader : Interface
 	                                Module::Name const &rom_label) = 0;
 
 	virtual void release(Reader &reader, Readable_module &module) = 0;
+
+	/**
+	 * Return true if the module versions may be handed out to the ROM
+	 * session with the given label without copying
+	 *
+	 * The dataspace of a shared version is writable by each client it is
+	 * handed out to. Hence, sharing must be permitted only for clients that
+	 * trust each other.
+	 */
+	virtual bool shared_dataspace(Module::Name const &) const { return false; }
 };
 
 
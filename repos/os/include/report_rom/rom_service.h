@@ -35,6 +35,12 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 {
 	private:
 
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 		Genode::Ram_session &_ram;
 		Genode::Region_map  &_rm;
 
@@ -51,6 +57,32 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				throw Genode::Service_denied(); }
 		}
 
+		/**
+		 * Hand out the dataspace of the module version to the client
+		 *
+		 * RAM dataspaces cannot be handed out read-only. A client of a
+		 * shared version could therefore modify the content seen by the
+		 * other clients of the same version. Sharing is thereby limited
+		 * to clients for which the registry permits it.
+		 */
+		bool const _shared;
+
+		/**
+		 * Module version handed out to the client if '_shared' is set
+		 */
+		Version const *_version = nullptr;
+
+		void _release_version()
+		{
+			if (_version)
+				_module.release_version(*_version);
+
+			_version = nullptr;
+		}
+
+		/**
+		 * Private copy of the module content if not '_shared'
+		 */
 		Constructible<Genode::Attached_ram_dataspace> _ds { };
 
 		size_t _content_size = 0;
@@ -71,12 +103,16 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 	public:
 
+		/**
+		 * Constructor
+		 */
 		Session_component(Genode::Ram_session &ram, Genode::Region_map &rm,
 		                  Registry_for_reader &registry,
 		                  Genode::Session_label const &label)
 		:
 			_ram(ram), _rm(rm),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_shared(_registry.shared_dataspace(label.string()))
 		{ }
 
 		/**
@@ -90,11 +126,13 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		:
 			_ram(*Genode::env_deprecated()->ram_session()),
 			_rm(*Genode::env_deprecated()->rm_session()),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_shared(false)
 		{ }
 
 		~Session_component()
 		{
+			_release_version();
 			_registry.release(*this, _module);
 		}
 
@@ -104,6 +142,18 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
+				_release_version();
+
+				if (_shared) {
+					_version = _module.acquire_version(*this);
+					if (_version) {
+						_ds.destruct();
+						_content_size = _version->size();
+						_valid        = true;
+						return static_cap_cast<Rom_dataspace>(_version->cap());
+					}
+				}
+
 				/* replace dataspace by new one */
 				/* XXX we could keep the old dataspace if the size fits */
 				_ds.construct(_ram, _rm, _module.size());
@@ -121,6 +171,19 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/*
+			 * A shared version is never modified. The client has to request
+			 * the dataspace of the new version unless the version is still
+			 * current.
+			 */
+			if (_shared) {
+				Version const * const current = _module.acquire_version(*this);
+				if (current)
+					_module.release_version(*current);
+
+				return _version && current == _version;
+			}
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
@@ -188,7 +251,8 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			using namespace Genode;
 
 			return new (md_alloc())
-				Session_component(_env.ram(), _env.rm(), _registry, label_from_args(args));
+				Session_component(_env.ram(), _env.rm(), _registry,
+				                  label_from_args(args));
 		}
 
 	public:
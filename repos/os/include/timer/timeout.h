@@ -24,6 +24,7 @@
 #include <base/lock.h>
 #include <base/log.h>
 #include <os/duration.h>
+#include <util/pairing_heap.h>
 
 namespace Genode {
 
@@ -152,9 +153,10 @@ class Genode::Timeout : private Noncopyable
 
 	private:
 
-		class Alarm
+		class Alarm : private Pairing_heap_element<Alarm>
 		{
 			friend class Alarm_timeout_scheduler;
+			friend class Pairing_heap<Alarm>;
 
 			private:
 
@@ -172,7 +174,7 @@ class Genode::Timeout : private Noncopyable
 				Lock                     _dispatch_lock { };
 				Raw                      _raw           { };
 				int                      _active        { 0 };
-				Alarm                   *_next          { nullptr };
+				Alarm                   *_next          { nullptr }; /* in pending list */
 				Alarm_timeout_scheduler *_scheduler     { nullptr };
 
 				void _alarm_assign(Time                     period,
@@ -188,6 +190,10 @@ class Genode::Timeout : private Noncopyable
 
 				void _alarm_reset() { _alarm_assign(0, 0, false, 0), _active = 0, _next = 0; }
 
+				bool earlier(Alarm const &other) const {
+					return _raw.is_pending_at(other._raw.deadline,
+					                          other._raw.deadline_period); }
+
 				bool _on_alarm(unsigned);
 
 				Alarm(Alarm const &);
@@ -238,13 +244,13 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 
 		using Alarm = Timeout::Alarm;
 
-		Time_source     &_time_source;
-		Lock             _lock              { };
-		Alarm           *_active_head       { nullptr };
-		Alarm           *_pending_head      { nullptr };
-		Alarm::Time      _now               { 0UL };
-		bool             _now_period        { false };
-		Alarm::Raw       _min_handle_period { };
+		Time_source         &_time_source;
+		Lock                 _lock              { };
+		Pairing_heap<Alarm>  _active_alarms     { };
+		Alarm               *_pending_head      { nullptr };
+		Alarm::Time          _now               { 0UL };
+		bool                 _now_period        { false };
+		Alarm::Raw           _min_handle_period { };
 
 		void _alarm_unsynchronized_enqueue(Alarm *alarm);
 
@@ -284,7 +290,7 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 
 		bool _alarm_next_deadline(Alarm::Time *deadline);
 
-		bool _alarm_head_timeout(const Alarm * alarm) { return _active_head == alarm; }
+		bool _alarm_head_timeout(const Alarm * alarm) { return _active_alarms.first() == alarm; }
 
 		Alarm_timeout_scheduler(Alarm_timeout_scheduler const &);
 		Alarm_timeout_scheduler &operator = (Alarm_timeout_scheduler const &);
@@ -0,0 +1,108 @@
+/*
+ * \brief  Binary format of trace events
+ * \date   2026-10-18
+ *
+ * Trace-policy modules use this format to record events with a timestamp
+ * instead of a textual description. Each event occupies one entry of the
+ * trace buffer of the traced thread. Hence, the thread is identified by the
+ * trace subject that owns the buffer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TRACE__BINARY_EVENT_H_
+#define _INCLUDE__TRACE__BINARY_EVENT_H_
+
+#include <base/fixed_stdint.h>
+#include <util/string.h>
+
+namespace Genode { namespace Trace { struct Binary_event; } }
+
+
+struct Genode::Trace::Binary_event
+{
+	enum Type {
+		RPC_CALL = 1, RPC_RETURNED, RPC_DISPATCH, RPC_REPLY,
+		SIGNAL_SUBMIT, SIGNAL_RECEIVED, LOCK_CONTENTION };
+
+	enum {
+		/* marker that distinguishes binary events from textual entries */
+		MAGIC = 0xbe,
+
+		OPCODE_UNKNOWN = 0xffff,
+
+		MAX_NAME_LEN = 32
+	};
+
+	struct Header
+	{
+		uint8_t  magic;
+		uint8_t  type;
+		uint16_t opcode;
+		uint32_t value;      /* event-specific value, e.g., signal count */
+		uint64_t timestamp;  /* CPU-local cycle counter */
+
+	} __attribute__((packed));
+
+	Header header;
+
+	char name[MAX_NAME_LEN + 1];
+
+	/**
+	 * Write event to trace-buffer entry 'dst'
+	 *
+	 * \param name  RPC or lock name, truncated to 'MAX_NAME_LEN'
+	 *
+	 * \return size of the entry in bytes
+	 */
+	static size_t generate(char *dst, Type type, uint64_t timestamp,
+	                       unsigned opcode, unsigned value, char const *name)
+	{
+		Header const header { MAGIC, (uint8_t)type, (uint16_t)opcode,
+		                      (uint32_t)value, timestamp };
+
+		size_t name_len = 0;
+		if (name)
+			while (name_len < MAX_NAME_LEN && name[name_len])
+				name_len++;
+
+		memcpy(dst, &header, sizeof(header));
+		memcpy(dst + sizeof(header), name, name_len);
+
+		return sizeof(header) + name_len;
+	}
+
+	/**
+	 * Return largest entry produced by 'generate'
+	 */
+	static constexpr size_t max_size() { return sizeof(Header) + MAX_NAME_LEN; }
+
+	/**
+	 * Parse trace-buffer entry
+	 *
+	 * \return false if the entry does not hold a binary event
+	 */
+	bool parse(char const *data, size_t len)
+	{
+		if (len < sizeof(Header) || len > max_size())
+			return false;
+
+		memcpy(&header, data, sizeof(Header));
+		if (header.magic != MAGIC)
+			return false;
+
+		size_t const name_len = len - sizeof(Header);
+		memcpy(name, data + sizeof(Header), name_len);
+		name[name_len] = 0;
+		return true;
+	}
+
+	Type type() const { return (Type)header.type; }
+};
+
+#endif /* _INCLUDE__TRACE__BINARY_EVENT_H_ */
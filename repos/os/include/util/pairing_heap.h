@@ -0,0 +1,157 @@
+/*
+ * \brief  Intrusive pairing heap
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__PAIRING_HEAP_H_
+#define _INCLUDE__UTIL__PAIRING_HEAP_H_
+
+namespace Genode {
+
+	template <typename> class Pairing_heap_element;
+	template <typename> class Pairing_heap;
+}
+
+
+/**
+ * Link of an element within a 'Pairing_heap'
+ */
+template <typename T>
+class Genode::Pairing_heap_element
+{
+	friend class Pairing_heap<T>;
+
+	private:
+
+		T *_child { nullptr }; /* first child                           */
+		T *_next  { nullptr }; /* next sibling                          */
+		T *_prev  { nullptr }; /* previous sibling or, if first, parent */
+
+		void _unlink() { _child = _next = _prev = nullptr; }
+};
+
+
+/**
+ * Priority queue with constant-time insertion and logarithmic removal
+ *
+ * \param T  element type, must be derived from 'Pairing_heap_element<T>'
+ *           and implement the method 'bool earlier(T const &other) const'
+ *
+ * Insertion and the lookup of the first element take constant time. The
+ * removal of any element, including the first one, takes logarithmic
+ * amortized time. Elements are linked into the heap without allocation.
+ * The heap is not synchronized.
+ */
+template <typename T>
+class Genode::Pairing_heap
+{
+	private:
+
+		typedef Pairing_heap_element<T> Element;
+
+		T *_first { nullptr };
+
+		static Element &_e(T *t) { return *static_cast<Element *>(t); }
+
+		/**
+		 * Link two trees, the first element of each has no siblings
+		 */
+		static T *_meld(T *a, T *b)
+		{
+			if (!a) return b;
+			if (!b) return a;
+
+			if (b->earlier(*a)) {
+				T * const tmp = a; a = b; b = tmp; }
+
+			_e(b)._prev = a;
+			_e(b)._next = _e(a)._child;
+			if (_e(a)._child)
+				_e(_e(a)._child)._prev = b;
+
+			_e(a)._child = b;
+			return a;
+		}
+
+		/**
+		 * Combine list of sibling trees into one tree (two-pass pairing)
+		 */
+		static T *_merge_siblings(T *first)
+		{
+			/* meld pairs from left to right, collect them in reverse order */
+			T *pairs = nullptr;
+			while (first) {
+				T * const a = first;
+				T * const b = _e(a)._next;
+				first = b ? _e(b)._next : nullptr;
+
+				_e(a)._next = _e(a)._prev = nullptr;
+				if (b)
+					_e(b)._next = _e(b)._prev = nullptr;
+
+				T * const pair = _meld(a, b);
+				_e(pair)._next = pairs;
+				pairs = pair;
+			}
+
+			/* meld the pairs from right to left */
+			T *result = nullptr;
+			while (pairs) {
+				T * const pair = pairs;
+				pairs = _e(pair)._next;
+				_e(pair)._next = nullptr;
+				result = _meld(result, pair);
+			}
+			return result;
+		}
+
+	public:
+
+		/**
+		 * Return earliest element, or 0 if the heap is empty
+		 */
+		T *first() const { return _first; }
+
+		void insert(T *t)
+		{
+			_e(t)._unlink();
+			_first = _meld(_first, t);
+		}
+
+		/**
+		 * Remove element from heap
+		 *
+		 * The element must be part of the heap.
+		 */
+		void remove(T *t)
+		{
+			Element &e = _e(t);
+
+			if (t == _first) {
+				_first = _merge_siblings(e._child);
+				e._unlink();
+				return;
+			}
+
+			/* cut subtree of the element from its parent or sibling */
+			if (_e(e._prev)._child == t)
+				_e(e._prev)._child = e._next;
+			else
+				_e(e._prev)._next = e._next;
+
+			if (e._next)
+				_e(e._next)._prev = e._prev;
+
+			_first = _meld(_first, _merge_siblings(e._child));
+			e._unlink();
+		}
+};
+
+#endif /* _INCLUDE__UTIL__PAIRING_HEAP_H_ */
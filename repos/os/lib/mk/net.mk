@@ -1,4 +1,4 @@
 SRC_CC += ethernet.cc ipv4.cc dhcp.cc arp.cc udp.cc tcp.cc mac_address.cc
-SRC_CC += icmp.cc
+SRC_CC += icmp.cc internet_checksum.cc
 
 vpath %.cc $(REP_DIR)/src/lib/net
@@ -1,5 +1,10 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc blend.cc
 REQUIRES = arm 32bit
-INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm
+INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+# the kernels pass vectors only to inlined functions, not across an ABI boundary
+CC_OPT_blend += -Wno-psabi
+
+vpath blit.cc  $(REP_DIR)/src/lib/blit
+vpath blend.cc $(REP_DIR)/src/lib/blit
@@ -1,6 +1,14 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc blend.cc blend_avx2.cc
 REQUIRES = x86 32bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_32 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+           $(REP_DIR)/src/lib/blit/spec/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+CC_OPT_blend_avx2 += -mavx2
+
+# the kernels pass vectors only to inlined functions, not across an ABI boundary
+CC_OPT_blend += -Wno-psabi
+
+vpath blit.cc       $(REP_DIR)/src/lib/blit
+vpath blend.cc      $(REP_DIR)/src/lib/blit
+vpath blend_avx2.cc $(REP_DIR)/src/lib/blit/spec/x86
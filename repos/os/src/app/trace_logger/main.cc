@@ -20,6 +20,7 @@
 #include <base/component.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/heap.h>
+#include <os/reporter.h>
 #include <os/session_policy.h>
 #include <timer_session/connection.h>
 #include <util/construct_at.h>
@@ -38,6 +39,7 @@ class Main
 		enum { DEFAULT_SESSION_ARG_BUFFER    = 1024 * 4 };
 		enum { DEFAULT_SESSION_RAM           = 1024 * 1024 };
 		enum { DEFAULT_SESSION_PARENT_LEVELS = 0 };
+		enum { DEFAULT_REPORT_BUFFER         = 1024 * 16 };
 
 		Env                           &_env;
 		Timer::Connection              _timer               { _env };
@@ -50,6 +52,9 @@ class Main
 		bool                    const  _affinity            { _config.attribute_value("affinity", false) };
 		bool                    const  _activity            { _config.attribute_value("activity", false) };
 		bool                    const  _verbose             { _config.attribute_value("verbose",  false) };
+		bool                    const  _rpc_latency         { _config.attribute_value("rpc_latency", false) };
+		Number_of_bytes         const  _report_buf_sz       { _config.attribute_value("report_buffer", Number_of_bytes(DEFAULT_REPORT_BUFFER)) };
+		Reporter                       _latency_reporter    { _env, "rpc_latency", "rpc_latency", _report_buf_sz };
 		Microseconds            const  _period_us           { read_sec_attr(_config, "period_sec", DEFAULT_PERIOD_SEC) };
 		Number_of_bytes         const  _default_buf_sz      { _config.attribute_value("default_buffer", Number_of_bytes(DEFAULT_BUFFER)) };
 		Timer::Periodic_timeout<Main>  _period              { _timer, *this, &Main::_handle_period, _period_us };
@@ -130,6 +135,20 @@ class Main
 			new_monitors.for_each([&] (Monitor &monitor) {
 				monitor.print(_activity, _affinity);
 			});
+
+			if (_rpc_latency)
+				_report_rpc_latency(new_monitors);
+		}
+
+		void _report_rpc_latency(Monitor_tree &monitors)
+		{
+			try {
+				Reporter::Xml_generator xml(_latency_reporter, [&] () {
+					monitors.for_each([&] (Monitor &monitor) {
+						monitor.report_rpc_latency(xml); }); });
+			}
+			catch (Xml_generator::Buffer_exceeded) {
+				warning("Cannot report RPC latency: report_buffer exceeded"); }
 		}
 
 		void _destroy_monitor(Monitor_tree &monitors, Monitor &monitor)
@@ -158,7 +177,7 @@ class Main
 					_policies.insert(policy);
 					_trace.trace(id.id, policy.id(), buffer_sz);
 				}
-				monitors.insert(new (_heap) Monitor(_trace, _env.rm(), id));
+				monitors.insert(new (_heap) Monitor(_trace, _env.rm(), _heap, id));
 			}
 			catch (Out_of_ram                    ) { warning("Cannot activate tracing: Out_of_ram"             ); return; }
 			catch (Out_of_caps                   ) { warning("Cannot activate tracing: Out_of_caps"            ); return; }
@@ -189,7 +208,11 @@ class Main
 
 	public:
 
-		Main(Env &env) : _env(env) { _policies.insert(_default_policy); }
+		Main(Env &env) : _env(env)
+		{
+			_policies.insert(_default_policy);
+			_latency_reporter.enabled(_rpc_latency);
+		}
 };
 
 
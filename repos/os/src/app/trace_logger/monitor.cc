@@ -60,10 +60,11 @@ Monitor &Monitor::find_by_subject_id(Trace::Subject_id const subject_id)
 
 Monitor::Monitor(Trace::Connection &trace,
                  Region_map        &rm,
+                 Allocator         &alloc,
                  Trace::Subject_id  subject_id)
 :
 	Monitor_base(trace, rm, subject_id),
-	_subject_id(subject_id), _buffer(_buffer_raw)
+	_subject_id(subject_id), _buffer(_buffer_raw), _rpc_latency(alloc)
 {
 	_update_info();
 }
@@ -120,6 +121,13 @@ void Monitor::print(bool activity, bool affinity)
 		if (!length)
 			return;
 
+		/* account binary events instead of printing them */
+		Trace::Binary_event event;
+		if (event.parse(entry.data(), entry.length())) {
+			_rpc_latency.add(event);
+			return;
+		}
+
 		/* copy entry data from buffer and add terminating '0' */
 		memcpy(_curr_entry_data, entry.data(), length);
 		_curr_entry_data[length] = '\0';
@@ -140,6 +148,20 @@ void Monitor::print(bool activity, bool affinity)
 }
 
 
+void Monitor::report_rpc_latency(Xml_generator &xml) const
+{
+	if (_rpc_latency.empty())
+		return;
+
+	xml.node("subject", [&] () {
+		xml.attribute("label",  _info.session_label());
+		xml.attribute("thread", _info.thread_name());
+		xml.attribute("id",     _subject_id.id);
+		_rpc_latency.generate(xml);
+	});
+}
+
+
 /******************
  ** Monitor_tree **
  ******************/
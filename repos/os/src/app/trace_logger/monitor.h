@@ -16,6 +16,7 @@
 
 /* local includes */
 #include <avl_tree.h>
+#include <rpc_latency.h>
 #include <trace_buffer.h>
 
 /* Genode includes */
@@ -59,6 +60,7 @@ class Monitor : public Monitor_base,
 		Genode::Trace::Subject_info      _info             { };
 		unsigned long long               _recent_exec_time { 0 };
 		char                             _curr_entry_data[MAX_ENTRY_LENGTH];
+		Rpc_latency                      _rpc_latency;
 
 		void _update_info();
 
@@ -66,10 +68,22 @@ class Monitor : public Monitor_base,
 
 		Monitor(Genode::Trace::Connection &trace,
 		        Genode::Region_map        &rm,
+		        Genode::Allocator         &alloc,
 		        Genode::Trace::Subject_id  subject_id);
 
+		/**
+		 * Print subject information and new textual buffer entries
+		 *
+		 * Binary events are not printed but accounted in the RPC-latency
+		 * statistics.
+		 */
 		void print(bool activity, bool affinity);
 
+		/**
+		 * Generate 'subject' node with the RPC-latency statistics
+		 */
+		void report_rpc_latency(Genode::Xml_generator &xml) const;
+
 
 		/**************
 		 ** Avl_node **
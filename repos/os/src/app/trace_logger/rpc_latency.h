@@ -0,0 +1,246 @@
+/*
+ * \brief  Latency statistics of the RPCs of a trace subject
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _RPC_LATENCY_H_
+#define _RPC_LATENCY_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <trace/binary_event.h>
+#include <util/list.h>
+#include <util/xml_generator.h>
+
+
+/**
+ * Histogram of latency values with logarithmic buckets
+ *
+ * Each power of two is divided into 'SUB_BUCKETS' linear buckets. So the
+ * reported percentiles deviate by less than 1/'SUB_BUCKETS' from the exact
+ * values. The maximum is exact.
+ */
+class Latency_histogram
+{
+	private:
+
+		enum { SUB_BUCKETS_LOG2 = 2,
+		       SUB_BUCKETS      = 1 << SUB_BUCKETS_LOG2,
+		       NUM_BUCKETS      = 64*SUB_BUCKETS };
+
+		typedef Genode::uint64_t uint64_t;
+
+		unsigned long _buckets[NUM_BUCKETS] { };
+		unsigned long _count = 0;
+		uint64_t      _max   = 0;
+
+		static unsigned _msb(uint64_t v)
+		{
+			return 63 - __builtin_clzll(v);
+		}
+
+		static unsigned _bucket(uint64_t v)
+		{
+			if (v < SUB_BUCKETS)
+				return (unsigned)v;
+
+			unsigned const msb = _msb(v);
+			unsigned const sub = (unsigned)(v >> (msb - SUB_BUCKETS_LOG2))
+			                   & (SUB_BUCKETS - 1);
+
+			return (msb - SUB_BUCKETS_LOG2 + 1)*SUB_BUCKETS + sub;
+		}
+
+		/**
+		 * Return upper bound of the values of 'bucket'
+		 */
+		static uint64_t _upper_bound(unsigned bucket)
+		{
+			if (bucket < SUB_BUCKETS)
+				return bucket;
+
+			unsigned const shift = bucket/SUB_BUCKETS - 1;
+			uint64_t const base  = SUB_BUCKETS + bucket % SUB_BUCKETS;
+
+			return ((base + 1) << shift) - 1;
+		}
+
+	public:
+
+		void add(uint64_t value)
+		{
+			_buckets[_bucket(value)]++;
+			_count++;
+			_max = Genode::max(_max, value);
+		}
+
+		unsigned long count() const { return _count; }
+		uint64_t      max()   const { return _max; }
+
+		/**
+		 * Return value below which 'percent' percent of the values lie
+		 */
+		uint64_t percentile(unsigned percent) const
+		{
+			unsigned long const rank = (_count*percent + 99)/100;
+
+			unsigned long sum = 0;
+			for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+				sum += _buckets[i];
+				if (sum >= rank && sum)
+					return Genode::min(_upper_bound(i), _max);
+			}
+			return _max;
+		}
+};
+
+
+/**
+ * Latency statistics of the RPCs of one trace subject
+ *
+ * The statistics are gathered from the binary events of the 'rpc_latency'
+ * trace policy. RPCs are synchronous. So the duration of an RPC issued by
+ * the subject is the time between the call and the return event. The time
+ * the subject needs to serve an RPC is the time between the dispatch and
+ * the reply event.
+ */
+class Rpc_latency
+{
+	public:
+
+		enum Kind { CALL, SERVE };
+
+	private:
+
+		typedef Genode::Trace::Binary_event Event;
+		typedef Genode::String<Event::MAX_NAME_LEN + 1> Name;
+
+		struct Rpc : Genode::List<Rpc>::Element
+		{
+			Name const name;
+			Kind const kind;
+
+			Latency_histogram histogram { };
+
+			Rpc(Name const &name, Kind kind) : name(name), kind(kind) { }
+		};
+
+		/**
+		 * RPC that was started but did not finish yet
+		 */
+		struct Pending
+		{
+			bool             valid = false;
+			Name             name  { };
+			Genode::uint64_t start = 0;
+
+			void begin(Event const &e)
+			{
+				valid = true;
+				name  = Name(e.name);
+				start = e.header.timestamp;
+			}
+
+			/**
+			 * Call 'fn' with the duration of the finished RPC
+			 *
+			 * Ending events without matching start, e.g., because the
+			 * start event was overwritten in the trace buffer, are ignored.
+			 */
+			template <typename FN>
+			void end(Event const &e, FN const &fn)
+			{
+				if (valid && name == e.name && e.header.timestamp >= start)
+					fn(e.header.timestamp - start);
+
+				valid = false;
+			}
+		};
+
+		Genode::Allocator &_alloc;
+
+		Genode::List<Rpc> _rpcs { };
+
+		Pending _call { }, _dispatch { };
+
+		Rpc &_rpc(char const *name, Kind kind)
+		{
+			for (Rpc *rpc = _rpcs.first(); rpc; rpc = rpc->next())
+				if (rpc->kind == kind && rpc->name == name)
+					return *rpc;
+
+			Rpc &rpc = *new (_alloc) Rpc(Name(name), kind);
+			_rpcs.insert(&rpc);
+			return rpc;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Rpc_latency(Rpc_latency const &);
+		Rpc_latency &operator = (Rpc_latency const &);
+
+	public:
+
+		Rpc_latency(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Rpc_latency()
+		{
+			while (Rpc *rpc = _rpcs.first()) {
+				_rpcs.remove(rpc);
+				Genode::destroy(_alloc, rpc);
+			}
+		}
+
+		/**
+		 * Account binary trace event
+		 */
+		void add(Event const &e)
+		{
+			switch (e.type()) {
+			case Event::RPC_CALL:     _call.begin(e);     break;
+			case Event::RPC_DISPATCH: _dispatch.begin(e); break;
+
+			case Event::RPC_RETURNED:
+				_call.end(e, [&] (Genode::uint64_t duration) {
+					_rpc(e.name, CALL).histogram.add(duration); });
+				break;
+
+			case Event::RPC_REPLY:
+				_dispatch.end(e, [&] (Genode::uint64_t duration) {
+					_rpc(e.name, SERVE).histogram.add(duration); });
+				break;
+
+			default: break;
+			}
+		}
+
+		bool empty() const { return _rpcs.first() == nullptr; }
+
+		/**
+		 * Generate one 'rpc' node per RPC
+		 */
+		void generate(Genode::Xml_generator &xml) const
+		{
+			for (Rpc const *rpc = _rpcs.first(); rpc; rpc = rpc->next()) {
+				xml.node("rpc", [&] () {
+					Latency_histogram const &h = rpc->histogram;
+					xml.attribute("name",  rpc->name);
+					xml.attribute("kind",  rpc->kind == CALL ? "call" : "serve");
+					xml.attribute("count", h.count());
+					xml.attribute("p50",   h.percentile(50));
+					xml.attribute("p99",   h.percentile(99));
+					xml.attribute("max",   h.max());
+				});
+			}
+		}
+};
+
+#endif /* _RPC_LATENCY_H_ */
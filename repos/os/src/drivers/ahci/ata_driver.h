@@ -186,8 +186,8 @@ struct Ata_driver : Port_driver
 	Genode::Constructible<Serial_string> serial { };
 	Genode::Constructible<Model_string>  model  { };
 
-	Io_command               *io_cmd = nullptr;
-	Block::Packet_descriptor  pending[32];
+	Io_command                *io_cmd = nullptr;
+	Block::Request_table<32>   pending { };
 
 	Signal_context_capability device_identified;
 
@@ -213,27 +213,18 @@ struct Ata_driver : Port_driver
 			destroy(&alloc, io_cmd);
 	}
 
-	unsigned find_free_cmd_slot()
-	{
-		for (unsigned slot = 0; slot < cmd_slots; slot++)
-			if (!pending[slot].size())
-				return slot;
-
-		throw Block::Driver::Request_congestion();
-	}
-
 	void ack_packets()
 	{
 		unsigned slots =  Port::read<Ci>() | Port::read<Sact>();
 
-		for (unsigned slot = 0; slot < cmd_slots; slot++) {
-			if ((slots & (1U << slot)) || !pending[slot].size())
-				continue;
+		/* with ncq, commands may complete in any order */
+		pending.for_each_pending([&] (unsigned slot, Block::Packet_descriptor const &) {
+			if (slots & (1U << slot))
+				return;
 
-			Block::Packet_descriptor p = pending[slot];
-			pending[slot] = Block::Packet_descriptor();
+			Block::Packet_descriptor p = pending.release(slot);
 			ack_packet(p, true);
-		}
+		});
 	}
 
 	void overlap_check(Block::sector_t block_number,
@@ -241,12 +232,10 @@ struct Ata_driver : Port_driver
 	{
 		Block::sector_t end = block_number + count - 1;
 
-		for (unsigned slot = 0; slot < cmd_slots; slot++) {
-			if (!pending[slot].size())
-				continue;
+		pending.for_each_pending([&] (unsigned, Block::Packet_descriptor const &p) {
 
-			Block::sector_t pending_start = pending[slot].block_number();
-			Block::sector_t pending_end   = pending_start + pending[slot].block_count() - 1;
+			Block::sector_t pending_start = p.block_number();
+			Block::sector_t pending_end   = pending_start + p.block_count() - 1;
 			/* check if a pending packet overlaps */
 			if ((block_number >= pending_start && block_number <= pending_end) ||
 			    (end          >= pending_start && end          <= pending_end) ||
@@ -254,12 +243,12 @@ struct Ata_driver : Port_driver
 			    (pending_end   >= block_number && pending_end   <= end)) {
 
 				Genode::warning("overlap: "
-				                "pending ", pending[slot].block_number(),
-				                " + ", pending[slot].block_count(), ", "
+				                "pending ", p.block_number(),
+				                " + ", p.block_count(), ", "
 				                "request: ", block_number, " + ", count);
 				throw Block::Driver::Request_congestion();
 			}
-		}
+		});
 	}
 
 	void io(bool                      read,
@@ -271,8 +260,7 @@ struct Ata_driver : Port_driver
 		sanity_check(block_number, count);
 		overlap_check(block_number, count);
 
-		unsigned slot = find_free_cmd_slot();
-		pending[slot] = packet;
+		unsigned slot = pending.alloc(packet);
 
 		/* setup fis */
 		Command_table table(command_table_addr(slot), phys, count * block_size());
@@ -352,6 +340,8 @@ struct Ata_driver : Port_driver
 		if (!ncq_support())
 			cmd_slots = 1;
 
+		pending.depth(cmd_slots);
+
 		state = READY;
 		state_change();
 	}
@@ -373,6 +363,8 @@ struct Ata_driver : Port_driver
 
 	bool dma_enabled() { return true; };
 
+	unsigned queue_depth() override { return pending.depth(); }
+
 	Block::Session::Operations ops() override
 	{
 		Block::Session::Operations o;
@@ -165,6 +165,8 @@ struct Atapi_driver : Port_driver
 
 	bool dma_enabled() { return true; };
 
+	unsigned queue_depth() override { return 1; }
+
 	Block::Session::Operations ops() override
 	{
 		Block::Session::Operations o;
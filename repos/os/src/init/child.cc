@@ -16,7 +16,7 @@
 
 
 Init::Child::Apply_config_result
-Init::Child::apply_config(Xml_node start_node)
+Init::Child::apply_config(Xml_node start_node, bool routes_changed)
 {
 	if (_state == STATE_ABANDONED)
 		return NO_SIDE_EFFECTS;
@@ -37,10 +37,13 @@ Init::Child::apply_config(Xml_node start_node)
 
 	Config_update config_update = CONFIG_UNCHANGED;
 
+	bool const start_node_changed =
+		start_node.size() != _start_node->xml().size() ||
+		Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
+		               start_node.size()) != 0;
+
 	/* import new start node if new version differs */
-	if (start_node.size() != _start_node->xml().size() ||
-	    Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
-	                   start_node.size()) != 0)
+	if (start_node_changed)
 	{
 		/*
 		 * Check for a change of the version attribute, force restart
@@ -119,7 +122,9 @@ Init::Child::apply_config(Xml_node start_node)
 		_binary_name = _binary_from_xml(start_node, _unique_name);
 
 		/* import new start node */
+		_route_model.destruct();
 		_start_node.construct(_alloc, start_node);
+		_update_route_model();
 	}
 
 	/*
@@ -136,7 +141,7 @@ Init::Child::apply_config(Xml_node start_node)
 	}
 
 	/* validate that the routes of all existing sessions remain intact */
-	{
+	if (start_node_changed || routes_changed) {
 		bool routing_changed = false;
 		_child.for_each_session([&] (Session_state const &session) {
 			if (!_route_valid(session))
@@ -435,89 +440,90 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 		return Route { _session_requester.service(),
 		               Session::Label(), Session::Diag{false} };
 
-	try {
-		Xml_node route_node = _default_route_accessor.default_route();
-		try {
-			route_node = _start_node->xml().sub_node("route"); }
-		catch (...) { }
-		Xml_node service_node = route_node.sub_node();
+	Route_model const &route_model = _route_model.constructed()
+	                               ? *_route_model
+	                               : _default_route_accessor.default_route();
 
-		for (; ; service_node = service_node.next()) {
+	Child_policy::Name const child_name = name();
 
-			bool service_wildcard = service_node.has_type("any-service");
+	Route_model::Query const query { child_name, service_name, label };
 
-			if (!service_node_matches(service_node, label, name(), service_name))
-				continue;
+	Route_model::Candidates const candidates = route_model.candidates(service_name);
 
-			Xml_node target = service_node.sub_node();
-			for (; ; target = target.next()) {
+	for (unsigned i = 0; i < candidates.count; i++) {
 
-				/*
-				 * Determine session label to be provided to the server
-				 *
-				 * By default, the client's identity (accompanied with the a
-				 * client-provided label) is presented as session label to the
-				 * server. However, the target node can explicitly override the
-				 * client's identity by a custom label via the 'label'
-				 * attribute.
-				 */
-				typedef String<Session_label::capacity()> Label;
-				Label const target_label =
-					target.attribute_value("label", Label(label.string()));
+		Route_model::Rule const &rule = *candidates.rules[i];
 
-				Session::Diag const
-					target_diag { target.attribute_value("diag", false) };
+		if (!rule.matches(query))
+			continue;
 
-				auto no_filter = [] (Service &) -> bool { return false; };
+		/* a matching service node without targets terminates the lookup */
+		if (!rule.num_targets())
+			break;
 
-				if (target.has_type("parent")) {
+		for (unsigned j = 0; j < rule.num_targets(); j++) {
 
-					try {
-						return Route { find_service(_parent_services, service_name, no_filter),
-						               target_label, target_diag };
-					} catch (Service_denied) { }
-				}
+			Route_model::Target const &target = rule.target(j);
 
-				if (target.has_type("child")) {
+			/*
+			 * Determine session label to be provided to the server
+			 *
+			 * By default, the client's identity (accompanied with the a
+			 * client-provided label) is presented as session label to the
+			 * server. However, the target node can explicitly override the
+			 * client's identity by a custom label via the 'label'
+			 * attribute.
+			 */
+			Session_label const target_label =
+				target.label.present() ? target.label.string<Session_label>()
+				                       : label;
 
-					typedef Name_registry::Name Name;
-					Name server_name = target.attribute_value("name", Name());
-					server_name = _name_registry.deref_alias(server_name);
+			auto no_filter = [] (Service &) -> bool { return false; };
 
-					auto filter_server_name = [&] (Routed_service &s) -> bool {
-						return s.child_name() != server_name; };
+			if (target.type == Route_model::Target::PARENT) {
 
-					try {
-						return Route { find_service(_child_services, service_name, filter_server_name),
-						               target_label, target_diag };
+				try {
+					return Route { find_service(_parent_services, service_name, no_filter),
+					               target_label, target.diag };
+				} catch (Service_denied) { }
+			}
 
-					} catch (Service_denied) { }
-				}
+			if (target.type == Route_model::Target::CHILD) {
 
-				if (target.has_type("any-child")) {
+				typedef Name_registry::Name Name;
+				Name const server_name =
+					_name_registry.deref_alias(target.name.string<Name>());
 
-					if (is_ambiguous(_child_services, service_name)) {
-						error(name(), ": ambiguous routes to "
-						      "service \"", service_name, "\"");
-						throw Service_denied();
-					}
-					try {
-						return Route { find_service(_child_services, service_name, no_filter),
-						               target_label, target_diag };
+				auto filter_server_name = [&] (Routed_service &s) -> bool {
+					return s.child_name() != server_name; };
 
-					} catch (Service_denied) { }
-				}
+				try {
+					return Route { find_service(_child_services, service_name, filter_server_name),
+					               target_label, target.diag };
 
-				if (!service_wildcard) {
-					warning(name(), ": lookup for service \"", service_name, "\" failed");
+				} catch (Service_denied) { }
+			}
+
+			if (target.type == Route_model::Target::ANY_CHILD) {
+
+				if (is_ambiguous(_child_services, service_name)) {
+					error(name(), ": ambiguous routes to "
+					      "service \"", service_name, "\"");
 					throw Service_denied();
 				}
+				try {
+					return Route { find_service(_child_services, service_name, no_filter),
+					               target_label, target.diag };
+
+				} catch (Service_denied) { }
+			}
 
-				if (target.last())
-					break;
+			if (!rule.any_service()) {
+				warning(name(), ": lookup for service \"", service_name, "\" failed");
+				throw Service_denied();
 			}
 		}
-	} catch (Xml_node::Nonexistent_sub_node) { }
+	}
 
 	warning(name(), ": no route to service \"", service_name, "\"");
 	throw Service_denied();
@@ -684,6 +690,8 @@ Init::Child::Child(Env                      &env,
 	 */
 	if (start_node.has_sub_node("config"))
 		_config_rom_service.construct(*this);
+
+	_update_route_model();
 }
 
 
@@ -28,6 +28,7 @@
 #include <name_registry.h>
 #include <service.h>
 #include <utils.h>
+#include <route_model.h>
 
 namespace Init { class Child; }
 
@@ -46,7 +47,7 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		 */
 		struct Id { unsigned value; };
 
-		struct Default_route_accessor : Interface { virtual Xml_node default_route() = 0; };
+		struct Default_route_accessor : Interface { virtual Route_model const &default_route() = 0; };
 		struct Default_caps_accessor  : Interface { virtual Cap_quota default_caps() = 0; };
 		struct Ram_limit_accessor     : Interface { virtual Ram_quota ram_limit()    = 0; };
 
@@ -73,6 +74,20 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Reconstructible<Buffered_xml> _start_node;
 
+		/*
+		 * Rules of the '<route>' node, refers to the buffered start node
+		 */
+		Constructible<Route_model> _route_model { };
+
+		void _update_route_model()
+		{
+			_route_model.destruct();
+
+			Xml_node const start_node = _start_node->xml();
+			if (start_node.has_sub_node("route"))
+				_route_model.construct(_alloc, start_node.sub_node("route"));
+		}
+
 		/*
 		 * Version attribute of the start node, used to force child restarts.
 		 */
@@ -103,6 +118,19 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		typedef String<64> Name;
 		Name const _unique_name { _name_from_xml(_start_node->xml()) };
 
+		/*
+		 * Node of the name index of the child registry
+		 */
+		struct Name_node : Avl_string_base
+		{
+			Child &child;
+
+			Name_node(Child &child)
+			: Avl_string_base(child._unique_name.string()), child(child) { }
+		};
+
+		Name_node _name_node { *this };
+
 		static Binary_name _binary_from_xml(Xml_node start_node,
 		                                    Name const &unique_name)
 		{
@@ -498,10 +526,18 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		/**
 		 * Apply new configuration to child
 		 *
+		 * \param routes_changed  true if the routes of the child's sessions
+		 *                        may have changed independent of its start
+		 *                        node, e.g., by a changed default route or
+		 *                        by services that appeared or vanished
+		 *
+		 * The routes of the child's sessions are validated only if the start
+		 * node or the routes changed.
+		 *
 		 * \throw Allocator::Out_of_memory  unable to allocate buffer for new
 		 *                                  config
 		 */
-		Apply_config_result apply_config(Xml_node start_node);
+		Apply_config_result apply_config(Xml_node start_node, bool routes_changed);
 
 		void apply_ram_upgrade();
 		void apply_ram_downgrade();
@@ -29,6 +29,9 @@ class Init::Child_registry : public Name_registry, Child_list
 
 		List<Alias> _aliases { };
 
+		/* index of the children by name */
+		Avl_tree<Avl_string_base> _names { };
+
 		bool _unique(const char *name) const
 		{
 			/* check for name clash with an existing child */
@@ -59,6 +62,7 @@ class Init::Child_registry : public Name_registry, Child_list
 		void insert(Child *child)
 		{
 			Child_list::insert(&child->_list_element);
+			_names.insert(&child->_name_node);
 		}
 
 		/**
@@ -67,6 +71,20 @@ class Init::Child_registry : public Name_registry, Child_list
 		void remove(Child *child)
 		{
 			Child_list::remove(&child->_list_element);
+			_names.remove(&child->_name_node);
+		}
+
+		/**
+		 * Call 'fn' with the child of the specified name, if present
+		 */
+		template <typename FN>
+		void with_child(Child_policy::Name const &name, FN const &fn)
+		{
+			Avl_string_base * const first = _names.first();
+			Avl_string_base * const node  = first ? first->find_by_name(name.string())
+			                                      : nullptr;
+			if (node)
+				fn(static_cast<Child::Name_node *>(node)->child);
 		}
 
 		/**
@@ -44,6 +44,19 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	Constructible<Buffered_xml> _default_route { };
 
+	/* rules of '_default_route', refers to the buffered XML */
+	Constructible<Route_model> _default_route_model { };
+
+	Route_model const _empty_route_model { _heap, Xml_node("<empty/>") };
+
+	/*
+	 * Set if the routes of existing sessions may have changed independent of
+	 * the start nodes, e.g., by a changed default route, changed parent
+	 * services, or by newly started children. Otherwise, only children with
+	 * a changed start node have to validate their routes.
+	 */
+	bool _routes_changed = true;
+
 	Cap_quota _default_caps { 0 };
 
 	unsigned _child_cnt = 0;
@@ -122,10 +135,10 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	/**
 	 * Default_route_accessor interface
 	 */
-	Xml_node default_route() override
+	Route_model const &default_route() override
 	{
-		return _default_route.constructed() ? _default_route->xml()
-		                                    : Xml_node("<empty/>");
+		return _default_route_model.constructed() ? *_default_route_model
+		                                          : _empty_route_model;
 	}
 
 	/**
@@ -138,6 +151,7 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	Signal_handler<Main> _resource_avail_handler {
 		_env.ep(), *this, &Main::_handle_resource_avail };
 
+	void _update_default_route_from_config();
 	void _update_aliases_from_config();
 	void _update_parent_services_from_config();
 	void _abandon_obsolete_children();
@@ -178,8 +192,10 @@ void Init::Main::_update_parent_services_from_config()
 			if (name == service.attribute_value("name", Service::Name())) {
 				obsolete = false; }});
 
-		if (obsolete)
+		if (obsolete) {
 			service.abandon();
+			_routes_changed = true;
+		}
 	});
 
 	/* used to prepend the list of new parent services with title */
@@ -197,6 +213,7 @@ void Init::Main::_update_parent_services_from_config()
 
 		if (!registered) {
 			new (_heap) Init::Parent_service(_parent_services, _env, name);
+			_routes_changed = true;
 			if (_verbose->enabled()) {
 				if (first_log)
 					log("parent provides");
@@ -218,6 +235,24 @@ void Init::Main::_destroy_abandoned_parent_services()
 
 void Init::Main::_update_aliases_from_config()
 {
+	/* aliases affect the routes to children */
+	unsigned aliases = 0;
+	_config_xml.for_each_sub_node("alias", [&] (Xml_node alias_node) {
+
+		aliases++;
+
+		Alias::Name const name = alias_node.attribute_value("name", Alias::Name());
+
+		if (_children.deref_alias(name) != alias_node.attribute_value("child", Alias::Child()))
+			_routes_changed = true;
+	});
+
+	for (Alias *alias = _children.any_alias(); alias; alias = alias->next())
+		aliases--;
+
+	if (aliases)
+		_routes_changed = true;
+
 	/* remove all known aliases */
 	while (_children.any_alias()) {
 		Init::Alias *alias = _children.any_alias();
@@ -249,8 +284,10 @@ void Init::Main::_abandon_obsolete_children()
 			if (node.attribute_value("name", Child_policy::Name()) == name)
 				obsolete = false; });
 
-		if (obsolete)
+		if (obsolete) {
 			child.abandon();
+			_routes_changed = true;
+		}
 	});
 }
 
@@ -272,19 +309,45 @@ void Init::Main::_update_children_config()
 			Child_policy::Name const start_node_name =
 				node.attribute_value("name", Child_policy::Name());
 
-			_children.for_each_child([&] (Child &child) {
-				if (child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
-					case Child::NO_SIDE_EFFECTS: break;
-					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
-					};
-				}
+			_children.with_child(start_node_name, [&] (Child &child) {
+				switch (child.apply_config(node, _routes_changed)) {
+				case Child::NO_SIDE_EFFECTS: break;
+				case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
+				};
 			});
 		});
 
 		if (!side_effects)
 			break;
+
+		/* the side effects may affect the routes of any child */
+		_routes_changed = true;
+	}
+
+	_routes_changed = false;
+}
+
+
+void Init::Main::_update_default_route_from_config()
+{
+	if (!_config_xml.has_sub_node("default-route"))
+		return;
+
+	Xml_node const node = _config_xml.sub_node("default-route");
+
+	if (_default_route.constructed()) {
+		Xml_node const old_node = _default_route->xml();
+
+		if (node.size() == old_node.size()
+		 && !memcmp(node.addr(), old_node.addr(), node.size()))
+			return;
 	}
+
+	_default_route_model.destruct();
+	_default_route.construct(_heap, node);
+	_default_route_model.construct(_heap, _default_route->xml());
+
+	_routes_changed = true;
 }
 
 
@@ -299,7 +362,7 @@ void Init::Main::_handle_config()
 
 	/* determine default route for resolving service requests */
 	try {
-		_default_route.construct(_heap, _config_xml.sub_node("default-route")); }
+		_update_default_route_from_config(); }
 	catch (...) { }
 
 	_default_caps = Cap_quota { 0 };
@@ -340,9 +403,8 @@ void Init::Main::_handle_config()
 
 			/* skip start node if corresponding child already exists */
 			bool exists = false;
-			_children.for_each_child([&] (Child const &child) {
-				if (child.name() == start_node.attribute_value("name", Child_policy::Name()))
-					exists = true; });
+			_children.with_child(start_node.attribute_value("name", Child_policy::Name()),
+			                     [&] (Child const &) { exists = true; });
 			if (exists) {
 				return;
 			}
@@ -368,6 +430,9 @@ void Init::Main::_handle_config()
 					            _parent_services, _child_services);
 				_children.insert(&child);
 
+				/* the new child's services may change the routes of others */
+				_routes_changed = true;
+
 				/* account for the start XML node buffered in the child */
 				size_t const metadata_overhead = start_node.size()
 				                               + sizeof(Init::Child);
@@ -0,0 +1,372 @@
+/*
+ * \brief  Compiled routing rules
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__ROUTE_MODEL_H_
+#define _SRC__INIT__ROUTE_MODEL_H_
+
+/* Genode includes */
+#include <util/avl_string.h>
+#include <util/xml_node.h>
+#include <base/allocator.h>
+#include <base/child.h>
+#include <base/log.h>
+
+/* local includes */
+#include <types.h>
+
+namespace Init { class Route_model; }
+
+
+/**
+ * Rules of a '<route>' or '<default-route>' node
+ *
+ * The rules are compiled when the node is loaded. For each service name, the
+ * model keeps the list of rules that may apply, in the order of their
+ * appearance. So a session request evaluates the label conditions of these
+ * rules only, without parsing XML.
+ *
+ * The model refers to attribute values within the buffer of the XML node,
+ * which must outlive the model.
+ */
+class Init::Route_model : Noncopyable
+{
+	public:
+
+		/**
+		 * Attribute value within the XML buffer
+		 */
+		class Value
+		{
+			private:
+
+				char const *_base = nullptr;
+				size_t      _len  = 0;
+
+			public:
+
+				Value() { }
+
+				Value(Xml_node node, char const *attr)
+				{
+					if (!node.has_attribute(attr))
+						return;
+
+					Xml_attribute const attribute = node.attribute(attr);
+					_base = attribute.value_base();
+					_len  = attribute.value_size();
+				}
+
+				bool present() const { return _base != nullptr; }
+
+				bool equals(char const *s, size_t len) const {
+					return len == _len && !strcmp(s, _base, _len); }
+
+				bool prefix_of(char const *s, size_t len) const {
+					return len >= _len && !strcmp(s, _base, _len); }
+
+				bool suffix_of(char const *s, size_t len) const {
+					return len >= _len && !strcmp(s + len - _len, _base, _len); }
+
+				template <typename STRING>
+				STRING string() const { return STRING(Cstring(_base, _len)); }
+		};
+
+		struct Query
+		{
+			Child_policy::Name const &child;
+			Service::Name      const &service;
+			Session_label      const &label;
+		};
+
+		struct Target
+		{
+			enum Type { PARENT, CHILD, ANY_CHILD, UNKNOWN };
+
+			Type          type  { UNKNOWN };
+			Value         name  { };  /* server of a 'CHILD' target     */
+			Value         label { };  /* label presented to the server */
+			Session::Diag diag  { false };
+
+			Target() { }
+
+			Target(Xml_node node)
+			:
+				type (node.has_type("parent")    ? PARENT    :
+				      node.has_type("child")     ? CHILD     :
+				      node.has_type("any-child") ? ANY_CHILD : UNKNOWN),
+				name (node, "name"),
+				label(node, "label"),
+				diag { node.attribute_value("diag", false) }
+			{ }
+		};
+
+		class Rule : Noncopyable
+		{
+			private:
+
+				friend class Route_model;
+
+				bool  _any_service = false;
+				Value _service { };
+
+				Value _unscoped_label { };
+				Value _label_last     { };
+				Value _label          { };
+				Value _label_prefix   { };
+				Value _label_suffix   { };
+
+				Target  *_targets     = nullptr;
+				unsigned _num_targets = 0;
+
+			public:
+
+				/**
+				 * Return true if the rule applies to the session request
+				 *
+				 * The rule must apply to the requested service.
+				 */
+				bool matches(Query const &query) const
+				{
+					char   const * const label     = query.label.string();
+					size_t const         label_len = query.label.length() - 1;
+
+					if (_unscoped_label.present())
+						return _unscoped_label.equals(label, label_len);
+
+					if (_label_last.present()) {
+						Session_label const last = query.label.last_element();
+						return _label_last.equals(last.string(), last.length() - 1);
+					}
+
+					if (!_label.present() && !_label_prefix.present()
+					 && !_label_suffix.present())
+						return true;
+
+					/* the conditions refer to the label without the child's name */
+					size_t const child_len = query.child.length() - 1;
+					char const * const separator = " -> ";
+
+					if (label_len < child_len + 4
+					 || strcmp(label, query.child.string(), child_len)
+					 || strcmp(label + child_len, separator, 4))
+						return false;
+
+					char   const * const scoped     = label + child_len + 4;
+					size_t const         scoped_len = label_len - child_len - 4;
+
+					return (!_label.present()        || _label.equals(scoped, scoped_len))
+					    && (!_label_prefix.present() || _label_prefix.prefix_of(scoped, scoped_len))
+					    && (!_label_suffix.present() || _label_suffix.suffix_of(scoped, scoped_len));
+				}
+
+				bool any_service() const { return _any_service; }
+
+				unsigned num_targets() const { return _num_targets; }
+
+				Target const &target(unsigned i) const { return _targets[i]; }
+		};
+
+		/**
+		 * Rules that may apply to a service, in the order of their appearance
+		 */
+		struct Candidates
+		{
+			Rule const * const *rules;
+			unsigned            count;
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Route_model(Route_model const &);
+		Route_model &operator = (Route_model const &);
+
+		Allocator &_alloc;
+
+		Rule    *_rules     = nullptr;
+		unsigned _num_rules = 0;
+
+		struct Service_entry : Avl_string_base
+		{
+			Service::Name const name;
+
+			Rule const **rules;
+			unsigned     count;
+
+			/*
+			 * Noncopyable
+			 */
+			Service_entry(Service_entry const &);
+			Service_entry &operator = (Service_entry const &);
+
+			Service_entry(Service::Name const &name, Rule const **rules,
+			              unsigned count)
+			:
+				Avl_string_base(this->name.string()),
+				name(name), rules(rules), count(count)
+			{ }
+		};
+
+		Avl_tree<Avl_string_base> _services { };
+
+		/* rules for services without rule of their own */
+		Rule const **_wildcard_rules     = nullptr;
+		unsigned     _num_wildcard_rules = 0;
+
+		template <typename T>
+		T *_alloc_array(unsigned count)
+		{
+			return count ? (T *)_alloc.alloc(count*sizeof(T)) : nullptr;
+		}
+
+		template <typename T>
+		void _free_array(T *array, unsigned count)
+		{
+			if (array)
+				_alloc.free(array, count*sizeof(T));
+		}
+
+		static bool _service_node(Xml_node node)
+		{
+			return node.has_type("service") || node.has_type("any-service");
+		}
+
+		void _compile_rule(Rule &rule, Xml_node node)
+		{
+			rule._any_service    = node.has_type("any-service");
+			rule._service        = Value(node, "name");
+			rule._unscoped_label = Value(node, "unscoped_label");
+			rule._label_last     = Value(node, "label_last");
+			rule._label          = Value(node, "label");
+			rule._label_prefix   = Value(node, "label_prefix");
+			rule._label_suffix   = Value(node, "label_suffix");
+
+			if (rule._unscoped_label.present()
+			 && (rule._label_last.present() || rule._label.present()
+			  || rule._label_prefix.present() || rule._label_suffix.present()))
+				warning("service node contains both scoped and unscoped label attributes");
+
+			unsigned count = 0;
+			node.for_each_sub_node([&] (Xml_node) { count++; });
+
+			rule._targets     = _alloc_array<Target>(count);
+			rule._num_targets = count;
+
+			unsigned i = 0;
+			node.for_each_sub_node([&] (Xml_node target) {
+				construct_at<Target>(&rule._targets[i++], target); });
+		}
+
+		Service_entry *_service_entry(char const *name) const
+		{
+			Avl_string_base * const first = _services.first();
+			Avl_string_base * const entry = first ? first->find_by_name(name) : nullptr;
+
+			return static_cast<Service_entry *>(entry);
+		}
+
+		void _add_service_entry(Rule const &named)
+		{
+			Service::Name const name = named._service.string<Service::Name>();
+
+			if (_service_entry(name.string()))
+				return;
+
+			auto applies = [&] (Rule const &rule) {
+				return rule._any_service
+				    || rule._service.string<Service::Name>() == name; };
+
+			unsigned count = 0;
+			for (unsigned i = 0; i < _num_rules; i++)
+				count += applies(_rules[i]);
+
+			Rule const **rules = _alloc_array<Rule const *>(count);
+
+			unsigned j = 0;
+			for (unsigned i = 0; i < _num_rules; i++)
+				if (applies(_rules[i]))
+					rules[j++] = &_rules[i];
+
+			_services.insert(new (_alloc) Service_entry(name, rules, count));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param route  '<route>' or '<default-route>' node
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Route_model(Allocator &alloc, Xml_node route) : _alloc(alloc)
+		{
+			route.for_each_sub_node([&] (Xml_node node) {
+				_num_rules += _service_node(node); });
+
+			_rules = _alloc_array<Rule>(_num_rules);
+
+			unsigned i = 0;
+			route.for_each_sub_node([&] (Xml_node node) {
+				if (!_service_node(node))
+					return;
+
+				Rule &rule = *construct_at<Rule>(&_rules[i++]);
+				_compile_rule(rule, node);
+				_num_wildcard_rules += rule._any_service;
+			});
+
+			_wildcard_rules = _alloc_array<Rule const *>(_num_wildcard_rules);
+
+			unsigned j = 0;
+			for (i = 0; i < _num_rules; i++) {
+				if (_rules[i]._any_service)
+					_wildcard_rules[j++] = &_rules[i];
+				else
+					_add_service_entry(_rules[i]);
+			}
+		}
+
+		~Route_model()
+		{
+			while (Avl_string_base *first = _services.first()) {
+				Service_entry &entry = *static_cast<Service_entry *>(first);
+				_services.remove(&entry);
+				_free_array(entry.rules, entry.count);
+				destroy(_alloc, &entry);
+			}
+
+			_free_array(_wildcard_rules, _num_wildcard_rules);
+
+			for (unsigned i = 0; i < _num_rules; i++) {
+				_free_array(_rules[i]._targets, _rules[i]._num_targets);
+				_rules[i].~Rule();
+			}
+			_free_array(_rules, _num_rules);
+		}
+
+		/**
+		 * Return rules that may apply to the specified service
+		 */
+		Candidates candidates(Service::Name const &service) const
+		{
+			if (Service_entry const *entry = _service_entry(service.string()))
+				return Candidates { entry->rules, entry->count };
+
+			return Candidates { _wildcard_rules, _num_wildcard_rules };
+		}
+};
+
+#endif /* _SRC__INIT__ROUTE_MODEL_H_ */
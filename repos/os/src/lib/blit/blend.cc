@@ -0,0 +1,70 @@
+/*
+ * \brief  Pixel-blending functions
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <blit/blend.h>
+#include <blend_simd.h>
+
+using namespace Blit;
+
+
+Blend_kernels const &Blit::default_kernels()
+{
+	typedef Genode::uint32_t Lanes   __attribute__((vector_size(16)));
+	typedef Genode::uint16_t Lanes16 __attribute__((vector_size(16)));
+
+	static Blend_kernels const kernels = Vector_kernels<Lanes, Lanes16>::kernels(
+#if defined(__SSE2__)
+		"sse2"
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		"neon"
+#else
+		"generic"
+#endif
+	);
+	return kernels;
+}
+
+
+/**
+ * Return kernels selected at the first use
+ */
+static Blend_kernels const &kernels()
+{
+	static Blend_kernels const &kernels = simd_kernels();
+	return kernels;
+}
+
+
+void Blit::mix(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+               unsigned char const *alpha, unsigned count) {
+	kernels().mix_rgb565(dst, src, alpha, count); }
+
+
+void Blit::mix(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+               unsigned char const *alpha, unsigned count) {
+	kernels().mix_rgb888(dst, src, alpha, count); }
+
+
+void Blit::avr(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+               Pixel_rgb565 color, unsigned count) {
+	kernels().avr_rgb565(dst, src, color, count); }
+
+
+void Blit::mask(Pixel_rgb565 *dst, Pixel_rgb565 const *src, unsigned count) {
+	kernels().mask_rgb565(dst, src, count); }
+
+
+void Blit::mask(Pixel_rgb888 *dst, Pixel_rgb888 const *src, unsigned count) {
+	kernels().mask_rgb888(dst, src, count); }
+
+
+char const *Blit::blend_kernels() { return kernels().name; }
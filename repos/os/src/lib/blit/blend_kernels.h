@@ -0,0 +1,244 @@
+/*
+ * \brief  Pixel-blending kernels based on the vector extensions of the compiler
+ * \date   2026-10-18
+ *
+ * The kernels are written for vectors of a given size in bytes. The compiler
+ * translates the vector operations to the instruction set enabled for the
+ * compilation unit, e.g., SSE2 or AVX2 on x86 and NEON on ARM. The kernels
+ * do not call any out-of-line code. So a compilation unit built for an
+ * optional instruction-set extension does not leak such code into the rest of
+ * the library.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__BLEND_KERNELS_H_
+#define _LIB__BLIT__BLEND_KERNELS_H_
+
+#include <base/stdint.h>
+#include <blit/blend.h>
+
+namespace Blit {
+
+	struct Blend_kernels;
+
+	template <typename, typename> struct Vector_kernels;
+
+	/**
+	 * Kernels that use the vector unit available by default
+	 */
+	Blend_kernels const &default_kernels();
+}
+
+
+/**
+ * Row functions of one implementation
+ */
+struct Blit::Blend_kernels
+{
+	char const *name;
+
+	void (*mix_rgb565) (Pixel_rgb565 *, Pixel_rgb565 const *,
+	                    unsigned char const *, unsigned);
+	void (*mix_rgb888) (Pixel_rgb888 *, Pixel_rgb888 const *,
+	                    unsigned char const *, unsigned);
+	void (*avr_rgb565) (Pixel_rgb565 *, Pixel_rgb565 const *,
+	                    Pixel_rgb565, unsigned);
+	void (*mask_rgb565)(Pixel_rgb565 *, Pixel_rgb565 const *, unsigned);
+	void (*mask_rgb888)(Pixel_rgb888 *, Pixel_rgb888 const *, unsigned);
+};
+
+
+/**
+ * Kernels for a vector size
+ *
+ * \param LANES     vector of 32-bit values
+ * \param LANES_16  vector of 16-bit values of the same size
+ */
+template <typename LANES, typename LANES_16>
+struct Blit::Vector_kernels
+{
+	typedef LANES    Lanes;
+	typedef LANES_16 Lanes16;
+
+	enum { NUM_LANES    = sizeof(Lanes)/sizeof(Genode::uint32_t),
+	       NUM_LANES_16 = sizeof(Lanes)/sizeof(Genode::uint16_t) };
+
+	template <typename V>
+	static inline V _load(void const *src)
+	{
+		V v;
+		__builtin_memcpy(&v, src, sizeof(v));
+		return v;
+	}
+
+	template <typename V>
+	static inline void _store(void *dst, V const v) {
+		__builtin_memcpy(dst, &v, sizeof(v)); }
+
+	/**
+	 * Select 'a' for lanes where 'mask' is set, or 'b' otherwise
+	 */
+	template <typename V>
+	static inline V _select(V mask, V a, V b) { return (mask & a) | (~mask & b); }
+
+	/**
+	 * Call 'fn' for each chunk of 'N' pixels of a row
+	 *
+	 * The pixels at the end of the row that do not fill a whole chunk are
+	 * processed by the same vector code, operating on zero-padded copies.
+	 * The 'alpha' argument may be a null pointer.
+	 */
+	template <unsigned N, typename PT, typename FN>
+	static inline void _for_each_chunk(PT *dst, PT const *src,
+	                                   unsigned char const *alpha,
+	                                   unsigned count, FN const &fn)
+	{
+		typedef decltype(dst->pixel) Storage;
+
+		for (; count >= N; count -= N, dst += N, src += N, alpha += alpha ? N : 0)
+			fn((void *)dst, (void const *)src, alpha);
+
+		if (!count)
+			return;
+
+		Storage       d[N] { }, s[N] { };
+		unsigned char a[N] { };
+
+		__builtin_memcpy(d, (void const *)dst, count*sizeof(PT));
+		__builtin_memcpy(s, (void const *)src, count*sizeof(PT));
+		if (alpha)
+			__builtin_memcpy(a, alpha, count);
+
+		fn(d, s, a);
+
+		__builtin_memcpy((void *)dst, d, count*sizeof(PT));
+	}
+
+	static inline bool _transparent(unsigned char const *alpha)
+	{
+		unsigned char any = 0;
+		for (unsigned i = 0; i < NUM_LANES; i++)
+			any |= alpha[i];
+		return !any;
+	}
+
+	static inline Lanes _lanes(unsigned char const *values)
+	{
+		Lanes v { };
+		for (unsigned i = 0; i < NUM_LANES; i++)
+			v[i] = values[i];
+		return v;
+	}
+
+	static inline Lanes _lanes(void const *values_16)
+	{
+		Genode::uint16_t values[NUM_LANES];
+		__builtin_memcpy(values, values_16, sizeof(values));
+
+		Lanes v { };
+		for (unsigned i = 0; i < NUM_LANES; i++)
+			v[i] = values[i];
+		return v;
+	}
+
+	/* blend function of 'Pixel_rgb565' applied to all lanes */
+	static inline Lanes _blend_rgb565(Lanes p, Lanes a)
+	{
+		return ((((a >> 3) * (p & 0xf81f)) >> 5) & 0xf81f)
+		     | ((( a       * (p & 0x07c0)) >> 8) & 0x07c0);
+	}
+
+	/* blend function of 'Pixel_rgb888' applied to all lanes */
+	static inline Lanes _blend_rgb888(Lanes p, Lanes a)
+	{
+		return ((a * ((p & 0xff00) >> 8)) & 0xff00)
+		     | (((a * (p & 0xff00ff)) >> 8) & 0xff00ff);
+	}
+
+	static void mix_rgb565(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	                       unsigned char const *alpha, unsigned count)
+	{
+		_for_each_chunk<NUM_LANES>(dst, src, alpha, count,
+			[&] (void *dst, void const *src, unsigned char const *alpha) {
+
+				if (_transparent(alpha))
+					return;
+
+				Lanes const d = _lanes(dst), s = _lanes(src), a = _lanes(alpha);
+
+				Lanes const mixed = _blend_rgb565(d, 264 - a) + _blend_rgb565(s, a);
+				Lanes const res   = _select((Lanes)(a == 0), d, mixed);
+
+				Genode::uint16_t values[NUM_LANES];
+				for (unsigned i = 0; i < NUM_LANES; i++)
+					values[i] = (Genode::uint16_t)res[i];
+
+				__builtin_memcpy(dst, values, sizeof(values));
+			});
+	}
+
+	static void mix_rgb888(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                       unsigned char const *alpha, unsigned count)
+	{
+		_for_each_chunk<NUM_LANES>(dst, src, alpha, count,
+			[&] (void *dst, void const *src, unsigned char const *alpha) {
+
+				if (_transparent(alpha))
+					return;
+
+				Lanes const d = _load<Lanes>(dst), s = _load<Lanes>(src);
+				Lanes const a = _lanes(alpha);
+
+				Lanes const mixed = _blend_rgb888(d, 255 - a) + _blend_rgb888(s, a);
+
+				_store(dst, _select((Lanes)(a == 0), d, mixed));
+			});
+	}
+
+	static void avr_rgb565(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	                       Pixel_rgb565 color, unsigned count)
+	{
+		Genode::uint16_t const half_color = (color.pixel & 0xf7df) >> 1;
+
+		Lanes16 const c = half_color - Lanes16 { };
+
+		_for_each_chunk<NUM_LANES_16>(dst, src, nullptr, count,
+			[&] (void *dst, void const *src, unsigned char const *) {
+				_store(dst, c + ((_load<Lanes16>(src) & 0xf7df) >> 1)); });
+	}
+
+	static void mask_rgb565(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	                        unsigned count)
+	{
+		_for_each_chunk<NUM_LANES_16>(dst, src, nullptr, count,
+			[&] (void *dst, void const *src, unsigned char const *) {
+
+				Lanes16 const s = _load<Lanes16>(src);
+				_store(dst, _select((Lanes16)(s == 0), _load<Lanes16>(dst), s));
+			});
+	}
+
+	static void mask_rgb888(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                        unsigned count)
+	{
+		_for_each_chunk<NUM_LANES>(dst, src, nullptr, count,
+			[&] (void *dst, void const *src, unsigned char const *) {
+
+				Lanes const s = _load<Lanes>(src);
+				_store(dst, _select((Lanes)(s == 0), _load<Lanes>(dst), s));
+			});
+	}
+
+	static Blend_kernels kernels(char const *name)
+	{
+		return { name, mix_rgb565, mix_rgb888, avr_rgb565, mask_rgb565, mask_rgb888 };
+	}
+};
+
+#endif /* _LIB__BLIT__BLEND_KERNELS_H_ */
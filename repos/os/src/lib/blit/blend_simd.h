@@ -0,0 +1,26 @@
+/*
+ * \brief  Selection of the pixel-blending kernels
+ * \date   2026-10-18
+ *
+ * Without further knowledge about the CPU, the kernels use the vector unit
+ * enabled for the platform at compile time, e.g., NEON on ARM.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__BLEND_SIMD_H_
+#define _LIB__BLIT__BLEND_SIMD_H_
+
+#include <blend_kernels.h>
+
+namespace Blit {
+
+	static inline Blend_kernels const &simd_kernels() { return default_kernels(); }
+}
+
+#endif /* _LIB__BLIT__BLEND_SIMD_H_ */
@@ -0,0 +1,26 @@
+/*
+ * \brief  Pixel-blending kernels for AVX2
+ * \date   2026-10-18
+ *
+ * This compilation unit is built with AVX2 enabled. Its kernels are used only
+ * if the CPU supports AVX2.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <blend_simd.h>
+
+
+Blit::Blend_kernels const &Blit::avx2_kernels()
+{
+	typedef Genode::uint32_t Lanes   __attribute__((vector_size(32)));
+	typedef Genode::uint16_t Lanes16 __attribute__((vector_size(32)));
+
+	static Blend_kernels const kernels = Vector_kernels<Lanes, Lanes16>::kernels("avx2");
+	return kernels;
+}
@@ -0,0 +1,67 @@
+/*
+ * \brief  Selection of the pixel-blending kernels for x86
+ * \date   2026-10-18
+ *
+ * SSE2 is part of the baseline of x86_64. The AVX2 kernels are used if the
+ * CPU supports AVX2 and the kernel saves the AVX register state.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SPEC__X86__BLEND_SIMD_H_
+#define _LIB__BLIT__SPEC__X86__BLEND_SIMD_H_
+
+#include <blend_kernels.h>
+
+namespace Blit {
+
+	/**
+	 * Kernels compiled for AVX2, defined in 'blend_avx2.cc'
+	 */
+	Blend_kernels const &avx2_kernels();
+
+	static inline void cpuid(unsigned leaf, unsigned &a, unsigned &b,
+	                         unsigned &c, unsigned &d)
+	{
+		asm volatile ("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d)
+		                      : "a"(leaf), "c"(0));
+	}
+
+	static inline bool avx2_supported()
+	{
+		unsigned a = 0, b = 0, c = 0, d = 0;
+
+		cpuid(0, a, b, c, d);
+		if (a < 7)
+			return false;
+
+		cpuid(1, a, b, c, d);
+
+		enum { OSXSAVE = 1U << 27, AVX = 1U << 28 };
+		if ((c & (OSXSAVE | AVX)) != (OSXSAVE | AVX))
+			return false;
+
+		/* the SSE and AVX register state must be enabled in XCR0 */
+		unsigned xcr0_lo = 0, xcr0_hi = 0;
+		asm volatile ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+		if ((xcr0_lo & 6) != 6)
+			return false;
+
+		cpuid(7, a, b, c, d);
+
+		enum { AVX2 = 1U << 5 };
+		return b & AVX2;
+	}
+
+	static inline Blend_kernels const &simd_kernels()
+	{
+		return avx2_supported() ? avx2_kernels() : default_kernels();
+	}
+}
+
+#endif /* _LIB__BLIT__SPEC__X86__BLEND_SIMD_H_ */
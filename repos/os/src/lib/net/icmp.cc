@@ -13,6 +13,7 @@
 
 /* Genode includes */
 #include <net/icmp.h>
+#include <net/internet_checksum.h>
 #include <base/output.h>
 
 using namespace Net;
@@ -29,26 +30,7 @@ void Net::Icmp_packet::print(Output &output) const
 uint16_t Icmp_packet::calc_checksum(size_t data_sz) const
 {
 	/* do not sum-up checksum itself */
-	register long sum   = _type + _code;
-	addr_t        addr  = (addr_t)&_rest_of_header_u32;
-	size_t        count = sizeof(Icmp_packet) + data_sz - sizeof(_type) -
-	                      sizeof(_code) - sizeof(_checksum);
-
-	/* sum-up rest of header and data */
-	while (count > 1) {
-		sum   += *(uint16_t *)addr;
-		addr  += sizeof(uint16_t);
-		count -= sizeof(uint16_t);
-	}
-	/* add left-over byte, if any */
-	if (count) {
-		sum += *(uint8_t *)addr;
-	}
-	/*  fold 32-bit sum to 16 bits */
-	while (sum >> 16) {
-		sum = (sum & 0xffff) + (sum >> 16);
-	}
-	/* write to header */
-	uint16_t sum16 = ~sum;
-	return host_to_big_endian(sum16);
+	return internet_checksum(&_rest_of_header_u32,
+	                         sizeof(_rest_of_header_u32) + data_sz,
+	                         internet_sum(this, sizeof(_type) + sizeof(_code)));
 }
@@ -0,0 +1,109 @@
+/*
+ * \brief  Computation of the internet checksum (RFC 1071, RFC 1624)
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/endian.h>
+#include <net/ipv4.h>
+#include <net/internet_checksum.h>
+
+using namespace Genode;
+using namespace Net;
+
+
+/*
+ * The one's complement sum does not depend on the byte order in which the
+ * 16-bit words are added (RFC 1071, section 2.B). Hence, the words are summed
+ * up as read from memory and only the folded result is converted.
+ *
+ * The vector types are translated by the compiler into SSE2 respectively
+ * NEON instructions. Each 32-bit lane accumulates the two 16-bit words it
+ * contains separately, which lets the lane grow by at most 0x1fffe per
+ * round. So, a lane cannot overflow within 'MAX_VECTOR_ROUNDS' rounds.
+ */
+typedef uint32_t Vector           __attribute__((vector_size(16)));
+typedef uint32_t Unaligned_vector __attribute__((vector_size(16), aligned(1)));
+
+enum { VECTOR_SIZE = sizeof(Vector), MAX_VECTOR_ROUNDS = 0x8000 };
+
+
+static inline uint16_t raw_word(uint8_t const *bytes)
+{
+	return host_to_big_endian((uint16_t)(bytes[0] << 8 | bytes[1]));
+}
+
+
+uint16_t Net::internet_sum(void const *data, size_t size, uint16_t sum)
+{
+	uint8_t const *bytes = (uint8_t const *)data;
+	uint64_t       acc   = host_to_big_endian(sum);
+
+	while (size >= 2 * VECTOR_SIZE) {
+
+		Vector lanes_0 = { 0, 0, 0, 0 };
+		Vector lanes_1 = { 0, 0, 0, 0 };
+		for (unsigned rounds = 0;
+		     size >= 2 * VECTOR_SIZE && rounds < MAX_VECTOR_ROUNDS;
+		     rounds++)
+		{
+			Vector const v0 = *(Unaligned_vector const *)bytes;
+			Vector const v1 = *(Unaligned_vector const *)(bytes + VECTOR_SIZE);
+			lanes_0 += (v0 & 0xffff) + (v0 >> 16);
+			lanes_1 += (v1 & 0xffff) + (v1 >> 16);
+			bytes   += 2 * VECTOR_SIZE;
+			size    -= 2 * VECTOR_SIZE;
+		}
+		for (unsigned i = 0; i < 4; i++) {
+			acc += (uint64_t)lanes_0[i] + lanes_1[i]; }
+	}
+	for (; size >= 2; bytes += 2, size -= 2) {
+		acc += raw_word(bytes); }
+
+	/* an odd trailing byte is padded with zero */
+	if (size) {
+		uint8_t const last[2] = { bytes[0], 0 };
+		acc += raw_word(last);
+	}
+	while (acc >> 16) {
+		acc = (acc & 0xffff) + (acc >> 16); }
+
+	return host_to_big_endian((uint16_t)acc);
+}
+
+
+uint16_t Net::internet_sum_ipv4_pseudo_header(Ipv4_address const &src,
+                                              Ipv4_address const &dst,
+                                              uint8_t             prot,
+                                              size_t              size)
+{
+	uint32_t sum = (uint32_t)prot + (uint32_t)size;
+	for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i += 2) {
+		sum += src.addr[i] << 8 | src.addr[i + 1];
+		sum += dst.addr[i] << 8 | dst.addr[i + 1];
+	}
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16); }
+
+	return (uint16_t)sum;
+}
+
+
+uint16_t Net::internet_checksum_update(uint16_t            checksum,
+                                       Ipv4_address const &old_ip,
+                                       Ipv4_address const &new_ip)
+{
+	for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i += 2) {
+		checksum = internet_checksum_update(checksum,
+			(uint16_t)(old_ip.addr[i] << 8 | old_ip.addr[i + 1]),
+			(uint16_t)(new_ip.addr[i] << 8 | new_ip.addr[i + 1]));
+	}
+	return checksum;
+}
@@ -121,10 +121,9 @@ Alarm_timeout_scheduler::Alarm_timeout_scheduler(Time_source  &time_source,
 Alarm_timeout_scheduler::~Alarm_timeout_scheduler()
 {
 	Lock::Guard lock_guard(_lock);
-	while (_active_head) {
-		Alarm *next = _active_head->_next;
-		_active_head->_alarm_reset();
-		_active_head = next;
+	while (Alarm *alarm = _active_alarms.first()) {
+		_active_alarms.remove(alarm);
+		alarm->_alarm_reset();
 	}
 }
 
@@ -174,60 +173,16 @@ void Alarm_timeout_scheduler::_alarm_unsynchronized_enqueue(Alarm *alarm)
 	}
 
 	alarm->_active++;
-
-	/* if active alarm list is empty add first element */
-	if (!_active_head) {
-		alarm->_next = 0;
-		_active_head = alarm;
-		return;
-	}
-
-	/* if deadline is smaller than any other deadline, put it on the head */
-	if (alarm->_raw.is_pending_at(_active_head->_raw.deadline, _active_head->_raw.deadline_period)) {
-		alarm->_next = _active_head;
-		_active_head = alarm;
-		return;
-	}
-
-	/* find list element with a higher deadline */
-	Alarm *curr = _active_head;
-	while (curr->_next &&
-	       curr->_next->_raw.is_pending_at(alarm->_raw.deadline, alarm->_raw.deadline_period))
-	{
-		curr = curr->_next;
-	}
-
-	/* if end of list is reached, append new element */
-	if (curr->_next == 0) {
-		curr->_next = alarm;
-		return;
-	}
-
-	/* insert element in middle of list */
-	alarm->_next = curr->_next;
-	curr->_next  = alarm;
+	_active_alarms.insert(alarm);
 }
 
 
 void Alarm_timeout_scheduler::_alarm_unsynchronized_dequeue(Alarm *alarm)
 {
-	if (!_active_head) return;
-
-	if (_active_head == alarm) {
-		_active_head = alarm->_next;
-		alarm->_alarm_reset();
-		return;
-	}
-
-	/* find predecessor in alarm queue */
-	Alarm *curr;
-	for (curr = _active_head; curr && (curr->_next != alarm); curr = curr->_next);
-
 	/* alarm is not enqueued */
-	if (!curr) return;
+	if (!alarm->_active || alarm->_scheduler != this) return;
 
-	/* remove alarm from alarm queue */
-	curr->_next = alarm->_next;
+	_active_alarms.remove(alarm);
 	alarm->_alarm_reset();
 }
 
@@ -236,12 +191,12 @@ Timeout::Alarm *Alarm_timeout_scheduler::_alarm_get_pending_alarm()
 {
 	Lock::Guard lock_guard(_lock);
 
-	if (!_active_head || !_active_head->_raw.is_pending_at(_now, _now_period)) {
+	Alarm *pending_alarm = _active_alarms.first();
+	if (!pending_alarm || !pending_alarm->_raw.is_pending_at(_now, _now_period)) {
 		return nullptr; }
 
-	/* remove alarm from head of the list */
-	Alarm *pending_alarm = _active_head;
-	_active_head = _active_head->_next;
+	/* remove earliest alarm from the heap */
+	_active_alarms.remove(pending_alarm);
 
 	/*
 	 * Acquire dispatch lock to defer destruction until the call of '_on_alarm'
@@ -412,10 +367,11 @@ bool Alarm_timeout_scheduler::_alarm_next_deadline(Alarm::Time *deadline)
 {
 	Lock::Guard alarm_list_lock_guard(_lock);
 
-	if (!_active_head) return false;
+	Alarm const * const head = _active_alarms.first();
+	if (!head) return false;
 
 	if (deadline)
-		*deadline = _active_head->_raw.deadline;
+		*deadline = head->_raw.deadline;
 
 	if (*deadline < _min_handle_period.deadline) {
 		*deadline = _min_handle_period.deadline;
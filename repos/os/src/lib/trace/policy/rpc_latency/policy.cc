@@ -0,0 +1,58 @@
+#include <base/ipc_msgbuf.h>
+#include <trace/policy.h>
+#include <trace/binary_event.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+typedef Trace::Binary_event Event;
+
+enum { OPCODE_UNKNOWN = Event::OPCODE_UNKNOWN };
+
+static size_t event(char *dst, Event::Type type, unsigned opcode,
+                    unsigned value, char const *name)
+{
+	return Event::generate(dst, type, Trace::timestamp(), opcode, value, name);
+}
+
+size_t max_event_size()
+{
+	return Event::max_size();
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &msg)
+{
+	/* the first word of the call message is the opcode */
+	return event(dst, Event::RPC_CALL, msg.word(0), 0, rpc_name);
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return event(dst, Event::RPC_RETURNED, OPCODE_UNKNOWN, 0, rpc_name);
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return event(dst, Event::RPC_DISPATCH, OPCODE_UNKNOWN, 0, rpc_name);
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return event(dst, Event::RPC_REPLY, OPCODE_UNKNOWN, 0, rpc_name);
+}
+
+size_t signal_submit(char *dst, unsigned const num)
+{
+	return event(dst, Event::SIGNAL_SUBMIT, OPCODE_UNKNOWN, num, nullptr);
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned num)
+{
+	return event(dst, Event::SIGNAL_RECEIVED, OPCODE_UNKNOWN, num, nullptr);
+}
+
+size_t lock_contention(char *dst, char const *lock_name, unsigned long,
+                       unsigned long blocking)
+{
+	return event(dst, Event::LOCK_CONTENTION, OPCODE_UNKNOWN, blocking, lock_name);
+}
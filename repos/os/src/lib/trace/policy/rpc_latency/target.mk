@@ -0,0 +1,5 @@
+TARGET = rpc_latency_policy
+
+TARGET_POLICY = rpc_latency
+
+include $(PRG_DIR)/../policy.inc
@@ -51,3 +51,11 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 {
 	return 0;
 }
+
+size_t lock_contention(char *dst, char const *lock_name, unsigned long, unsigned long)
+{
+	size_t len = min(strlen(lock_name), (size_t)MAX_EVENT_SIZE);
+
+	memcpy(dst, (void*)lock_name, len);
+	return len;
+}
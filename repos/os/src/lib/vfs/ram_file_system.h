@@ -28,6 +28,7 @@ namespace Vfs_ram {
 
 	struct Io_handle;
 	struct Watch_handle;
+	struct Export;
 
 	class Node;
 	class File;
@@ -89,6 +90,35 @@ struct Vfs_ram::Watch_handle final : public  Vfs_watch_handle,
 };
 
 
+/**
+ * Dataspace that holds a copy of one version of a file
+ *
+ * All clients that request the dataspace of an unmodified file share the
+ * same export. Once the file is modified, the export is detached from the
+ * file and freed as soon as it is no longer used.
+ */
+struct Vfs_ram::Export : Genode::List<Export>::Element
+{
+	Ram_dataspace_capability const ds;
+
+	File *file;  /* nullptr if the file changed since the export */
+
+	unsigned users = 0;
+
+	Export(Ram_dataspace_capability ds, File &file) : ds(ds), file(&file) { }
+
+	bool stale() const { return file == nullptr; }
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Export(Export const &);
+		Export &operator = (Export const &);
+};
+
+
 class Vfs_ram::Node : private Genode::Avl_node<Node>, private Genode::Lock
 {
 	private:
@@ -243,11 +273,39 @@ class Vfs_ram::File : public Vfs_ram::Node
 		Chunk_level_0 _chunk;
 		file_size     _length = 0;
 
+		Export *_export = nullptr;
+
+		/**
+		 * Detach the export of the current version after a modification
+		 */
+		void _invalidate_export()
+		{
+			if (_export)
+				_export->file = nullptr;
+
+			_export = nullptr;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		File(File const &);
+		File &operator = (File const &);
+
 	public:
 
 		File(char const *name, Allocator &alloc)
 		: Node(name), _chunk(alloc, 0) { }
 
+		~File() { _invalidate_export(); }
+
+		/**
+		 * Return dataspace export of the current file version, or nullptr
+		 */
+		Export *exported() const { return _export; }
+
+		void exported(Export &e) { _export = &e; }
+
 		size_t read(char *dst, size_t len, file_size seek_offset) override
 		{
 			file_size const chunk_used_size = _chunk.used_size();
@@ -299,6 +357,8 @@ class Vfs_ram::File : public Vfs_ram::Node
 			if (seek_offset + len >= Chunk_level_0::SIZE)
 				len = Chunk_level_0::SIZE - (seek_offset + len);
 
+			_invalidate_export();
+
 			try { _chunk.write(src, len, (size_t)seek_offset); }
 			catch (Out_of_memory) { return 0; }
 
@@ -316,6 +376,8 @@ class Vfs_ram::File : public Vfs_ram::Node
 
 		void truncate(file_size size) override
 		{
+			_invalidate_export();
+
 			if (size < _chunk.used_size())
 				_chunk.truncate(size);
 
@@ -484,6 +546,37 @@ class Vfs::Ram_file_system : public Vfs::File_system
 		Io_response_handler &_io_handler;
 		Vfs_ram::Directory   _root = { "" };
 
+		Genode::Lock                  _exports_lock { };
+		Genode::List<Vfs_ram::Export> _exports      { };
+
+		void _free(Vfs_ram::Export &e)
+		{
+			_exports.remove(&e);
+			_env.ram().free(e.ds);
+			destroy(_alloc, &e);
+		}
+
+		/**
+		 * Free exports of former file versions that are no longer used
+		 *
+		 * Must be called with '_exports_lock' held.
+		 */
+		void _free_stale_exports()
+		{
+			Vfs_ram::Export *next = nullptr;
+			for (Vfs_ram::Export *e = _exports.first(); e; e = next) {
+				next = e->next();
+				if (e->stale() && !e->users)
+					_free(*e);
+			}
+		}
+
+		void _release_stale_exports()
+		{
+			Genode::Lock::Guard guard(_exports_lock);
+			_free_stale_exports();
+		}
+
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
 			using namespace Vfs_ram;
@@ -553,7 +646,13 @@ class Vfs::Ram_file_system : public Vfs::File_system
 		                File_system &)
 		: _env(env), _alloc(alloc), _io_handler(io_handler) { }
 
-		~Ram_file_system() { _root.empty(_alloc); }
+		~Ram_file_system()
+		{
+			_root.empty(_alloc);
+
+			while (Vfs_ram::Export *e = _exports.first())
+				_free(*e);
+		}
 
 
 		/*********************************
@@ -764,6 +863,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 			if (ram_handle->node.unlinked() && !ram_handle->node.opened()) {
 				destroy(_alloc, &ram_handle->node);
+				_release_stale_exports();
 			} else if (node_modified) {
 				node.notify(_io_handler);
 			}
@@ -868,6 +968,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			parent->release(node);
 			parent->notify(_io_handler);
 			remove(node);
+			_release_stale_exports();
 			return UNLINK_OK;
 		}
 
@@ -875,36 +976,63 @@ class Vfs::Ram_file_system : public Vfs::File_system
 		{
 			using namespace Vfs_ram;
 
-			Ram_dataspace_capability ds_cap;
-
 			Node *node = lookup(path);
-			if (!node) return ds_cap;
+			if (!node) return Dataspace_capability();
 			Node::Guard guard(node);
 
 			File *file = dynamic_cast<File *>(node);
-			if (!file) return ds_cap;
+			if (!file) return Dataspace_capability();
 
-			size_t len = file->length();
+			Genode::Lock::Guard exports_guard(_exports_lock);
 
-			char *local_addr = nullptr;
-			try {
-				ds_cap = _env.ram().alloc(len);
+			_free_stale_exports();
 
-				local_addr = _env.rm().attach(ds_cap);
-				file->read(local_addr, file->length(), 0);
-				_env.rm().detach(local_addr);
+			/* share the copy of the unmodified file */
+			if (Export *e = file->exported()) {
+				e->users++;
+				return e->ds;
+			}
 
-			} catch(...) {
+			size_t const len = file->length();
+
+			Ram_dataspace_capability ds_cap;
+			try { ds_cap = _env.ram().alloc(len); }
+			catch (...) { return Dataspace_capability(); }
+
+			try {
+				char * const local_addr = _env.rm().attach(ds_cap);
+				file->read(local_addr, len, 0);
 				_env.rm().detach(local_addr);
+
+				Export &e = *new (_alloc) Export(ds_cap, *file);
+				e.users = 1;
+				_exports.insert(&e);
+				file->exported(e);
+			}
+			catch (...) {
 				_env.ram().free(ds_cap);
 				return Dataspace_capability();
 			}
 			return ds_cap;
 		}
 
-		void release(char const *, Dataspace_capability ds_cap) override {
-			_env.ram().free(
-				static_cap_cast<Genode::Ram_dataspace>(ds_cap)); }
+		void release(char const *, Dataspace_capability ds_cap) override
+		{
+			Genode::Lock::Guard guard(_exports_lock);
+
+			/*
+			 * The export of the current file version is kept for subsequent
+			 * requests. Dataspaces not exported by this file system are
+			 * ignored.
+			 */
+			for (Vfs_ram::Export *e = _exports.first(); e; e = e->next()) {
+				if (e->ds == ds_cap) {
+					if (e->users) e->users--;
+					break;
+				}
+			}
+			_free_stale_exports();
+		}
 
 
 		Watch_result watch(char const      *path,
@@ -950,9 +1078,12 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			Vfs_ram::Io_handle *handle =
 				static_cast<Vfs_ram::Io_handle *>(vfs_handle);
 
-			Vfs_ram::Node::Guard guard(&handle->node);
-			out = handle->node.write(buf, len, handle->seek());
-			handle->modifying = true;
+			{
+				Vfs_ram::Node::Guard guard(&handle->node);
+				out = handle->node.write(buf, len, handle->seek());
+				handle->modifying = true;
+			}
+			_release_stale_exports();
 
 			return WRITE_OK;
 		}
@@ -980,10 +1111,14 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			Vfs_ram::Io_handle const *handle =
 				static_cast<Vfs_ram::Io_handle *>(vfs_handle);
 
-			Vfs_ram::Node::Guard guard(&handle->node);
+			{
+				Vfs_ram::Node::Guard guard(&handle->node);
+
+				try { handle->node.truncate(len); }
+				catch (Vfs_ram::Out_of_memory) { return FTRUNCATE_ERR_NO_SPACE; }
+			}
+			_release_stale_exports();
 
-			try { handle->node.truncate(len); }
-			catch (Vfs_ram::Out_of_memory) { return FTRUNCATE_ERR_NO_SPACE; }
 			return FTRUNCATE_OK;
 		}
 
@@ -18,6 +18,8 @@
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 #include <base/attached_rom_dataspace.h>
+#include <os/archive_file_dataspaces.h>
+#include <util/reconstructible.h>
 
 namespace Vfs { class Tar_file_system; }
 
@@ -479,6 +481,32 @@ class Vfs::Tar_file_system : public File_system
 		}
 	} _cached_num_dirent;
 
+	/**
+	 * Dataspace of a file handed out via 'dataspace'
+	 *
+	 * The dataspace is shared by all clients of the file.
+	 */
+	struct Export : Genode::List<Export>::Element
+	{
+		Record const &record;
+
+		Genode::Archive_file_dataspaces::File file { };
+
+		unsigned users = 0;
+
+		Export(Record const &record) : record(record) { }
+	};
+
+	Genode::List<Export>             _exports { };
+	Genode::Archive_file_dataspaces  _files   { _env, _tar_ds };
+
+	void _free(Export &e)
+	{
+		_exports.remove(&e);
+		_files.free(e.file);
+		destroy(_alloc, &e);
+	}
+
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
@@ -529,6 +557,12 @@ class Vfs::Tar_file_system : public File_system
 			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
 		}
 
+		~Tar_file_system()
+		{
+			while (Export *e = _exports.first())
+				_free(*e);
+		}
+
 		/*********************************
 		 ** Directory-service interface **
 		 *********************************/
@@ -546,24 +580,42 @@ class Vfs::Tar_file_system : public File_system
 				return Dataspace_capability();
 			}
 
-			try {
-				Ram_dataspace_capability ds_cap =
-					_env.ram().alloc(record->size());
+			for (Export *e = _exports.first(); e; e = e->next()) {
+				if (&e->record == record) {
+					e->users++;
+					return e->file.ds;
+				}
+			}
 
-				void *local_addr = _env.rm().attach(ds_cap);
-				memcpy(local_addr, record->data(), record->size());
-				_env.rm().detach(local_addr);
+			Export *e = nullptr;
+			try { e = new (_alloc) Export(*record); }
+			catch (...) {
+				Genode::warning(__func__, " could not create new dataspace");
+				return Dataspace_capability();
+			}
 
-				return ds_cap;
+			if (!_files.alloc(e->file, (char const *)record->data(), record->size())) {
+				Genode::warning(__func__, " could not create new dataspace");
+				destroy(_alloc, e);
+				return Dataspace_capability();
 			}
-			catch (...) { Genode::warning(__func__, " could not create new dataspace"); }
 
-			return Dataspace_capability();
+			e->users = 1;
+			_exports.insert(e);
+			return e->file.ds;
 		}
 
 		void release(char const *, Dataspace_capability ds_cap) override
 		{
-			_env.ram().free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
+			/* dataspaces not exported by this file system are ignored */
+			for (Export *e = _exports.first(); e; e = e->next()) {
+				if (!(e->file.ds == ds_cap))
+					continue;
+
+				if (--e->users == 0)
+					_free(*e);
+				return;
+			}
 		}
 
 		Stat_result stat(char const *path, Stat &out) override
@@ -118,7 +118,17 @@ namespace Cache {
 		private:
 
 			char        _data[CHUNK_SIZE];
-			unsigned    _writes;
+			bool        _valid = false; /* content was read or written */
+			bool        _dirty = false; /* content not yet written back */
+
+			void _set_dirty(bool dirty)
+			{
+				if (_dirty == dirty)
+					return;
+
+				_dirty = dirty;
+				POLICY::dirty(this, dirty);
+			}
 
 		public:
 
@@ -136,12 +146,16 @@ namespace Cache {
 			 * of 'Chunk_index'.
 			 */
 			Chunk(Genode::Allocator &, offset_t base_offset, Chunk_base *p)
-			: Chunk_base(base_offset, p), _writes(0) { }
+			: Chunk_base(base_offset, p) { }
 
 			/**
 			 * Construct zero chunk
 			 */
-			Chunk() : _writes(0) { }
+			Chunk() { }
+
+			~Chunk() { _set_dirty(false); }
+
+			bool dirty() const { return _dirty; }
 
 			/**
 			 * Return number of used entries
@@ -165,7 +179,32 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
-				_writes++;
+				_valid = true;
+				_set_dirty(true);
+			}
+
+			/**
+			 * Fill chunk with content read from the device
+			 *
+			 * Content that is already present is newer than the content
+			 * read from the device and is therefore kept.
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset)
+			{
+				if (_valid || zero())
+					return;
+
+				assert_valid_range(seek_offset, len, SIZE);
+
+				POLICY::fill(this);
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_valid = true;
 			}
 
 			void read(char *dst, size_t len, offset_t seek_offset) const
@@ -181,15 +220,42 @@ namespace Cache {
 			{
 				assert_valid_range(seek_offset, len, SIZE);
 
-				if (_writes == 0)
+				if (!_valid)
 					throw Range_incomplete(base_offset(), SIZE);
 			}
 
+			/**
+			 * Re-mark chunk as dirty after its write back failed
+			 *
+			 * Content written in the meantime is newer than 'src' and is
+			 * kept. Otherwise, the chunk content is restored from 'src'
+			 * because the chunk may have been evicted and filled again with
+			 * the outdated content of the device.
+			 */
+			void restore(char const *src, size_t len, offset_t seek_offset)
+			{
+				if (_dirty)
+					return;
+
+				assert_valid_range(seek_offset, len, SIZE);
+
+				POLICY::write(this);
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_valid = true;
+				_set_dirty(true);
+			}
+
 			void sync(size_t len, offset_t seek_offset)
 			{
-				if (_writes > 1) {
+				if (_dirty) {
 					POLICY::sync(this, (char*)_data);
-					_writes = 1;
+					_set_dirty(false);
 				}
 			}
 
@@ -215,7 +281,7 @@ namespace Cache {
 
 			void free(size_t, offset_t)
 			{
-				if (_writes > 1) throw Dirty_chunk(_base_offset, SIZE);
+				if (_dirty) throw Dirty_chunk(_base_offset, SIZE);
 
 				_num_entries = 0;
 				if (_parent) _parent->free(SIZE, _base_offset);
@@ -409,6 +475,36 @@ namespace Cache {
 				}
 			};
 
+			struct Fill_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				/* chunks evicted in the meantime are not filled */
+				static Entry &lookup(Chunk_index const &chunk, unsigned i) {
+					return chunk._entry_for_syncing(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.fill(src, len, seek_offset);
+				}
+			};
+
+			struct Restore_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				/* chunks evicted in the meantime are allocated again */
+				static Entry &lookup(Chunk_index &chunk, unsigned i) {
+					return chunk._alloc_entry(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.restore(src, len, seek_offset);
+				}
+			};
+
 			struct Read_func
 			{
 				typedef ENTRY_TYPE const Entry;
@@ -515,6 +611,19 @@ namespace Cache {
 			void write(char const *src, size_t len, offset_t seek_offset) {
 				_range_op(*this, src, len, seek_offset, Write_func()); }
 
+			/**
+			 * Fill chunks with content read from the device
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset) {
+				if (zero()) return;
+				_range_op(*this, src, len, seek_offset, Fill_func()); }
+
+			/**
+			 * Re-mark chunks as dirty after their write back failed
+			 */
+			void restore(char const *src, size_t len, offset_t seek_offset) {
+				_range_op(*this, src, len, seek_offset, Restore_func()); }
+
 			/**
 			 * Allocate needed chunks
 			 */
@@ -15,13 +15,21 @@
 #include <block_session/connection.h>
 #include <block/component.h>
 #include <os/packet_allocator.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
 
 #include "chunk.h"
 
 /**
  * Cache driver used by the generic block driver framework
  *
- * \param POLICY  the cache replacement policy (e.g. LRU)
+ * \param POLICY  the cache replacement policy
+ *
+ * On a cache miss, the driver reads ahead of the requested blocks. The
+ * read-ahead window starts at 'Config::read_ahead_min' bytes and doubles
+ * with each sequential miss up to 'Config::read_ahead_max' bytes. Dirty
+ * chunks of adjacent offsets are written back to the device in one packet
+ * of up to 'Config::write_back_max' bytes.
  */
 template <typename POLICY>
 class Driver : public Block::Driver
@@ -99,7 +107,18 @@ class Driver : public Block::Driver
 
 		enum {
 			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Request),
-			CACHE_BLK_SIZE = 4096
+			CACHE_BLK_SIZE = 4096,
+			BUFFER_SIZE    = Block::Session::TX_QUEUE_SIZE*CACHE_BLK_SIZE
+		};
+
+		struct Config
+		{
+			Genode::size_t read_ahead_min      = CACHE_BLK_SIZE;
+			Genode::size_t read_ahead_max      = 128*1024;
+			Genode::size_t write_back_max      = 128*1024;
+			unsigned       write_back_interval = 0;    /* ms, 0 for none */
+			bool           report              = false;
+			unsigned       report_interval     = 1000; /* ms */
 		};
 
 		/**
@@ -127,6 +146,42 @@ class Driver : public Block::Driver
 		Genode::Io_signal_handler<Driver> _source_submit;
 		Genode::Io_signal_handler<Driver> _yield;
 
+		/* read-ahead */
+		Genode::size_t const _ra_min;
+		Genode::size_t const _ra_max;
+		Genode::size_t       _ra_window;
+		Block::sector_t      _ra_next = 0; /* block following the last miss */
+
+		/* packet collecting dirty chunks to be written back */
+		Genode::size_t const     _wb_max;
+		Block::Packet_descriptor _wb_packet { };
+		Genode::size_t           _wb_size = 0;
+		bool                     _wb_open = false;
+
+		struct Counters
+		{
+			unsigned long hits               = 0;
+			unsigned long misses             = 0;
+			unsigned long read_ahead_bytes   = 0;
+			unsigned long write_back_packets = 0;
+			unsigned long write_back_bytes   = 0;
+			unsigned long write_back_failed  = 0;
+		} _counters { };
+
+		/* write-back packets failed since the last sync */
+		unsigned long _wb_failed_since_sync = 0;
+
+		unsigned const _wb_interval;
+		unsigned const _report_interval;
+
+		Genode::uint64_t _last_write_back = 0;
+		Genode::uint64_t _last_report     = 0;
+
+		Genode::Constructible<Timer::Connection> _timer    { };
+		Genode::Constructible<Genode::Reporter>  _reporter { };
+
+		Genode::Signal_handler<Driver> _timeout;
+
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
 
@@ -172,6 +227,32 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Keep the chunks of a failed write back dirty
+		 *
+		 * The chunks were marked clean when their content was copied into
+		 * the write-back packet. So the content is put back into the cache
+		 * to be written again by the next sync or eviction.
+		 */
+		void _write_back_failed(Block::Packet_descriptor &p)
+		{
+			_counters.write_back_failed++;
+			_wb_failed_since_sync++;
+
+			Genode::error("write-back of blocks ", p.block_number(),
+			              "-", p.block_number() + p.block_count() - 1,
+			              " failed, blocks are kept dirty");
+			try {
+				_cache.restore(_blk.tx()->packet_content(p),
+				               p.block_count() * _blk_sz,
+				               p.block_number() * _blk_sz);
+			} catch (Genode::Allocator::Out_of_memory) {
+				Genode::error("could not keep blocks ", p.block_number(),
+				              "-", p.block_number() + p.block_count() - 1,
+				              " dirty, written data is lost");
+			}
+		}
+
 		/*
 		 * Handle acknowledgements from the backend device
 		 */
@@ -180,18 +261,32 @@ class Driver : public Block::Driver
 			while (_blk.tx()->ack_avail()) {
 				Block::Packet_descriptor p = _blk.tx()->get_acked_packet();
 
-				/* when reading, write result into cache */
-				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _blk_sz,
-					             p.block_number() * _blk_sz);
-
-				/* loop through the list of requests, and ack all related */
+				/* when reading, fill cache with the result */
+				if (p.operation() == Block::Packet_descriptor::READ
+				 && p.succeeded())
+					_cache.fill(_blk.tx()->packet_content(p),
+					            p.block_count() * _blk_sz,
+					            p.block_number() * _blk_sz);
+
+				if (p.operation() == Block::Packet_descriptor::WRITE
+				 && !p.succeeded())
+					_write_back_failed(p);
+
+				/*
+				 * Loop through the list of requests, and ack all related.
+				 * If the device failed to read the blocks, reading them
+				 * again would fail the same way. So the waiting client
+				 * requests fail, too.
+				 */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
 				     r_to_handle = r) {
 					r = r->next();
 					if (r_to_handle->match(p)) {
-						_handle_reply(p, r_to_handle);
+						if (p.succeeded())
+							_handle_reply(p, r_to_handle);
+						else
+							ack_packet(r_to_handle->cli, false);
+
 						_r_list.remove(r_to_handle);
 						Genode::destroy(&_r_slab, r_to_handle);
 					}
@@ -199,12 +294,14 @@ class Driver : public Block::Driver
 
 				_blk.tx()->release_packet(p);
 			}
+
+			_submit_write_back();
 		}
 
 		/*
 		 * Handle that the backend device is ready to receive again
 		 */
-		void _ready_to_submit() { }
+		void _ready_to_submit() { _submit_write_back(); }
 
 		/*
 		 * Setup a request to the backend device
@@ -236,21 +333,35 @@ class Driver : public Block::Driver
 					throw Request_congestion();
 				}
 
-				/* read ahead CACHE_BLK_SIZE */
+				/* read at least CACHE_BLK_SIZE */
 				Block::sector_t nr = _cache_blk_round_off(block_number);
 				Genode::size_t cnt = _cache_blk_round_up(block_count +
 				                                         (block_number - nr));
+				Genode::size_t const needed = cnt;
+
+				cnt = _read_ahead(nr, cnt);
 
 				/* ensure all memory is available before sending the request */
 				_cache.alloc(cnt * _blk_sz, nr * _blk_sz);
 
 				/* construct and send the packet */
-				p_to_dev =
-					Block::Packet_descriptor(_blk.dma_alloc_packet(_blk_sz*cnt),
-					                         Block::Packet_descriptor::READ,
-					                         nr, cnt);
+				Block::Packet_descriptor buf;
+				try { buf = _blk.dma_alloc_packet(_blk_sz*cnt); }
+				catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+
+					/* fall back to the requested blocks only */
+					if (cnt == needed) throw;
+					cnt = needed;
+					buf = _blk.dma_alloc_packet(_blk_sz*cnt);
+				}
+				p_to_dev = Block::Packet_descriptor(buf,
+				                                    Block::Packet_descriptor::READ,
+				                                    nr, cnt);
 				_r_list.insert(new (&_r_slab) Request(p_to_dev, packet, buffer));
 				_blk.tx()->submit_packet(p_to_dev);
+
+				_counters.misses++;
+				_counters.read_ahead_bytes += (cnt - needed) * _blk_sz;
 			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
 				throw Request_congestion();
 			} catch(Genode::Allocator::Out_of_memory) {
@@ -260,6 +371,71 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Return number of blocks to read from the device on a miss
+		 *
+		 * \param nr   first block of the miss, aligned to a cache block
+		 * \param cnt  number of blocks missing, aligned to a cache block
+		 *
+		 * The request is extended by the read-ahead window unless it reaches
+		 * the end of the device or a chunk that is already cached.
+		 */
+		Genode::size_t _read_ahead(Block::sector_t nr, Genode::size_t cnt)
+		{
+			_ra_window = (nr == _ra_next) ? Genode::min(_ra_window * 2, _ra_max)
+			                              : _ra_min;
+
+			Genode::size_t const max = Genode::min(_ra_window / _blk_sz,
+			                                       (Genode::size_t)(_blk_cnt - nr));
+
+			while (cnt < max) {
+				Block::sector_t const next = nr + cnt;
+				try {
+					_cache.stat(CACHE_BLK_SIZE, next * _blk_sz);
+					break;
+				} catch (Cache::Chunk_base::Range_incomplete &) { }
+
+				cnt = Genode::min(cnt + _cache_blk_mod(), max);
+			}
+
+			_ra_next = nr + cnt;
+			return cnt;
+		}
+
+		/*
+		 * Submit packet of chunks to be written back
+		 *
+		 * If the submit queue of the device is full, the packet stays open
+		 * and is submitted by the ready-to-submit handler. Blocking here
+		 * would deadlock because the acknowledgements are handled by the
+		 * same entrypoint.
+		 */
+		void _submit_write_back()
+		{
+			if (!_wb_open || !_blk.tx()->ready_to_submit())
+				return;
+
+			_wb_open = false;
+
+			/* release the unused part of the packet buffer */
+			if (_wb_packet.size() > _wb_size)
+				_alloc.free((void *)(_wb_packet.offset() + _wb_size),
+				            _wb_packet.size() - _wb_size);
+
+			/* the last chunk may exceed the end of the device */
+			Block::sector_t const nr  = _wb_packet.block_number();
+			Genode::size_t  const cnt = Genode::min(_wb_size / _blk_sz,
+			                                        (Genode::size_t)(_blk_cnt - nr));
+
+			Block::Packet_descriptor const p(
+				Block::Packet_descriptor(_wb_packet.offset(), _wb_size),
+				Block::Packet_descriptor::WRITE, nr, cnt);
+			_blk.tx()->submit_packet(p);
+
+			_counters.write_back_packets++;
+			_counters.write_back_bytes += cnt * _blk_sz;
+		}
+
 		/*
 		 * Synchronize dirty chunks with backend device
 		 */
@@ -279,9 +455,17 @@ class Driver : public Block::Driver
 					 */
 					off = e.off;
 					len = _blk_sz * _blk_cnt - off;
+					_submit_write_back();
 					_env.ep().wait_and_dispatch_one_io_signal();
 				}
 			}
+			_submit_write_back();
+
+			if (_wb_failed_since_sync) {
+				Genode::error(_wb_failed_since_sync, " write-back packets "
+				              "failed since the last sync");
+				_wb_failed_since_sync = 0;
+			}
 		}
 
 		/*
@@ -321,29 +505,88 @@ class Driver : public Block::Driver
 				Arg_string::find_arg(args.string(), "ram_quota").ulong_value(0);
 
 			/* flush the requested amount of RAM from cache */
-			POLICY::flush(requested_ram_quota);
+			try { POLICY::flush(requested_ram_quota); }
+			catch (Request_congestion) {
+				warning("could not flush ", requested_ram_quota, " bytes"); }
+
+			_submit_write_back();
 			_env.parent().yield_response();
 		}
 
+		void _report()
+		{
+			typename POLICY::Stats const &stats = POLICY::stats();
+
+			Genode::Reporter::Xml_generator xml(*_reporter, [&] () {
+				xml.attribute("replacement", POLICY::name());
+				xml.node("chunks", [&] () {
+					xml.attribute("resident",   stats.resident);
+					xml.attribute("dirty",      stats.dirty);
+					xml.attribute("evictions",  stats.evictions);
+					xml.attribute("ghost_hits", stats.ghost_hits);
+				});
+				xml.node("requests", [&] () {
+					xml.attribute("hits",       _counters.hits);
+					xml.attribute("misses",     _counters.misses);
+					xml.attribute("read_ahead", _counters.read_ahead_bytes);
+				});
+				xml.node("write_back", [&] () {
+					xml.attribute("packets", _counters.write_back_packets);
+					xml.attribute("bytes",   _counters.write_back_bytes);
+					xml.attribute("failed",  _counters.write_back_failed);
+				});
+			});
+		}
+
+		/*
+		 * Signal handler for periodic write back and reports
+		 */
+		void _handle_timeout()
+		{
+			Genode::uint64_t const now = _timer->elapsed_ms();
+
+			if (_wb_interval && now - _last_write_back >= _wb_interval) {
+				_last_write_back = now;
+				_sync();
+			}
+
+			if (_reporter.constructed() && now - _last_report >= _report_interval) {
+				_last_report = now;
+				_report();
+			}
+		}
+
 	public:
 
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param env     environment
+		 * \param heap    allocator for requests and chunks
+		 * \param config  read-ahead and write-back parameters
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap, Config const &config)
 		: Block::Driver(env.ram()),
 		  _env(env),
 		  _r_slab(&heap),
 		  _alloc(&heap, CACHE_BLK_SIZE),
-		  _blk(_env, &_alloc, Block::Session::TX_QUEUE_SIZE*CACHE_BLK_SIZE),
+		  _blk(_env, &_alloc, BUFFER_SIZE),
 		  _blk_sz(0),
 		  _blk_cnt(0),
 		  _cache(heap, 0),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
-		  _yield(env.ep(), *this, &Driver::_parent_yield)
+		  _yield(env.ep(), *this, &Driver::_parent_yield),
+		  _ra_min(Genode::max(config.read_ahead_min, (Genode::size_t)CACHE_BLK_SIZE)),
+		  _ra_max(Genode::min(Genode::max(config.read_ahead_max, _ra_min),
+		                      (Genode::size_t)BUFFER_SIZE / 4)),
+		  _ra_window(_ra_min),
+		  _wb_max(Genode::min(Genode::max(config.write_back_max,
+		                                  (Genode::size_t)CACHE_BLK_SIZE),
+		                      (Genode::size_t)BUFFER_SIZE / 4)),
+		  _wb_interval(config.write_back_interval),
+		  _report_interval(Genode::max(config.report_interval, 1U)),
+		  _timeout(env.ep(), *this, &Driver::_handle_timeout)
 		{
 			using namespace Genode;
 
@@ -360,6 +603,22 @@ class Driver : public Block::Driver
 
 			/* truncate chunk structure to real size of the device */
 			_cache.truncate(_blk_sz*_blk_cnt);
+
+			if (config.report) {
+				_reporter.construct(env, "blk_cache");
+				_reporter->enabled(true);
+			}
+
+			unsigned const period =
+				!_wb_interval ? (config.report ? _report_interval : 0)
+				              : (config.report ? Genode::min(_wb_interval,
+				                                             _report_interval)
+				                               : _wb_interval);
+			if (period) {
+				_timer.construct(env);
+				_timer->sigh(_timeout);
+				_timer->trigger_periodic(period*1000);
+			}
 		}
 
 		~Driver()
@@ -372,6 +631,53 @@ class Driver : public Block::Driver
 		Block::Session_client* blk()    { return &_blk;   }
 		Genode::size_t         blk_sz() { return _blk_sz; }
 
+		/**
+		 * Add chunk to the packet of chunks to be written back
+		 *
+		 * \param off   device offset of the chunk
+		 * \param data  content of the chunk
+		 *
+		 * \throw Write_failed  the device is not ready to receive a packet
+		 */
+		void write_back(Cache::offset_t off, char const *data)
+		{
+			Block::sector_t const nr = off / _blk_sz;
+
+			/* submit packet if the chunk is not adjacent or does not fit */
+			if (_wb_open &&
+			    (nr != _wb_packet.block_number() + _wb_size / _blk_sz ||
+			     _wb_size + CACHE_BLK_SIZE > _wb_packet.size())) {
+
+				_submit_write_back();
+
+				/* stop coalescing until the device is ready again */
+				if (_wb_open)
+					throw Write_failed(off);
+			}
+
+			if (!_wb_open) {
+				if (!_blk.tx()->ready_to_submit())
+					throw Write_failed(off);
+
+				Block::Packet_descriptor buf;
+				try { buf = _blk.dma_alloc_packet(_wb_max); }
+				catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+					try { buf = _blk.dma_alloc_packet(CACHE_BLK_SIZE); }
+					catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+						throw Write_failed(off); }
+				}
+				_wb_packet = Block::Packet_descriptor(buf,
+				                                      Block::Packet_descriptor::WRITE,
+				                                      nr, 0);
+				_wb_size = 0;
+				_wb_open = true;
+			}
+
+			Genode::memcpy(_blk.tx()->packet_content(_wb_packet) + _wb_size,
+			               data, CACHE_BLK_SIZE);
+			_wb_size += CACHE_BLK_SIZE;
+		}
+
 
 		/****************************
 		 ** Block-driver interface **
@@ -389,11 +695,13 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::READ))
 				throw Io_error();
 
-			if (!_stat(block_number, block_count, buffer, packet))
-				return;
-
-			_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
-			ack_packet(packet);
+			bool const hit = _stat(block_number, block_count, buffer, packet);
+			if (hit) {
+				_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
+				ack_packet(packet);
+				_counters.hits++;
+			}
+			_submit_write_back();
 		}
 
 		void write(Block::sector_t           block_number,
@@ -407,17 +715,22 @@ class Driver : public Block::Driver
 			_cache.alloc(block_count * _blk_sz, block_number * _blk_sz);
 
 			if ((block_number % _cache_blk_mod()) &&
-			    !_stat(block_number, 1, const_cast<char* const>(buffer), packet))
+			    !_stat(block_number, 1, const_cast<char* const>(buffer), packet)) {
+				_submit_write_back();
 				return;
+			}
 
 			if (((block_number+block_count) % _cache_blk_mod())
 				&& !_stat(block_number+block_count-1, 1,
-				          const_cast<char* const>(buffer), packet))
+				          const_cast<char* const>(buffer), packet)) {
+				_submit_write_back();
 				return;
+			}
 
 			_cache.write(buffer, block_count * _blk_sz,
 			             block_number * _blk_sz);
 			ack_packet(packet);
+			_submit_write_back();
 		}
 
 		void sync() { _sync(); }
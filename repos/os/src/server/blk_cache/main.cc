@@ -12,11 +12,13 @@
  */
 
 #include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <util/string.h>
 
-#include "lru.h"
+#include "replacement.h"
 #include "driver.h"
 
-using Policy = Lru_policy;
+using Policy = Replacement;
 static Driver<Policy> * driver = nullptr;
 
 
@@ -31,17 +33,7 @@ void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
 
 	if (!driver) throw Write_failed(off);
 
-	if (!driver->blk()->tx()->ready_to_submit())
-		throw Write_failed(off);
-	try {
-		Block::Packet_descriptor
-			p(driver->blk()->dma_alloc_packet(Driver::CACHE_BLK_SIZE),
-		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
-		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
-		driver->blk()->tx()->submit_packet(p);
-	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-		throw Write_failed(off);
-	}
+	driver->write_back(off, dst);
 }
 
 
@@ -50,14 +42,18 @@ struct Main
 	template <typename T>
 	struct Factory : Block::Driver_factory
 	{
+		typedef typename ::Driver<T>::Config Config;
+
 		Genode::Env  &env;
 		Genode::Heap &heap;
+		Config const  config;
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+		Factory(Genode::Env &env, Genode::Heap &heap, Config const &config)
+		: env(env), heap(heap), config(config) {}
 
 		Block::Driver *create()
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
+			driver = new (&heap) ::Driver<T>(env, heap, config);
 			return driver;
 		}
 
@@ -67,9 +63,60 @@ struct Main
 
 	void resource_handler() { }
 
+	typedef ::Driver<Policy>::Config Config;
+
+	/**
+	 * Read configuration, the component works without one
+	 */
+	static Config config(Genode::Env &env, Genode::Allocator &alloc)
+	{
+		using namespace Genode;
+
+		Config config { };
+		try {
+			Attached_rom_dataspace rom(env, "config");
+			Xml_node const node = rom.xml();
+
+			typedef String<8> Name;
+			Name const name = node.attribute_value("replacement", Name("lru"));
+			Policy::init(alloc, Policy::strategy_from_name(name.string()));
+
+			if (node.has_sub_node("read_ahead")) {
+				Xml_node const ra = node.sub_node("read_ahead");
+				config.read_ahead_min = ra.attribute_value("min",
+					Number_of_bytes(config.read_ahead_min));
+				config.read_ahead_max = ra.attribute_value("max",
+					Number_of_bytes(config.read_ahead_max));
+			}
+
+			if (node.has_sub_node("write_back")) {
+				Xml_node const wb = node.sub_node("write_back");
+				config.write_back_max = wb.attribute_value("max",
+					Number_of_bytes(config.write_back_max));
+				config.write_back_interval = wb.attribute_value("interval_ms",
+					config.write_back_interval);
+			}
+
+			if (node.has_sub_node("report")) {
+				Xml_node const report = node.sub_node("report");
+				config.report = report.attribute_value("statistics", false);
+				config.report_interval = report.attribute_value("interval_ms",
+					config.report_interval);
+			}
+		} catch (...) {
+			Policy::init(alloc, Policy::LRU);
+		}
+
+		log("replacement: ", Policy::name(), ", "
+		    "read-ahead: ", Number_of_bytes(config.read_ahead_min),
+		    "-", Number_of_bytes(config.read_ahead_max), ", "
+		    "write-back: ", Number_of_bytes(config.write_back_max));
+		return config;
+	}
+
 	Genode::Env                 &env;
 	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
+	Factory<Policy>              factory { env, heap, config(env, heap) };
 	Block::Root                  root    { env.ep(), heap, env.rm(), factory, true };
 	Genode::Signal_handler<Main> resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
@@ -0,0 +1,383 @@
+/*
+ * \brief  Cache replacement strategies
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/string.h>
+
+#include "replacement.h"
+#include "driver.h"
+
+typedef Driver<Replacement>::Chunk_level_4 Chunk;
+
+
+struct Ghost;
+
+
+struct Ghost_list
+{
+	Ghost        *oldest = nullptr;
+	Ghost        *newest = nullptr;
+	unsigned long count  = 0;
+};
+
+
+/**
+ * Offset of an evicted chunk
+ */
+struct Ghost
+{
+	Cache::offset_t  off;
+	Ghost_list      *list;
+	Ghost           *older     = nullptr;
+	Ghost           *newer     = nullptr;
+	Ghost           *hash_next = nullptr;
+
+	Ghost(Cache::offset_t off, Ghost_list &list) : off(off), list(&list) { }
+
+	/*
+	 * Noncopyable
+	 */
+	Ghost(Ghost const &);
+	Ghost &operator = (Ghost const &);
+};
+
+
+enum { GHOST_BUCKETS = 1024 };
+
+static Genode::Allocator     *alloc    = nullptr;
+static Replacement::Strategy  strategy = Replacement::LRU;
+static Replacement::Stats     statistics;
+
+/* chunks accessed once (T1 resp. A1in), or all chunks with LRU */
+static Replacement::Queue recent;
+
+/* chunks accessed repeatedly (T2 resp. Am) */
+static Replacement::Queue frequent;
+
+/* ghosts of chunks evicted from 'recent' (B1 resp. A1out) and 'frequent' (B2) */
+static Ghost_list recent_ghosts;
+static Ghost_list frequent_ghosts;
+
+static Ghost *ghost_buckets[GHOST_BUCKETS];
+
+/* target size of 'recent' with ARC */
+static unsigned long arc_target = 0;
+
+/* maximum number of resident chunks so far, used as cache capacity */
+static unsigned long capacity = 0;
+
+
+static Ghost *&ghost_bucket(Cache::offset_t off)
+{
+	return ghost_buckets[(off / Chunk::SIZE) % GHOST_BUCKETS];
+}
+
+
+static Ghost *ghost_lookup(Cache::offset_t off)
+{
+	for (Ghost *g = ghost_bucket(off); g; g = g->hash_next)
+		if (g->off == off)
+			return g;
+
+	return nullptr;
+}
+
+
+static void ghost_remove(Ghost *g)
+{
+	for (Ghost **p = &ghost_bucket(g->off); *p; p = &(*p)->hash_next) {
+		if (*p != g)
+			continue;
+
+		*p = g->hash_next;
+		break;
+	}
+
+	Ghost_list &l = *g->list;
+	if (g->older) g->older->newer = g->newer; else l.oldest = g->newer;
+	if (g->newer) g->newer->older = g->older; else l.newest = g->older;
+	l.count--;
+
+	Genode::destroy(alloc, g);
+}
+
+
+static void ghost_insert(Ghost_list &l, Cache::offset_t off)
+{
+	/*
+	 * Ghosts merely improve the replacement decision. So if no memory is
+	 * left for them, the eviction is not recorded.
+	 */
+	Ghost *g = nullptr;
+	try { g = new (alloc) Ghost(off, l); }
+	catch (...) { return; }
+
+	g->older = l.newest;
+	if (l.newest) l.newest->newer = g; else l.oldest = g;
+	l.newest = g;
+	l.count++;
+
+	g->hash_next = ghost_bucket(off);
+	ghost_bucket(off) = g;
+}
+
+
+static void ghost_trim(Ghost_list &l, unsigned long max)
+{
+	while (l.count > max && l.oldest)
+		ghost_remove(l.oldest);
+}
+
+
+void Replacement::Queue::remove(Element const *e)
+{
+	if (e->_prev) e->_prev->_next = e->_next; else _oldest = e->_next;
+	if (e->_next) e->_next->_prev = e->_prev; else _newest = e->_prev;
+
+	e->_prev = e->_next = nullptr;
+	e->_queue = nullptr;
+	_count--;
+}
+
+
+void Replacement::Queue::insert(Element const *e)
+{
+	Element *elem = const_cast<Element *>(e);
+
+	elem->_prev  = _newest;
+	elem->_next  = nullptr;
+	elem->_queue = this;
+
+	if (_newest) _newest->_next = elem; else _oldest = elem;
+	_newest = elem;
+	_count++;
+}
+
+
+Replacement::Element::~Element()
+{
+	if (!_queue)
+		return;
+
+	_queue->remove(this);
+	statistics.resident--;
+}
+
+
+void Replacement::_admit(Element const *e)
+{
+	Cache::offset_t const off   = static_cast<Chunk const *>(e)->base_offset();
+	Ghost         * const ghost = (strategy == LRU)
+	                            ? nullptr : ghost_lookup(off);
+
+	statistics.resident++;
+	capacity = Genode::max(capacity, statistics.resident);
+
+	if (!ghost) {
+		recent.insert(e);
+		return;
+	}
+
+	statistics.ghost_hits++;
+
+	/* adapt the target size of 'recent' to the ghost hit */
+	if (strategy == ARC) {
+		unsigned long const b1 = Genode::max(recent_ghosts.count,   1UL);
+		unsigned long const b2 = Genode::max(frequent_ghosts.count, 1UL);
+
+		if (ghost->list == &recent_ghosts)
+			arc_target = Genode::min(capacity, arc_target + Genode::max(b2 / b1, 1UL));
+		else
+			arc_target -= Genode::min(arc_target, Genode::max(b1 / b2, 1UL));
+	}
+
+	ghost_remove(ghost);
+	frequent.insert(e);
+}
+
+
+void Replacement::_access(Element const *e)
+{
+	Queue * const queue = e->_queue;
+
+	/* first access of a chunk inserted by read-ahead */
+	if (e->_fresh) {
+		e->_fresh = false;
+		queue->remove(e);
+		statistics.resident--;
+		_admit(e);
+		return;
+	}
+
+	switch (strategy) {
+	case LRU:
+		queue->remove(e);
+		queue->insert(e);
+		return;
+
+	case TWO_Q:
+
+		/* chunks stay in FIFO order until evicted from 'recent' */
+		if (queue == &recent)
+			return;
+
+		queue->remove(e);
+		queue->insert(e);
+		return;
+
+	case ARC:
+		queue->remove(e);
+		frequent.insert(e);
+		return;
+	}
+}
+
+
+bool Replacement::_evict(Queue &queue)
+{
+	for (Element *e = queue.oldest(); e; e = e->_next) {
+
+		Chunk * const cb = static_cast<Chunk *>(e);
+
+		if (cb->dirty()) {
+			try { cb->sync(Chunk::SIZE, cb->base_offset()); }
+			catch (Genode::Exception &) { continue; }
+		}
+
+		Cache::offset_t const off   = cb->base_offset();
+		bool            const ghost = !e->_fresh;
+
+		cb->free(Chunk::SIZE, off);
+		statistics.evictions++;
+
+		if (ghost && strategy == TWO_Q && &queue == &recent) {
+			ghost_insert(recent_ghosts, off);
+			ghost_trim(recent_ghosts, capacity / 2);
+		}
+
+		if (ghost && strategy == ARC) {
+			Ghost_list &l = (&queue == &recent) ? recent_ghosts : frequent_ghosts;
+			ghost_insert(l, off);
+			ghost_trim(l, capacity);
+		}
+		return true;
+	}
+	return false;
+}
+
+
+/**
+ * Return queue to evict the next chunk from
+ */
+static Replacement::Queue &victim_queue()
+{
+	if (!frequent.count())
+		return recent;
+
+	switch (strategy) {
+	case LRU:
+		break;
+
+	case TWO_Q:
+		if (recent.count() > Genode::max(statistics.resident / 4, 1UL))
+			return recent;
+		return frequent;
+
+	case ARC:
+		if (recent.count() && recent.count() >= Genode::max(arc_target, 1UL))
+			return recent;
+		return frequent;
+	}
+	return recent;
+}
+
+
+void Replacement::init(Genode::Allocator &a, Strategy s)
+{
+	alloc    = &a;
+	strategy = s;
+}
+
+
+Replacement::Strategy Replacement::strategy_from_name(char const *name)
+{
+	if (!Genode::strcmp(name, "2q"))  return TWO_Q;
+	if (!Genode::strcmp(name, "arc")) return ARC;
+	return LRU;
+}
+
+
+char const *Replacement::name()
+{
+	switch (strategy) {
+	case LRU:   return "lru";
+	case TWO_Q: return "2q";
+	case ARC:   return "arc";
+	}
+	return "";
+}
+
+
+Replacement::Stats const &Replacement::stats() { return statistics; }
+
+
+void Replacement::read(const Replacement::Element *e)
+{
+	if (e->_queue) _access(e); else _admit(e);
+}
+
+
+void Replacement::write(const Replacement::Element *e)
+{
+	if (e->_queue) _access(e); else _admit(e);
+}
+
+
+void Replacement::fill(const Replacement::Element *e)
+{
+	if (e->_queue)
+		return;
+
+	e->_fresh = true;
+	recent.insert(e);
+	statistics.resident++;
+	capacity = Genode::max(capacity, statistics.resident);
+}
+
+
+void Replacement::dirty(const Replacement::Element *, bool dirty)
+{
+	if (dirty) statistics.dirty++; else statistics.dirty--;
+}
+
+
+void Replacement::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	for (; (size == 0) || (s < size); s += sizeof(Chunk)) {
+
+		Queue &queue = victim_queue();
+		Queue &other = (&queue == &recent) ? frequent : recent;
+
+		if (!_evict(queue) && !_evict(other))
+			break;
+	}
+
+	/* forget all ghosts when the whole cache is flushed */
+	if (size == 0) {
+		ghost_trim(recent_ghosts, 0);
+		ghost_trim(frequent_ghosts, 0);
+		arc_target = 0;
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
@@ -0,0 +1,142 @@
+/*
+ * \brief  Cache replacement strategies
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _REPLACEMENT_H_
+#define _REPLACEMENT_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+
+#include "chunk.h"
+
+/**
+ * Replacement policy of the cache, the strategy is selected at runtime
+ *
+ * The policy keeps the cached chunks in two queues. With LRU, all chunks
+ * are kept in the first queue in the order of their last access. The 2Q
+ * and ARC strategies keep chunks that were accessed once in the first queue
+ * and chunks that were accessed repeatedly in the second queue. So a
+ * sequential scan cannot displace the frequently used chunks. Both
+ * strategies remember the offsets of recently evicted chunks, called ghosts,
+ * to detect chunks that are accessed again shortly after their eviction.
+ * ARC additionally adapts the target size of the first queue depending on
+ * which ghosts are hit.
+ */
+class Replacement
+{
+	public:
+
+		enum Strategy { LRU, TWO_Q, ARC };
+
+		class Queue;
+
+		class Element
+		{
+			private:
+
+				friend class Replacement;
+				friend class Queue;
+
+				Element mutable *_prev  = nullptr;
+				Element mutable *_next  = nullptr;
+				Queue   mutable *_queue = nullptr;
+
+				/* inserted by read-ahead but not accessed yet */
+				bool mutable _fresh = false;
+
+				/*
+				 * Noncopyable
+				 */
+				Element(Element const &);
+				Element &operator = (Element const &);
+
+			protected:
+
+				/*
+				 * Only destructed as part of a chunk
+				 */
+				~Element();
+
+			public:
+
+				Element() { }
+		};
+
+		class Queue
+		{
+			private:
+
+				Element      *_oldest = nullptr;
+				Element      *_newest = nullptr;
+				unsigned long _count  = 0;
+
+			public:
+
+				void remove(Element const *e);
+				void insert(Element const *e);
+
+				Element      *oldest() const { return _oldest; }
+				unsigned long count()  const { return _count; }
+		};
+
+		struct Stats
+		{
+			unsigned long resident   = 0;
+			unsigned long dirty      = 0;
+			unsigned long evictions  = 0;
+			unsigned long ghost_hits = 0;
+		};
+
+	private:
+
+		/**
+		 * Insert chunk that was not cached before
+		 */
+		static void _admit(Element const *e);
+
+		/**
+		 * Update position of cached chunk on access
+		 */
+		static void _access(Element const *e);
+
+		/**
+		 * Evict the least valuable chunk of a queue
+		 *
+		 * Dirty chunks are written back before, chunks that cannot be
+		 * written back at the moment are skipped.
+		 *
+		 * \return true if a chunk was evicted
+		 */
+		static bool _evict(Queue &queue);
+
+	public:
+
+		static void init(Genode::Allocator &alloc, Strategy strategy);
+
+		static Strategy    strategy_from_name(char const *name);
+		static char const *name();
+
+		static Stats const &stats();
+
+
+		/*******************************************
+		 ** Interface used by the chunk structure **
+		 *******************************************/
+
+		static void read(const Element  *e);
+		static void write(const Element *e);
+		static void fill(const Element  *e);
+		static void dirty(const Element *e, bool dirty);
+		static void flush(Cache::size_t size = 0);
+};
+
+#endif /* _REPLACEMENT_H_ */
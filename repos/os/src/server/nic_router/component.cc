@@ -43,13 +43,17 @@ Session_component_base(Allocator           &guarded_alloc_backing,
                        Ram_session         &buf_ram,
                        size_t        const  tx_buf_size,
                        size_t        const  rx_buf_size,
+                       Shared_buffer::Window *const tx_window,
                        Configuration const &config,
                        Session_label const &label)
 :
 	_guarded_alloc(&guarded_alloc_backing, guarded_alloc_amount),
-	_range_alloc(&_guarded_alloc), _tx_buf(buf_ram, tx_buf_size),
+	_range_alloc(&_guarded_alloc), _tx_window(tx_window),
 	_rx_buf(buf_ram, rx_buf_size), _intf_policy(label, config)
-{ }
+{
+	if (!_tx_window) {
+		_tx_buf.construct(buf_ram, tx_buf_size); }
+}
 
 
 /**********************************************
@@ -86,6 +90,8 @@ Net::Session_component::Session_component(Allocator           &alloc,
                                           Ram_session         &buf_ram,
                                           size_t        const  tx_buf_size,
                                           size_t        const  rx_buf_size,
+                                          Shared_buffer::Window *const tx_window,
+                                          Shared_buffer   const *const shared_buffer,
                                           Region_map          &region_map,
                                           Mac_address   const  mac,
                                           Entrypoint          &ep,
@@ -95,16 +101,20 @@ Net::Session_component::Session_component(Allocator           &alloc,
                                           Configuration       &config)
 :
 	Session_component_base(alloc, amount, buf_ram, tx_buf_size, rx_buf_size,
-	                       config, label),
-	Session_rpc_object(region_map, _tx_buf, _rx_buf, &_range_alloc,
+	                       tx_window, config, label),
+	Session_rpc_object(region_map, _tx_ds(), _rx_buf, &_range_alloc,
 	                   ep.rpc_ep()),
 	Interface(ep, timer, router_mac, _guarded_alloc, mac, config, interfaces,
-	          _intf_policy)
+	          _intf_policy),
+	_shared_buffer(shared_buffer)
 {
 	_tx.sigh_ready_to_ack(_sink_ack);
 	_tx.sigh_packet_avail(_sink_submit);
 	_rx.sigh_ack_avail(_source_ack);
 	_rx.sigh_ready_to_submit(_source_submit);
+
+	if (_tx_window) {
+		_tx_window->interface(*this); }
 }
 
 
@@ -119,11 +129,13 @@ Net::Root::Root(Entrypoint        &ep,
                 Configuration     &config,
                 Ram_session       &buf_ram,
                 Interface_list    &interfaces,
-                Region_map        &region_map)
+                Region_map        &region_map,
+                Shared_buffer     *shared_buffer)
 :
 	Root_component<Session_component>(&ep.rpc_ep(), &alloc), _timer(timer),
 	_ep(ep), _router_mac(router_mac), _config(config), _buf_ram(buf_ram),
-	_region_map(region_map), _interfaces(interfaces)
+	_region_map(region_map), _interfaces(interfaces),
+	_shared_buffer(shared_buffer)
 {
 	_mac_alloc.mac_addr_base = config.mac_first();
 }
@@ -155,17 +167,55 @@ Session_component *Net::Root::_create_session(char const *args)
 			throw Insufficient_ram_quota();
 		}
 		Session_label const label(label_from_args(args));
-		Session_component &component = *new (md_alloc())
-			Session_component(*md_alloc(), _timer, ram_quota - session_size,
-			                  _buf_ram, tx_buf_size, rx_buf_size, _region_map,
-			                  _mac_alloc.alloc(), _ep, _router_mac, label,
-			                  _interfaces, _config());
-
-		component.init();
-		return &component;
+		Mac_address   const mac(_mac_alloc.alloc());
+
+		/*
+		 * Prefer a window of the shared buffer as transmit buffer, which
+		 * spares copying the packets that are sent to the uplink
+		 */
+		Shared_buffer::Window *const tx_window =
+			_shared_buffer && _shared_buffer_permitted(label)
+			? _shared_buffer->alloc_window(tx_buf_size) : nullptr;
+
+		Session_component *component = nullptr;
+		try {
+			component = new (md_alloc())
+				Session_component(*md_alloc(), _timer, ram_quota - session_size,
+				                  _buf_ram, tx_buf_size, rx_buf_size, tx_window,
+				                  _shared_buffer, _region_map, mac, _ep,
+				                  _router_mac, label,
+				                  _interfaces, _config());
+		}
+		catch (...) {
+			if (tx_window) {
+				_shared_buffer->release_window(*tx_window); }
+			throw;
+		}
+		component->init();
+		return component;
 	}
 	catch (Mac_allocator::Alloc_failed) {
 		error("failed to allocate MAC address");
 	}
 	throw Service_denied();
 }
+
+
+void Net::Root::_destroy_session(Session_component *session)
+{
+	Shared_buffer::Window *const tx_window = session->tx_window();
+	Root_component<Session_component>::_destroy_session(session);
+
+	if (tx_window) {
+		_shared_buffer->release_window(*tx_window); }
+}
+
+
+bool Net::Root::_shared_buffer_permitted(Session_label const &label)
+{
+	try {
+		Session_policy policy(label, _config().node());
+		return policy.attribute_value("shared_buffer", false);
+	}
+	catch (Session_policy::No_policy_defined) { return false; }
+}
@@ -20,6 +20,7 @@
 #include <nic/packet_allocator.h>
 #include <nic_session/rpc_object.h>
 #include <nic_bridge/mac_allocator.h>
+#include <util/reconstructible.h>
 
 /* local includes */
 #include <interface.h>
@@ -74,19 +75,39 @@ class Net::Session_component_base
 				void handle_config(Configuration const &config) override { _config = config; }
 		};
 
-		Genode::Allocator_guard _guarded_alloc;
-		Nic::Packet_allocator   _range_alloc;
-		Communication_buffer    _tx_buf;
-		Communication_buffer    _rx_buf;
-		Interface_policy        _intf_policy;
+		/*
+		 * Noncopyable
+		 */
+		Session_component_base(Session_component_base const &);
+		Session_component_base &operator = (Session_component_base const &);
+
+		Genode::Allocator_guard                     _guarded_alloc;
+		Nic::Packet_allocator                       _range_alloc;
+		Shared_buffer::Window               * const _tx_window;
+		Genode::Constructible<Communication_buffer> _tx_buf { };
+		Communication_buffer                        _rx_buf;
+		Interface_policy                            _intf_policy;
+
+		Genode::Dataspace_capability _tx_ds()
+		{
+			return _tx_window ? _tx_window->ds()
+			                  : Genode::Dataspace_capability(*_tx_buf);
+		}
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param tx_window  window of the shared buffer used as transmit
+		 *                   buffer, or nullptr to use a buffer of its own
+		 */
 		Session_component_base(Genode::Allocator           &guarded_alloc_backing,
 		                       Genode::size_t        const  guarded_alloc_amount,
 		                       Genode::Ram_session         &buf_ram,
 		                       Genode::size_t        const  tx_buf_size,
 		                       Genode::size_t        const  rx_buf_size,
+		                       Shared_buffer::Window *const tx_window,
 		                       Configuration         const &config,
 		                       Genode::Session_label const &label);
 };
@@ -98,6 +119,15 @@ class Net::Session_component : private Session_component_base,
 {
 	private:
 
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
+		Shared_buffer const *const _shared_buffer;
+
+
 		/********************
 		 ** Net::Interface **
 		 ********************/
@@ -105,6 +135,11 @@ class Net::Session_component : private Session_component_base,
 		Packet_stream_sink   &_sink()   { return *_tx.sink(); }
 		Packet_stream_source &_source() { return *_rx.source(); }
 
+		Shared_buffer::Window *_rx_window() override { return _tx_window; }
+
+		Shared_buffer const *_window_buffer() const override {
+			return _shared_buffer; }
+
 	public:
 
 		Session_component(Genode::Allocator           &alloc,
@@ -113,6 +148,8 @@ class Net::Session_component : private Session_component_base,
 		                  Genode::Ram_session         &buf_ram,
 		                  Genode::size_t        const  tx_buf_size,
 		                  Genode::size_t        const  rx_buf_size,
+		                  Shared_buffer::Window *const tx_window,
+		                  Shared_buffer   const *const shared_buffer,
 		                  Genode::Region_map          &region_map,
 		                  Mac_address           const  mac,
 		                  Genode::Entrypoint          &ep,
@@ -127,6 +164,8 @@ class Net::Session_component : private Session_component_base,
 		 ******************/
 
 		Mac_address mac_address() override { return _mac; }
+
+		Shared_buffer::Window *tx_window() { return _tx_window; }
 		bool link_state() override { return Interface::link_state(); }
 		void link_state_sigh(Genode::Signal_context_capability sigh) override { Interface::link_state_sigh(sigh); }
 };
@@ -136,6 +175,12 @@ class Net::Root : public Genode::Root_component<Session_component>
 {
 	private:
 
+		/*
+		 * Noncopyable
+		 */
+		Root(Root const &);
+		Root &operator = (Root const &);
+
 		Timer::Connection        &_timer;
 		Mac_allocator             _mac_alloc { };
 		Genode::Entrypoint       &_ep;
@@ -144,6 +189,9 @@ class Net::Root : public Genode::Root_component<Session_component>
 		Genode::Ram_session      &_buf_ram;
 		Genode::Region_map       &_region_map;
 		Interface_list           &_interfaces;
+		Shared_buffer            *_shared_buffer;
+
+		bool _shared_buffer_permitted(Genode::Session_label const &label);
 
 
 		/********************
@@ -152,6 +200,8 @@ class Net::Root : public Genode::Root_component<Session_component>
 
 		Session_component *_create_session(char const *args) override;
 
+		void _destroy_session(Session_component *session) override;
+
 	public:
 
 		Root(Genode::Entrypoint  &ep,
@@ -161,7 +211,8 @@ class Net::Root : public Genode::Root_component<Session_component>
 		     Configuration       &config,
 		     Genode::Ram_session &buf_ram,
 		     Interface_list      &interfaces,
-		     Genode::Region_map  &region_map);
+		     Genode::Region_map  &region_map,
+		     Shared_buffer       *shared_buffer);
 
 		void handle_config(Configuration &config) { _config = Reference<Configuration>(config); }
 };
@@ -73,12 +73,15 @@ Configuration::Configuration(Env               &env,
 		try {
 			/* try to re-use existing reporter */
 			_reporter = legacy._reporter();
-			legacy._reporter = Pointer<Reporter>();
+			legacy._reporter = Pointer<Expanding_reporter>();
 		}
-		catch (Pointer<Reporter>::Invalid) {
+		catch (Pointer<Expanding_reporter>::Invalid) {
 
-			/* there is no reporter by now, create a new one */
-			_reporter = *new (_alloc) Reporter(env, "state");
+			/*
+			 * There is no reporter by now, create a new one. The report buffer
+			 * grows with the number of reported links.
+			 */
+			_reporter = *new (_alloc) Expanding_reporter(env, "state", "state");
 		}
 		/* create report generator */
 		_report = *new (_alloc)
@@ -92,7 +95,7 @@ Configuration::~Configuration()
 {
 	/* destroy reporter */
 	try { destroy(_alloc, &_reporter()); }
-	catch (Pointer<Reporter>::Invalid) { }
+	catch (Pointer<Expanding_reporter>::Invalid) { }
 
 	/* destroy report generator */
 	try { destroy(_alloc, &_report()); }
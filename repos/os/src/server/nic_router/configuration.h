@@ -45,7 +45,7 @@ class Net::Configuration
 		Genode::Microseconds const  _tcp_max_segm_lifetime   { DEFAULT_TCP_MAX_SEGM_LIFETIME_SEC };
 		Mac_address          const  _mac_first               { mac_from_string("02:02:02:02:02:00") };
 		Pointer<Report>             _report                  { };
-		Pointer<Genode::Reporter>   _reporter                { };
+		Pointer<Genode::Expanding_reporter> _reporter        { };
 		Domain_tree                 _domains                 { };
 		Genode::Xml_node     const  _node;
 
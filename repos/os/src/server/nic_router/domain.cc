@@ -131,7 +131,7 @@ Domain::Domain(Configuration &config, Xml_node const node, Allocator &alloc)
 }
 
 
-Link_side_tree &Domain::links(L3_protocol const protocol)
+Link_side_table &Domain::links(L3_protocol const protocol)
 {
 	switch (protocol) {
 	case L3_protocol::TCP:  return _tcp_links;
@@ -294,7 +294,8 @@ void Domain::report(Xml_generator &xml)
 {
 	bool const bytes  = _config.report().bytes();
 	bool const config = _config.report().config();
-	if (!bytes && !config) {
+	bool const links  = _config.report().links();
+	if (!bytes && !config && !links) {
 		return;
 	}
 	xml.node("domain", [&] () {
@@ -307,6 +308,14 @@ void Domain::report(Xml_generator &xml)
 			xml.attribute("ipv4", String<19>(ip_config().interface));
 			xml.attribute("gw",   String<16>(ip_config().gateway));
 		}
+		if (links) {
+			auto report_link_side = [&] (Link_side const &side) {
+				side.report(xml); };
+
+			_tcp_links.for_each(report_link_side);
+			_udp_links.for_each(report_link_side);
+			_icmp_links.for_each(report_link_side);
+		}
 	});
 }
 
@@ -0,0 +1,293 @@
+/*
+ * \brief  Hash table of flows
+ * \date   2026-10-18
+ *
+ * The table uses open addressing with linear probing over buckets that each
+ * fill one cache line. A bucket stores the hashes of its entries next to the
+ * entry pointers, so most mismatches are detected without touching the
+ * entries. When the load exceeds three quarters, entries are migrated to a
+ * larger table a few buckets per operation instead of at once. In addition,
+ * the entry found by the last lookup is remembered because successive
+ * packets tend to belong to the same flow.
+ *
+ * An entry of type 'ENTRY' must provide the methods 'flow_id', which returns
+ * the 'ID' of the entry, and 'flow_hash', which returns 'ID::hash' of it.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _FLOW_TABLE_H_
+#define _FLOW_TABLE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/exception.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+
+namespace Net { template <typename ID, typename ENTRY> class Flow_table; }
+
+
+template <typename ID, typename ENTRY>
+class Net::Flow_table
+{
+	private:
+
+		enum {
+			CACHE_LINE_SIZE   = 64,
+			MIN_NR_OF_BUCKETS = 16,
+			MIGRATE_BUCKETS   = 4,
+		};
+
+		struct Bucket
+		{
+			enum { ENTRIES = CACHE_LINE_SIZE /
+			                 (sizeof(Genode::uint32_t) + sizeof(ENTRY *)) };
+
+			Genode::uint32_t  hashes[ENTRIES];
+			ENTRY            *entries[ENTRIES];
+		};
+
+		struct Table
+		{
+			void           *base          { nullptr };
+			Genode::size_t  size          { 0 };
+			Bucket         *buckets       { nullptr };
+			Genode::size_t  nr_of_buckets { 0 };
+		};
+
+		Genode::Allocator &_alloc;
+		Table              _table         { };
+		Table              _old_table     { };
+		Genode::size_t     _migrate_pos   { 0 };
+		Genode::size_t     _nr_of_entries { 0 };
+		Genode::size_t     _nr_of_removed { 0 };
+		ENTRY             *_last          { nullptr };
+
+		static ENTRY *_removed() { return (ENTRY *)1; }
+
+		static bool _valid(ENTRY const *entry) {
+			return entry && entry != _removed(); }
+
+		Table _alloc_table(Genode::size_t nr_of_buckets)
+		{
+			using namespace Genode;
+
+			Table table;
+			table.size    = nr_of_buckets * sizeof(Bucket) + CACHE_LINE_SIZE - 1;
+			table.base    = _alloc.alloc(table.size);
+			table.buckets = (Bucket *)align_addr((addr_t)table.base,
+			                                     log2((size_t)CACHE_LINE_SIZE));
+			table.nr_of_buckets = nr_of_buckets;
+			memset(table.buckets, 0, nr_of_buckets * sizeof(Bucket));
+			return table;
+		}
+
+		void _free_table(Table &table)
+		{
+			if (table.base) {
+				_alloc.free(table.base, table.size); }
+
+			table = Table();
+		}
+
+		static ENTRY *_lookup(Table const &table, ID const &id,
+		                      Genode::uint32_t hash)
+		{
+			Genode::size_t const mask = table.nr_of_buckets - 1;
+			for (Genode::size_t i = 0, b = hash & mask; i < table.nr_of_buckets;
+			     i++, b = (b + 1) & mask)
+			{
+				Bucket const &bucket = table.buckets[b];
+				for (unsigned e = 0; e < Bucket::ENTRIES; e++) {
+
+					ENTRY *const entry = bucket.entries[e];
+					if (!entry) {
+						return nullptr; }
+
+					if (entry != _removed() && bucket.hashes[e] == hash &&
+					    entry->flow_id() == id)
+					{
+						return entry; }
+				}
+			}
+			return nullptr;
+		}
+
+		static bool _insert(Table &table, ENTRY &entry)
+		{
+			Genode::size_t const mask = table.nr_of_buckets - 1;
+			for (Genode::size_t i = 0, b = entry.flow_hash() & mask;
+			     i < table.nr_of_buckets; i++, b = (b + 1) & mask)
+			{
+				Bucket &bucket = table.buckets[b];
+				for (unsigned e = 0; e < Bucket::ENTRIES; e++) {
+					if (_valid(bucket.entries[e])) {
+						continue; }
+
+					bucket.hashes[e]  = entry.flow_hash();
+					bucket.entries[e] = &entry;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static bool _remove(Table &table, ENTRY const &entry)
+		{
+			Genode::size_t const mask = table.nr_of_buckets - 1;
+			for (Genode::size_t i = 0, b = entry.flow_hash() & mask;
+			     i < table.nr_of_buckets; i++, b = (b + 1) & mask)
+			{
+				Bucket &bucket = table.buckets[b];
+				for (unsigned e = 0; e < Bucket::ENTRIES; e++) {
+					if (!bucket.entries[e]) {
+						return false; }
+
+					if (bucket.entries[e] == &entry) {
+						bucket.entries[e] = _removed();
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		void _migrate(Genode::size_t nr_of_buckets)
+		{
+			if (!_old_table.base) {
+				return; }
+
+			for (; nr_of_buckets && _migrate_pos < _old_table.nr_of_buckets;
+			     nr_of_buckets--, _migrate_pos++)
+			{
+				Bucket &bucket = _old_table.buckets[_migrate_pos];
+				for (unsigned e = 0; e < Bucket::ENTRIES; e++) {
+					if (!_valid(bucket.entries[e])) {
+						continue; }
+
+					_insert(_table, *bucket.entries[e]);
+					bucket.entries[e] = _removed();
+				}
+			}
+			if (_migrate_pos == _old_table.nr_of_buckets) {
+				_free_table(_old_table); }
+		}
+
+		void _grow()
+		{
+			Genode::size_t const nr_of_slots =
+				_table.nr_of_buckets * Bucket::ENTRIES;
+
+			if (_table.base &&
+			    (_nr_of_entries + _nr_of_removed + 1) * 4 <= nr_of_slots * 3)
+			{
+				return; }
+
+			/* finish a pending migration before starting the next one */
+			_migrate(~(Genode::size_t)0);
+
+			/* target a load of at most one half after the migration */
+			Genode::size_t nr_of_buckets = MIN_NR_OF_BUCKETS;
+			while (nr_of_buckets * Bucket::ENTRIES < (_nr_of_entries + 1) * 2) {
+				nr_of_buckets <<= 1; }
+
+			_old_table   = _table;
+			_table       = _alloc_table(nr_of_buckets);
+			_migrate_pos = 0;
+
+			/* tombstones are not carried over to the new table */
+			_nr_of_removed = 0;
+			_migrate(MIGRATE_BUCKETS);
+		}
+
+		template <typename FUNC>
+		static void _for_each(Table const &table, FUNC && functor)
+		{
+			for (Genode::size_t b = 0; b < table.nr_of_buckets; b++)
+				for (unsigned e = 0; e < Bucket::ENTRIES; e++)
+					if (_valid(table.buckets[b].entries[e]))
+						functor(*table.buckets[b].entries[e]);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Flow_table(Flow_table const &);
+		Flow_table &operator = (Flow_table const &);
+
+	public:
+
+		struct No_match : Genode::Exception { };
+
+		Flow_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Flow_table()
+		{
+			_free_table(_old_table);
+			_free_table(_table);
+		}
+
+		void insert(ENTRY *entry)
+		{
+			_grow();
+			_migrate(MIGRATE_BUCKETS);
+			_insert(_table, *entry);
+			_nr_of_entries++;
+		}
+
+		void remove(ENTRY *entry)
+		{
+			if (_last == entry) {
+				_last = nullptr; }
+
+			if (_old_table.base && _remove(_old_table, *entry)) {
+				_nr_of_entries--;
+			} else if (_table.base && _remove(_table, *entry)) {
+				_nr_of_entries--;
+				_nr_of_removed++;
+			}
+			_migrate(MIGRATE_BUCKETS);
+		}
+
+		/**
+		 * Find entry by ID
+		 *
+		 * \throw No_match
+		 */
+		ENTRY &find_by_id(ID const &id)
+		{
+			if (_last && _last->flow_id() == id) {
+				return *_last; }
+
+			Genode::uint32_t const hash = id.hash();
+			ENTRY *entry = nullptr;
+			if (_old_table.base) {
+				entry = _lookup(_old_table, id, hash); }
+
+			if (!entry && _table.base) {
+				entry = _lookup(_table, id, hash); }
+
+			if (!entry) {
+				throw No_match(); }
+
+			_last = entry;
+			return *entry;
+		}
+
+		template <typename FUNC>
+		void for_each(FUNC && functor) const
+		{
+			_for_each(_old_table, functor);
+			_for_each(_table,     functor);
+		}
+
+		Genode::size_t nr_of_entries() const { return _nr_of_entries; }
+};
+
+#endif /* _FLOW_TABLE_H_ */
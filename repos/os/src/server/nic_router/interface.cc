@@ -95,31 +95,6 @@ static void _link_packet(L3_protocol  const  prot,
 }
 
 
-static void _update_checksum(L3_protocol   const prot,
-                             void         *const prot_base,
-                             size_t        const prot_size,
-                             Ipv4_address  const src,
-                             Ipv4_address  const dst,
-                             size_t        const ip_size)
-{
-	switch (prot) {
-	case L3_protocol::TCP:
-		((Tcp_packet *)prot_base)->update_checksum(src, dst, prot_size);
-		return;
-	case L3_protocol::UDP:
-		((Udp_packet *)prot_base)->update_checksum(src, dst);
-		return;
-	case L3_protocol::ICMP:
-		{
-			Icmp_packet &icmp = *(Icmp_packet *)prot_base;
-			icmp.checksum(icmp.calc_checksum(ip_size - sizeof(Ipv4_packet) -
-			                                           sizeof(Icmp_packet)));
-			return;
-		}
-	default: throw Interface::Bad_transport_protocol(); }
-}
-
-
 static Port _dst_port(L3_protocol const prot, void *const prot_base)
 {
 	switch (prot) {
@@ -176,6 +151,60 @@ static void *_prot_base(L3_protocol const  prot,
 }
 
 
+/**
+ * Adapt the transport checksum to a rewrite of addresses and ports
+ *
+ * Instead of summing up the whole packet again, the checksum is updated
+ * incrementally (RFC 1624) from the link identity of the packet before it
+ * was rewritten. This also preserves the invalidity of a bad checksum.
+ */
+static void _adapt_checksum(L3_protocol   const  prot,
+                            void         *const  prot_base,
+                            Link_side_id  const &old_id,
+                            Ipv4_packet   const &ip)
+{
+	Link_side_id const new_id = { ip.src(), _src_port(prot, prot_base),
+	                              ip.dst(), _dst_port(prot, prot_base) };
+
+	auto adapt = [&] (Genode::uint16_t checksum) {
+		checksum = internet_checksum_update(checksum, old_id.src_ip, new_id.src_ip);
+		checksum = internet_checksum_update(checksum, old_id.dst_ip, new_id.dst_ip);
+		checksum = internet_checksum_update(checksum, old_id.src_port.value,
+		                                              new_id.src_port.value);
+		return internet_checksum_update(checksum, old_id.dst_port.value,
+		                                          new_id.dst_port.value);
+	};
+	switch (prot) {
+	case L3_protocol::TCP:
+		{
+			Tcp_packet &tcp = *(Tcp_packet *)prot_base;
+			tcp.checksum(adapt(tcp.checksum()));
+			return;
+		}
+	case L3_protocol::UDP:
+		{
+			/* a checksum of zero denotes that the sender computed none */
+			Udp_packet &udp = *(Udp_packet *)prot_base;
+			if (!udp.checksum()) {
+				return; }
+
+			Genode::uint16_t const checksum = adapt(udp.checksum());
+			udp.checksum(checksum ? checksum : 0xffff);
+			return;
+		}
+	case L3_protocol::ICMP:
+		{
+			/* the ICMP checksum covers neither addresses nor a pseudo header */
+			Icmp_packet &icmp = *(Icmp_packet *)prot_base;
+			icmp.checksum(internet_checksum_update(icmp.checksum(),
+			                                       old_id.src_port.value,
+			                                       icmp.query_id()));
+			return;
+		}
+	default: throw Interface::Bad_transport_protocol(); }
+}
+
+
 /***************
  ** Interface **
  ***************/
@@ -191,18 +220,6 @@ void Interface::_destroy_link(Link &link)
 }
 
 
-void Interface::_pass_prot(Ethernet_frame       &eth,
-                           size_t         const  eth_size,
-                           Ipv4_packet          &ip,
-                           L3_protocol    const  prot,
-                           void          *const  prot_base,
-                           size_t         const  prot_size)
-{
-	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
-	_pass_ip(eth, eth_size, ip);
-}
-
-
 void Interface::_pass_ip(Ethernet_frame &eth,
                          size_t   const  eth_size,
                          Ipv4_packet    &ip)
@@ -444,8 +461,9 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
 	Link_side_id const remote_id = { ip.dst(), _dst_port(prot, prot_base),
 	                                 ip.src(), _src_port(prot, prot_base) };
 	_new_link(prot, local_id, remote_port_alloc, remote_domain, remote_id);
+	_adapt_checksum(prot, prot_base, local_id, ip);
 	remote_domain.interfaces().for_each([&] (Interface &interface) {
-		interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+		interface._pass_ip(eth, eth_size, ip);
 	});
 }
 
@@ -772,7 +790,8 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 
 	/* try to route via existing ICMP links */
 	try {
-		Link_side const &local_side = local_domain.links(prot).find_by_id(local_id);
+		Link_side &local_side = local_domain.links(prot).find_by_id(local_id);
+		local_side.count_packet(eth_size);
 		Link &link = local_side.link();
 		bool const client = local_side.is_client();
 		Link_side &remote_side = client ? link.server() : link.client();
@@ -786,13 +805,14 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 		_src_port(prot, prot_base, remote_side.dst_port());
 		_dst_port(prot, prot_base, remote_side.src_port());
 
+		_adapt_checksum(prot, prot_base, local_id, ip);
 		remote_domain.interfaces().for_each([&] (Interface &interface) {
-			interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+			interface._pass_ip(eth, eth_size, ip);
 		});
 		_link_packet(prot, prot_base, link, client);
 		return;
 	}
-	catch (Link_side_tree::No_match) { }
+	catch (Link_side_table::No_match) { }
 
 	/* try to route via ICMP rules */
 	try {
@@ -874,7 +894,7 @@ void Interface::_handle_icmp_error(Ethernet_frame          &eth,
 			_link_packet(embed_prot, embed_prot_base, link, client); }
 	}
 	/* drop packet if there is no matching link */
-	catch (Link_side_tree::No_match) {
+	catch (Link_side_table::No_match) {
 		throw Drop_packet_inform("no link that matches packet embedded in ICMP error"); }
 }
 
@@ -963,7 +983,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 
 		/* try to route via existing UDP/TCP links */
 		try {
-			Link_side const &local_side = local_domain.links(prot).find_by_id(local_id);
+			Link_side &local_side = local_domain.links(prot).find_by_id(local_id);
+			local_side.count_packet(eth_size);
 			Link &link = local_side.link();
 			bool const client = local_side.is_client();
 			Link_side &remote_side = client ? link.server() : link.client();
@@ -977,13 +998,14 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			_src_port(prot, prot_base, remote_side.dst_port());
 			_dst_port(prot, prot_base, remote_side.src_port());
 
+			_adapt_checksum(prot, prot_base, local_id, ip);
 			remote_domain.interfaces().for_each([&] (Interface &interface) {
-				interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+				interface._pass_ip(eth, eth_size, ip);
 			});
 			_link_packet(prot, prot_base, link, client);
 			return;
 		}
-		catch (Link_side_tree::No_match) { }
+		catch (Link_side_table::No_match) { }
 
 		/* try to route via forward rules */
 		if (local_id.dst_ip == local_intf.address) {
@@ -1207,31 +1229,71 @@ void Interface::_handle_arp(Ethernet_frame &eth,
 
 void Interface::_ready_to_submit()
 {
-	while (_sink().packet_avail()) {
+	Packet_descriptor pkts[PACKET_BATCH];
+	Packet_descriptor acks[PACKET_BATCH];
+
+	while (unsigned const nr_of_pkts = _sink().get_packets(pkts, PACKET_BATCH)) {
+
+		unsigned nr_of_acks = 0;
+		for (unsigned i = 0; i < nr_of_pkts; i++) {
 
-		Packet_descriptor const pkt = _sink().get_packet();
-		if (!pkt.size()) {
-			continue; }
+			Packet_descriptor const &pkt = pkts[i];
+			if (!pkt.size()) {
+				continue; }
 
-		try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
-		catch (Packet_postponed) { continue; }
-		_ack_packet(pkt);
+			try {
+				if (!_handle_pkt(pkt)) {
+					continue; }
+			}
+			catch (Packet_postponed) { continue; }
+			acks[nr_of_acks++] = pkt;
+		}
+		_ack_packets(acks, nr_of_acks);
 	}
 }
 
 
 void Interface::_continue_handle_eth(Packet_descriptor const &pkt)
 {
-	try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
+	try {
+		if (!_handle_pkt(pkt)) {
+			return; }
+	}
 	catch (Packet_postponed) { error("failed twice to handle packet"); }
 	_ack_packet(pkt);
 }
 
 
+bool Interface::_handle_pkt(Packet_descriptor const &pkt)
+{
+	void *const eth_base = _sink().packet_content(pkt);
+
+	Shared_buffer::Window *const window = _rx_window();
+	void *const copy_base = window ? window->receive(pkt, eth_base) : nullptr;
+	if (!copy_base) {
+		_handle_eth(eth_base, pkt.size(), pkt);
+		return true;
+	}
+	/* let the packet be handed over to the uplink without copying */
+	try { _handle_eth(copy_base, pkt.size(), pkt); }
+	catch (Packet_postponed) {
+		window->received();
+		throw;
+	}
+	return !window->received();
+}
+
+
 void Interface::_ready_to_ack()
 {
-	while (_source().ack_avail()) {
-		_source().release_packet(_source().get_acked_packet()); }
+	Packet_descriptor pkts[PACKET_BATCH];
+
+	while (unsigned const nr_of_pkts = _source().get_acked_packets(pkts, PACKET_BATCH)) {
+		for (unsigned i = 0; i < nr_of_pkts; i++) {
+			if (!_handed_over_pkt_acked(pkts[i])) {
+				_source().release_packet(pkts[i]); }
+		}
+	}
 }
 
 
@@ -1317,8 +1379,18 @@ void Interface::_handle_eth(void              *const  eth_base,
 
 void Interface::send(Ethernet_frame &eth, size_t eth_size)
 {
+	Packet_descriptor pkt;
+	if (_hand_over(eth, eth_size, pkt)) {
+		void *pkt_base = &eth;
+		_send_submit_pkt(pkt, pkt_base, eth_size);
+		return;
+	}
+	Shared_buffer const *const shared_buffer = _window_buffer();
 	send(eth_size, [&] (void *pkt_base) {
-		Genode::memcpy(pkt_base, (void *)&eth, eth_size);
+		if (shared_buffer) {
+			shared_buffer->copy(pkt_base, &eth, eth_size);
+		} else {
+			Genode::memcpy(pkt_base, (void *)&eth, eth_size); }
 	});
 }
 
@@ -1608,6 +1680,18 @@ void Interface::_ack_packet(Packet_descriptor const &pkt)
 }
 
 
+void Interface::_ack_packets(Packet_descriptor const *pkts,
+                             unsigned                 nr_of_pkts)
+{
+	unsigned const nr_of_slots = _sink().ack_slots_free();
+	if (nr_of_pkts > nr_of_slots) {
+		error("ack state FULL");
+		nr_of_pkts = nr_of_slots;
+	}
+	_sink().acknowledge_packets(pkts, nr_of_pkts);
+}
+
+
 void Interface::cancel_arp_waiting(Arp_waiter &waiter)
 {
 	warning("waiting for ARP cancelled");
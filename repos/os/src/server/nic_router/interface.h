@@ -21,6 +21,7 @@
 #include <dhcp_client.h>
 #include <dhcp_server.h>
 #include <list.h>
+#include <shared_buffer.h>
 
 /* Genode includes */
 #include <nic_session/nic_session.h>
@@ -78,6 +79,9 @@ class Net::Interface : private Interface_list::Element
 
 		enum { IPV4_TIME_TO_LIVE = 64 };
 
+		/* maximum number of packet descriptors dequeued at once */
+		enum { PACKET_BATCH = 32 };
+
 		struct Dismiss_link       : Genode::Exception { };
 		struct Dismiss_arp_waiter : Genode::Exception { };
 
@@ -208,19 +212,14 @@ class Net::Interface : private Interface_list::Element
 		                       Genode::size_t  eth_size,
 		                       Domain         &local_domain);
 
-		void _pass_prot(Ethernet_frame         &eth,
-		                Genode::size_t   const  eth_size,
-		                Ipv4_packet            &ip,
-		                L3_protocol      const  prot,
-		                void            *const  prot_base,
-		                Genode::size_t   const  prot_size);
-
 		void _pass_ip(Ethernet_frame       &eth,
 		              Genode::size_t const  eth_size,
 		              Ipv4_packet          &ip);
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
+		bool _handle_pkt(Packet_descriptor const &pkt);
+
 		Ipv4_address const &_router_ip() const;
 
 		void _handle_eth(void              *const  eth_base,
@@ -229,10 +228,42 @@ class Net::Interface : private Interface_list::Element
 
 		void _ack_packet(Packet_descriptor const &pkt);
 
+		void _ack_packets(Packet_descriptor const *pkts,
+		                  unsigned                 nr_of_pkts);
+
 		virtual Packet_stream_sink &_sink() = 0;
 
 		virtual Packet_stream_source &_source() = 0;
 
+		/**
+		 * Return window of the shared buffer used as receive buffer
+		 */
+		virtual Shared_buffer::Window *_rx_window() { return nullptr; }
+
+		/**
+		 * Return shared buffer, which holds the packet currently received
+		 * from a window
+		 */
+		virtual Shared_buffer const *_window_buffer() const { return nullptr; }
+
+		/**
+		 * Try to send received packet 'eth' without copying it
+		 *
+		 * \param pkt  packet descriptor to submit at the source
+		 *
+		 * \return  true if the packet can be submitted as 'pkt'
+		 */
+		virtual bool _hand_over(Ethernet_frame &, Genode::size_t,
+		                        Packet_descriptor &) { return false; }
+
+		/**
+		 * Complete handover of a packet acknowledged at the source
+		 *
+		 * \return  false if the packet was allocated at the source
+		 */
+		virtual bool _handed_over_pkt_acked(Packet_descriptor const &) {
+			return false; }
+
 		void _send_alloc_pkt(Genode::Packet_descriptor   &pkt,
 		                     void                      * &pkt_base,
 		                     Genode::size_t               pkt_size);
@@ -342,6 +373,13 @@ class Net::Interface : private Interface_list::Element
 
 		void send(Ethernet_frame &eth, Genode::size_t eth_size);
 
+		/**
+		 * Acknowledge received packet that was handed over to another
+		 * interface and released by this interface
+		 */
+		void handed_over_pkt_acked(Packet_descriptor const &pkt) {
+			_ack_packet(pkt); }
+
 		Link_list &dissolved_links(L3_protocol const protocol);
 
 		Link_list &links(L3_protocol const protocol);
@@ -45,6 +45,19 @@ bool Link_side_id::operator > (Link_side_id const &id) const
 }
 
 
+uint32_t Link_side_id::hash() const
+{
+	/* FNV-1a over the addresses and ports */
+	uint8_t const *data = (uint8_t const *)data_base();
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < data_size(); i++) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+
 /***************
  ** Link_side **
  ***************/
@@ -53,7 +66,7 @@ Link_side::Link_side(Domain             &domain,
                      Link_side_id const &id,
                      Link               &link)
 :
-	_domain(domain), _id(id), _link(link)
+	_domain(domain), _id(id), _hash(id.hash()), _link(link)
 {
 	if (link.config().verbose()) {
 		log("[", domain, "] New ", l3_protocol_name(link.protocol()),
@@ -62,20 +75,6 @@ Link_side::Link_side(Domain             &domain,
 }
 
 
-Link_side const &Link_side::find_by_id(Link_side_id const &id) const
-{
-	if (id == _id) {
-		return *this; }
-
-	bool const side = id > _id;
-	Link_side *const link_side = Avl_node<Link_side>::child(side);
-	if (!link_side) {
-		throw Link_side_tree::No_match(); }
-
-	return link_side->find_by_id(id);
-}
-
-
 void Link_side::print(Output &output) const
 {
 	Genode::print(output, "src ", src_ip(), ":", src_port(),
@@ -89,17 +88,15 @@ bool Link_side::is_client() const
 }
 
 
-/********************
- ** Link_side_tree **
- ********************/
-
-Link_side const &Link_side_tree::find_by_id(Link_side_id const &id) const
+void Link_side::report(Xml_generator &xml) const
 {
-	Link_side *const link_side = first();
-	if (!link_side) {
-		throw No_match(); }
-
-	return link_side->find_by_id(id);
+	xml.node(is_client() ? "client" : "server", [&] () {
+		xml.attribute("protocol", l3_protocol_name(_link.protocol()));
+		xml.attribute("src",      String<32>(src_ip(), ":", src_port()));
+		xml.attribute("dst",      String<32>(dst_ip(), ":", dst_port()));
+		xml.attribute("packets",  (unsigned long)_packets);
+		xml.attribute("bytes",    (unsigned long)_bytes);
+	});
 }
 
 
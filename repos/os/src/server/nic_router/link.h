@@ -32,8 +32,8 @@
 
 /* Genode includes */
 #include <timer_session/connection.h>
-#include <util/avl_tree.h>
 #include <util/list.h>
+#include <util/xml_generator.h>
 #include <net/ipv4.h>
 #include <net/port.h>
 
@@ -42,6 +42,7 @@
 #include <reference.h>
 #include <pointer.h>
 #include <l3_protocol.h>
+#include <flow_table.h>
 
 namespace Net {
 
@@ -52,8 +53,8 @@ namespace Net {
 	class  Interface;
 	class  Link_side_id;
 	class  Link_side;
-	class  Link_side_tree;
 	class  Link;
+	using  Link_side_table = Flow_table<Link_side_id, Link_side>;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
 	class  Udp_link;
@@ -72,6 +73,8 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::uint32_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
@@ -84,15 +87,18 @@ struct Net::Link_side_id
 __attribute__((__packed__));
 
 
-class Net::Link_side : public Genode::Avl_node<Link_side>
+class Net::Link_side
 {
 	friend class Link;
 
 	private:
 
-		Reference<Domain>   _domain;
-		Link_side_id const  _id;
-		Link               &_link;
+		Reference<Domain>       _domain;
+		Link_side_id const      _id;
+		Genode::uint32_t const  _hash;
+		Link                   &_link;
+		Genode::size_t          _packets { 0 };
+		Genode::size_t          _bytes   { 0 };
 
 	public:
 
@@ -100,16 +106,18 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		          Link_side_id const &id,
 		          Link               &link);
 
-		Link_side const &find_by_id(Link_side_id const &id) const;
-
 		bool is_client() const;
 
+		/**
+		 * Account a packet that was received at this side of the link
+		 */
+		void count_packet(Genode::size_t bytes)
+		{
+			_packets++;
+			_bytes += bytes;
+		}
 
-		/**************
-		 ** Avl_node **
-		 **************/
-
-		bool higher(Link_side *side) { return side->_id > _id; }
+		void report(Genode::Xml_generator &xml) const;
 
 
 		/*********
@@ -129,14 +137,10 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		Ipv4_address const &dst_ip()    const { return _id.dst_ip; }
 		Port                src_port()  const { return _id.src_port; }
 		Port                dst_port()  const { return _id.dst_port; }
-};
-
-
-struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
-{
-	struct No_match : Genode::Exception { };
-
-	Link_side const &find_by_id(Link_side_id const &id) const;
+		Genode::size_t      packets()   const { return _packets; }
+		Genode::size_t      bytes()     const { return _bytes; }
+		Link_side_id const &flow_id()   const { return _id; }
+		Genode::uint32_t    flow_hash() const { return _hash; }
 };
 
 
@@ -40,11 +40,21 @@ class Net::Main
 		Genode::Attached_rom_dataspace  _config_rom     { _env, "config" };
 		Reference<Configuration>        _config         { _init_config() };
 		Signal_handler<Main>            _config_handler { _env.ep(), *this, &Main::_handle_config };
-		Uplink                          _uplink         { _env, _timer, _heap, _interfaces, _config() };
-		Root                            _root           { _env.ep(), _timer, _heap, _uplink.router_mac(), _config(), _env.ram(), _interfaces, _env.rm()};
+		Uplink                          _uplink         { _env, _timer, _heap, _interfaces, _config(), _shared_buffer_size() };
+		Root                            _root           { _env.ep(), _timer, _heap, _uplink.router_mac(), _config(), _env.ram(), _interfaces, _env.rm(), _uplink.shared_buffer() };
 
 		void _handle_config();
 
+		/*
+		 * The shared buffer is part of the uplink session. Hence, its size
+		 * is evaluated only at startup.
+		 */
+		Genode::size_t _shared_buffer_size()
+		{
+			return _config_rom.xml().attribute_value("shared_buffer",
+			                                         Number_of_bytes(0));
+		}
+
 		Configuration &_init_config();
 
 		template <typename FUNC>
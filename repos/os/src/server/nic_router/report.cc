@@ -20,31 +20,26 @@ using namespace Net;
 using namespace Genode;
 
 
-Net::Report::Report(Xml_node const     node,
-                    Timer::Connection &timer,
-                    Domain_tree       &domains,
-                    Reporter          &reporter)
+Net::Report::Report(Xml_node const      node,
+                    Timer::Connection  &timer,
+                    Domain_tree        &domains,
+                    Expanding_reporter &reporter)
 :
 	_config(node.attribute_value("config", true)),
 	_bytes (node.attribute_value("bytes",  true)),
+	_links (node.attribute_value("links",  false)),
 	_reporter(reporter),
 	_domains(domains),
 	_timeout(timer, *this, &Report::_handle_report_timeout,
 	         read_sec_attr(node, "interval_sec", 5))
-{
-	_reporter.enabled(true);
-}
+{ }
 
 
 void Net::Report::_handle_report_timeout(Duration)
 {
-	try {
-		Reporter::Xml_generator xml(_reporter, [&] () {
-			_domains.for_each([&] (Domain &domain) {
-				domain.report(xml);
-			});
+	_reporter.generate([&] (Xml_generator &xml) {
+		_domains.for_each([&] (Domain &domain) {
+			domain.report(xml);
 		});
-	} catch (Xml_generator::Buffer_exceeded) {
-		Genode::warning("Failed to generate report");
-	}
+	});
 }
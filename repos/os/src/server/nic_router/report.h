@@ -37,7 +37,8 @@ class Net::Report
 
 		bool const                       _config;
 		bool const                       _bytes;
-		Genode::Reporter                &_reporter;
+		bool const                       _links;
+		Genode::Expanding_reporter      &_reporter;
 		Domain_tree                     &_domains;
 		Timer::Periodic_timeout<Report>  _timeout;
 
@@ -45,10 +46,10 @@ class Net::Report
 
 	public:
 
-		Report(Genode::Xml_node const  node,
-		       Timer::Connection      &timer,
-		       Domain_tree            &domains,
-		       Genode::Reporter       &reporter);
+		Report(Genode::Xml_node const      node,
+		       Timer::Connection          &timer,
+		       Domain_tree                &domains,
+		       Genode::Expanding_reporter &reporter);
 
 
 		/***************
@@ -57,6 +58,7 @@ class Net::Report
 
 		bool config() const { return _config; }
 		bool bytes()  const { return _bytes; }
+		bool links()  const { return _links; }
 };
 
 #endif /* _REPORT_H_ */
@@ -0,0 +1,210 @@
+/*
+ * \brief  Part of the uplink transmit buffer shared with downlink sessions
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <net/dhcp.h>
+#include <net/tcp.h>
+
+/* local includes */
+#include <shared_buffer.h>
+#include <interface.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+/**
+ * Return whether the router acts on the headers of a packet only
+ *
+ * \param size  number of bytes available at 'base'
+ */
+static bool _headers_only(void const *base, size_t size)
+{
+	if (size < sizeof(Ethernet_frame)) {
+		return false; }
+
+	try {
+		Ethernet_frame const &eth = *(Ethernet_frame const *)base;
+		if (eth.type() != Ethernet_frame::Type::IPV4) {
+			return false; }
+
+		size_t const ip_size = size - sizeof(Ethernet_frame);
+		Ipv4_packet const &ip = *eth.data<Ipv4_packet>(ip_size);
+
+		size_t const l4_size = ip_size - sizeof(Ipv4_packet);
+		switch (ip.protocol()) {
+		case Ipv4_packet::Protocol::TCP:
+			return l4_size >= sizeof(Tcp_packet);
+		case Ipv4_packet::Protocol::UDP:
+			return !Dhcp_packet::is_dhcp(ip.data<Udp_packet>(l4_size));
+		default:
+			return false;
+		}
+	}
+	catch (Ethernet_frame::Bad_data_type) { }
+	catch (Ipv4_packet::Bad_data_type)    { }
+	return false;
+}
+
+
+Shared_buffer::Shared_buffer(Env                  &env,
+                             Allocator            &alloc,
+                             Dataspace_capability  uplink_ds,
+                             addr_t                base,
+                             size_t                size)
+:
+	_alloc(alloc), _rm(env), _uplink_ds(uplink_ds), _base(base),
+	_size(size), _window_alloc(&alloc), _handover_slab(&alloc)
+{
+	_window_alloc.add_range(_base, _size);
+}
+
+
+void Shared_buffer::_destroy_window(Window &window)
+{
+	_rm.destroy(window._rm);
+	_window_alloc.free((void *)window._offset, window._size);
+	_windows.remove(&window);
+	destroy(_alloc, &window);
+}
+
+
+Shared_buffer::Window *Shared_buffer::alloc_window(size_t size)
+{
+	size = align_addr(size, 12);
+
+	void *offset = nullptr;
+	if (_window_alloc.alloc_aligned(size, &offset, 12).error()) {
+		return nullptr; }
+
+	Capability<Region_map> rm;
+	try {
+		rm = _rm.create(size);
+		Region_map_client(rm).attach(_uplink_ds, size, (off_t)offset,
+		                             true, (addr_t)0);
+
+		Window &window = *new (_alloc) Window(*this, (addr_t)offset, size, rm);
+		_windows.insert(&window);
+		return &window;
+	}
+	catch (...) {
+		if (rm.valid()) {
+			_rm.destroy(rm); }
+
+		_window_alloc.free(offset, size);
+		return nullptr;
+	}
+}
+
+
+void Shared_buffer::release_window(Window &window)
+{
+	window._interface = nullptr;
+	window._released  = true;
+	if (!window._pending) {
+		_destroy_window(window); }
+}
+
+
+void *Shared_buffer::_receive(Window                  &window,
+                              Packet_descriptor const &pkt,
+                              void                    *base)
+{
+	size_t const size = pkt.size();
+	if (size > sizeof(_rx_copy)) {
+		return nullptr; }
+
+	/*
+	 * Copy the headers first. The payload is copied only if the router may
+	 * inspect it, i.e., if the packet is not a TCP or a non-DHCP UDP packet.
+	 */
+	char  *const copy   = (char *)_rx_copy;
+	size_t       copied = min(size, (size_t)RX_HEADER_SIZE);
+	memcpy(copy, base, copied);
+	if (!_headers_only(copy, copied)) {
+		memcpy(copy + copied, (char *)base + copied, size - copied);
+		copied = size;
+	}
+	_received = Received { &window, pkt, base, copied, false };
+	return copy;
+}
+
+
+bool Shared_buffer::hand_over(void const        *eth,
+                              size_t             eth_size,
+                              Packet_descriptor &uplink_pkt)
+{
+	/* only the start of the currently received packet can be handed over */
+	if (!_received.window || _received.handed_over ||
+	    eth != _rx_copy || eth_size > _received.pkt.size())
+	{
+		return false;
+	}
+	Window &window = *_received.window;
+
+	/* submit the headers the router acted on, not those in the window */
+	memcpy(_received.base, eth, min(_received.copied, eth_size));
+
+	Packet_descriptor const pkt(window._offset + _received.pkt.offset(),
+	                            eth_size);
+
+	Handover &handover = *new (_handover_slab)
+		Handover(window, _received.pkt, pkt);
+
+	_handovers.enqueue(&handover);
+	window._pending++;
+	_received.handed_over = true;
+	uplink_pkt = pkt;
+	return true;
+}
+
+
+bool Shared_buffer::acked(Packet_descriptor const &uplink_pkt)
+{
+	/* packets allocated by the uplink itself lie in front of the shared part */
+	if ((addr_t)uplink_pkt.offset() < _base) {
+		return false; }
+
+	/* the uplink usually acknowledges in submission order */
+	for (Handover *h = _handovers.head(); h; h = h->next()) {
+
+		if (h->uplink_pkt.offset() != uplink_pkt.offset()) {
+			continue; }
+
+		Window &window = h->window;
+		if (window._interface) {
+			window._interface->handed_over_pkt_acked(h->session_pkt); }
+
+		_handovers.remove(h);
+		destroy(_handover_slab, h);
+
+		window._pending--;
+		if (window._released && !window._pending) {
+			_destroy_window(window); }
+
+		return true;
+	}
+	return false;
+}
+
+
+void Shared_buffer::copy(void *dst, void const *eth, size_t size) const
+{
+	if (!_received.window || eth != _rx_copy) {
+		memcpy(dst, eth, size);
+		return;
+	}
+	size_t const copied = min(_received.copied, size);
+	memcpy(dst, eth, copied);
+	memcpy((char *)dst + copied, (char const *)_received.base + copied,
+	       size - copied);
+}
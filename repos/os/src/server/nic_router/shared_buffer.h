@@ -0,0 +1,253 @@
+/*
+ * \brief  Part of the uplink transmit buffer shared with downlink sessions
+ * \date   2026-10-18
+ *
+ * A downlink session that is permitted to use the shared buffer obtains a
+ * window of it as transmit buffer. The window is a managed dataspace that
+ * maps the matching range of the transmit buffer of the uplink. A packet of
+ * the session that is routed to the uplink is therefore handed over by
+ * submitting its descriptor at the uplink with a translated offset. The
+ * packet is acknowledged to the session not before the uplink acknowledged
+ * it.
+ *
+ * As the session's client can modify the packet at any time, the router
+ * acts on a private copy of the Ethernet, IPv4, and TCP or UDP headers
+ * instead of the packet in the window. Other packets are copied entirely as
+ * their payload may be inspected too. On handover, the rewritten headers
+ * are written back to the window. The payload is not copied.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SHARED_BUFFER_H_
+#define _SHARED_BUFFER_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/tslab.h>
+#include <nic/packet_allocator.h>
+#include <nic_session/nic_session.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+#include <util/fifo.h>
+#include <util/list.h>
+
+namespace Net {
+
+	using Packet_descriptor = ::Nic::Packet_descriptor;
+	class Interface;
+	class Shared_buffer;
+}
+
+
+class Net::Shared_buffer
+{
+	public:
+
+		class Window;
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Shared_buffer(Shared_buffer const &);
+		Shared_buffer &operator = (Shared_buffer const &);
+
+		/**
+		 * Packet of a window submitted at the uplink
+		 */
+		struct Handover : Genode::Fifo<Handover>::Element
+		{
+			Window                  &window;
+			Packet_descriptor const  session_pkt;
+			Packet_descriptor const  uplink_pkt;
+
+			Handover(Window                  &window,
+			         Packet_descriptor const &session_pkt,
+			         Packet_descriptor const &uplink_pkt)
+			:
+				window(window), session_pkt(session_pkt),
+				uplink_pkt(uplink_pkt)
+			{ }
+		};
+
+		enum {
+			/* larger packets are handled in place and never handed over */
+			RX_COPY_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
+
+			/* covers the Ethernet, IPv4, and TCP headers incl. options */
+			RX_HEADER_SIZE = 256,
+		};
+
+		/**
+		 * Packet of a window that is currently handled by the router
+		 */
+		struct Received
+		{
+			Window            *window      = nullptr;
+			Packet_descriptor  pkt         { };
+			void              *base        = nullptr;
+			Genode::size_t     copied      = 0;
+			bool               handed_over = false;
+		};
+
+		enum { HANDOVER_SLAB_BLOCK = 4096 };
+
+		using Handover_slab = Genode::Tslab<Handover, HANDOVER_SLAB_BLOCK>;
+
+		Genode::Allocator                  &_alloc;
+		Genode::Rm_connection               _rm;
+		Genode::Dataspace_capability const  _uplink_ds;
+		Genode::addr_t               const  _base;
+		Genode::size_t               const  _size;
+		Genode::Allocator_avl               _window_alloc;
+		Handover_slab                       _handover_slab;
+		Genode::List<Window>                _windows   { };
+		Genode::Fifo<Handover>              _handovers { };
+		Received                            _received  { };
+
+		/*
+		 * Private copy of the received packet that the router acts on
+		 */
+		Genode::addr_t _rx_copy[RX_COPY_SIZE / sizeof(Genode::addr_t)] { };
+
+		void _destroy_window(Window &window);
+
+		void *_receive(Window &window, Packet_descriptor const &pkt,
+		               void *base);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param uplink_ds  transmit buffer of the uplink
+		 * \param base       offset of the shared part within 'uplink_ds'
+		 * \param size       size of the shared part
+		 */
+		Shared_buffer(Genode::Env                  &env,
+		              Genode::Allocator            &alloc,
+		              Genode::Dataspace_capability  uplink_ds,
+		              Genode::addr_t                base,
+		              Genode::size_t                size);
+
+		/**
+		 * Allocate window of 'size' bytes
+		 *
+		 * \return  window, or nullptr if the shared part is exhausted
+		 */
+		Window *alloc_window(Genode::size_t size);
+
+		/**
+		 * Release window of a closed session
+		 *
+		 * The window is freed once the uplink acknowledged all packets
+		 * handed over from the window.
+		 */
+		void release_window(Window &window);
+
+		/**
+		 * Try to hand over the received packet that starts at 'eth'
+		 *
+		 * The headers of the private copy are written back to the window.
+		 *
+		 * \param uplink_pkt  packet descriptor valid at the uplink
+		 *
+		 * \return  true if the packet is the currently received packet of
+		 *          a window and was not handed over yet
+		 */
+		bool hand_over(void const        *eth,
+		               Genode::size_t     eth_size,
+		               Packet_descriptor &uplink_pkt);
+
+		/**
+		 * Complete handover of a packet acknowledged by the uplink
+		 *
+		 * \return  false if the packet was not handed over
+		 */
+		bool acked(Packet_descriptor const &uplink_pkt);
+
+		/**
+		 * Copy packet 'eth' of 'size' bytes to 'dst'
+		 *
+		 * If 'eth' is the private copy of the received packet that holds
+		 * only the headers, the payload is copied from the window.
+		 */
+		void copy(void *dst, void const *eth, Genode::size_t size) const;
+};
+
+
+/**
+ * Window of the shared buffer used as transmit buffer of a session
+ */
+class Net::Shared_buffer::Window : private Genode::List<Window>::Element
+{
+	friend class Shared_buffer;
+	friend class Genode::List<Window>;
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Window(Window const &);
+		Window &operator = (Window const &);
+
+		Shared_buffer                          &_buffer;
+		Genode::addr_t                   const  _offset;
+		Genode::size_t                   const  _size;
+		Genode::Capability<Genode::Region_map>  _rm;
+
+		Interface *_interface = nullptr;
+		unsigned   _pending   = 0;
+		bool       _released  = false;
+
+		Window(Shared_buffer                          &buffer,
+		       Genode::addr_t                          offset,
+		       Genode::size_t                          size,
+		       Genode::Capability<Genode::Region_map>  rm)
+		:
+			_buffer(buffer), _offset(offset), _size(size), _rm(rm)
+		{ }
+
+	public:
+
+		Genode::Dataspace_capability ds() {
+			return Genode::Region_map_client(_rm).dataspace(); }
+
+		/**
+		 * Set interface that acknowledges the packets of the window
+		 */
+		void interface(Interface &interface) { _interface = &interface; }
+
+		/**
+		 * Begin handling of packet 'pkt' located at 'base'
+		 *
+		 * \return  private copy of the packet to be handled instead, or
+		 *          nullptr if the packet is too large to be copied and
+		 *          must be handled in place without handover
+		 */
+		void *receive(Packet_descriptor const &pkt, void *base) {
+			return _buffer._receive(*this, pkt, base); }
+
+		/**
+		 * End handling of the current packet
+		 *
+		 * \return  true if the packet was handed over to the uplink, which
+		 *          means that it must not be acknowledged yet
+		 */
+		bool received()
+		{
+			bool const handed_over = _buffer._received.handed_over;
+			_buffer._received = Received { };
+			return handed_over;
+		}
+};
+
+#endif /* _SHARED_BUFFER_H_ */
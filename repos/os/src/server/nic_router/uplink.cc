@@ -27,10 +27,12 @@ Net::Uplink::Uplink(Env               &env,
                     Timer::Connection &timer,
                     Genode::Allocator &alloc,
                     Interface_list    &interfaces,
-                    Configuration     &config)
+                    Configuration     &config,
+                    size_t             shared_buffer_size)
 :
-	Nic::Packet_allocator(&alloc),
-	Nic::Connection(env, this, BUF_SIZE, BUF_SIZE),
+	Uplink_packet_allocator(&alloc, BUF_SIZE),
+	Nic::Connection(env, this,
+	                _tx_buf_size(align_addr(shared_buffer_size, 12)), BUF_SIZE),
 	Net::Interface(env.ep(), timer, mac_address(), alloc, Mac_address(),
 	               config, interfaces, _intf_policy)
 {
@@ -38,4 +40,27 @@ Net::Uplink::Uplink(Env               &env,
 	rx_channel()->sigh_packet_avail(_sink_submit);
 	tx_channel()->sigh_ack_avail(_source_ack);
 	tx_channel()->sigh_ready_to_submit(_source_submit);
+
+	if (!shared_buffer_size) {
+		return; }
+
+	/* the shared part follows the part used for the uplink's own packets */
+	_shared_buffer.construct(env, alloc, tx()->dataspace(),
+	                         align_addr((Genode::size_t)BUF_SIZE, 12),
+	                         align_addr(shared_buffer_size, 12));
+}
+
+
+bool Net::Uplink::_hand_over(Ethernet_frame    &eth,
+                             size_t             eth_size,
+                             Packet_descriptor &pkt)
+{
+	return _shared_buffer.constructed() && tx()->ready_to_submit() &&
+	       _shared_buffer->hand_over(&eth, eth_size, pkt);
+}
+
+
+bool Net::Uplink::_handed_over_pkt_acked(Packet_descriptor const &pkt)
+{
+	return _shared_buffer.constructed() && _shared_buffer->acked(pkt);
 }
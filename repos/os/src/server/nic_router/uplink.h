@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <nic_session/connection.h>
 #include <nic/packet_allocator.h>
+#include <util/reconstructible.h>
 
 /* local includes */
 #include <interface.h>
@@ -26,6 +27,7 @@ namespace Net {
 
 	using Domain_name = Genode::String<160>;
 	class Uplink_base;
+	class Uplink_packet_allocator;
 	class Uplink;
 }
 
@@ -50,8 +52,41 @@ class Net::Uplink_base
 };
 
 
+/**
+ * Packet allocator that leaves the shared part of the transmit buffer out
+ */
+class Net::Uplink_packet_allocator : public Nic::Packet_allocator
+{
+	private:
+
+		Genode::addr_t const _end;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param end  offset within the transmit buffer at which the
+		 *             shared part starts
+		 */
+		Uplink_packet_allocator(Genode::Allocator *md_alloc, Genode::addr_t end)
+		: Nic::Packet_allocator(md_alloc), _end(end) { }
+
+
+		/*******************************
+		 ** Range-allocator interface **
+		 *******************************/
+
+		int add_range(Genode::addr_t base, Genode::size_t size) override {
+			return Nic::Packet_allocator::add_range(base, Genode::min(size, _end - base)); }
+
+		int remove_range(Genode::addr_t base, Genode::size_t size) override {
+			return Nic::Packet_allocator::remove_range(base, Genode::min(size, _end - base)); }
+};
+
+
 class Net::Uplink : public Uplink_base,
-                    public Nic::Packet_allocator,
+                    public Uplink_packet_allocator,
                     public Nic::Connection,
                     public Interface
 {
@@ -62,8 +97,19 @@ class Net::Uplink : public Uplink_base,
 			BUF_SIZE = Nic::Session::QUEUE_SIZE * PKT_SIZE,
 		};
 
+		Genode::Constructible<Shared_buffer> _shared_buffer { };
+
 		Ipv4_address_prefix _read_interface();
 
+		static Genode::size_t _tx_buf_size(Genode::size_t shared_buffer_size)
+		{
+			Genode::size_t const own_size = BUF_SIZE;
+
+			return shared_buffer_size
+			       ? Genode::align_addr(own_size, 12) + shared_buffer_size
+			       : own_size;
+		}
+
 
 		/********************
 		 ** Net::Interface **
@@ -72,13 +118,29 @@ class Net::Uplink : public Uplink_base,
 		Packet_stream_sink   &_sink()   override { return *rx(); }
 		Packet_stream_source &_source() override { return *tx(); }
 
+		bool _hand_over(Ethernet_frame    &eth,
+		                Genode::size_t     eth_size,
+		                Packet_descriptor &pkt) override;
+
+		bool _handed_over_pkt_acked(Packet_descriptor const &pkt) override;
+
+		Shared_buffer const *_window_buffer() const override {
+			return _shared_buffer.constructed() ? &*_shared_buffer : nullptr; }
+
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param shared_buffer_size  size of the part of the transmit buffer
+		 *                            shared with downlink sessions
+		 */
 		Uplink(Genode::Env        &env,
 		       Timer::Connection  &timer,
 		       Genode::Allocator  &alloc,
 		       Interface_list     &interfaces,
-		       Configuration      &config);
+		       Configuration      &config,
+		       Genode::size_t      shared_buffer_size);
 
 
 		/***************
@@ -86,6 +148,9 @@ class Net::Uplink : public Uplink_base,
 		 ***************/
 
 		Mac_address const &router_mac() const { return _router_mac; }
+
+		Shared_buffer *shared_buffer() {
+			return _shared_buffer.constructed() ? &*_shared_buffer : nullptr; }
 };
 
 #endif /* _UPLINK_H_ */
@@ -57,6 +57,12 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		Block::Driver                    &_driver;
 		bool                              _writeable;
 
+		/*
+		 * Window of the back-end packet buffer used as packet buffer,
+		 * or nullptr if the session uses a buffer of its own
+		 */
+		Block::Driver::Window            *_window;
+
 		/**
 		 * Acknowledge a packet already handled
 		 */
@@ -73,7 +79,8 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		 * Range check packet request
 		 */
 		inline bool _range_check(Packet_descriptor &p) {
-			return p.block_number() + p.block_count() <= _partition->sectors; }
+			return p.block_number() + p.block_count() <= _partition->sectors
+			    && p.block_count() * _driver.blk_size() <= p.size(); }
 
 		/**
 		 * Handle a single request
@@ -84,7 +91,8 @@ class Block::Session_component : public  Block::Session_rpc_object,
 			_p_to_handle.succeeded(false);
 
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			if (!packet.size() || !_range_check(_p_to_handle)
+			 || (_window && !_window->contains(_p_to_handle))) {
 				_ack_packet(_p_to_handle);
 				return;
 			}
@@ -92,7 +100,6 @@ class Block::Session_component : public  Block::Session_rpc_object,
 			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
 			sector_t off = _p_to_handle.block_number() + _partition->lba;
 			size_t cnt   = _p_to_handle.block_count();
-			void* addr   = tx_sink()->packet_content(_p_to_handle);
 
 			if (write && !_writeable) {
 				_ack_packet(_p_to_handle);
@@ -100,7 +107,13 @@ class Block::Session_component : public  Block::Session_rpc_object,
 			}
 
 			try {
-				_driver.io(write, off, cnt, addr, *this, _p_to_handle);
+				/* translate the block number only */
+				if (_window)
+					_driver.forward(*_window, off, *this, _p_to_handle);
+				else
+					_driver.io(write, off, cnt,
+					           tx_sink()->packet_content(_p_to_handle),
+					           *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				if (!_req_queue_full) {
 					_req_queue_full = true;
@@ -142,7 +155,8 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		                  Genode::Entrypoint       &ep,
 		                  Genode::Region_map       &rm,
 		                  Block::Driver            &driver,
-		                  bool                      writeable)
+		                  bool                      writeable,
+		                  Block::Driver::Window    *window)
 		: Session_rpc_object(rm, rq_ds, ep.rpc_ep()),
 		  _rq_ds(rq_ds),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
@@ -153,7 +167,8 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		  _ack_queue_full(false),
 		  _p_in_fly(0),
 		  _driver(driver),
-		  _writeable(writeable)
+		  _writeable(writeable),
+		  _window(window)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
@@ -168,11 +183,12 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		}
 
 		Ram_dataspace_capability const rq_ds() const { return _rq_ds; }
+		Block::Driver::Window *window() { return _window; }
 		Partition *partition() { return _partition; }
 
 		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
 		{
-			if (request.operation() == Block::Packet_descriptor::READ) {
+			if (request.operation() == Block::Packet_descriptor::READ && !_window) {
 				void *src =
 					_driver.session().tx()->packet_content(reply);
 				Genode::size_t sz =
@@ -245,9 +261,14 @@ class Block::Root :
 
 		void _destroy_session(Session_component *session) override
 		{
-			Ram_dataspace_capability rq_ds = session->rq_ds();
+			Ram_dataspace_capability rq_ds  = session->rq_ds();
+			Block::Driver::Window   *window = session->window();
 			Genode::Root_component<Session_component>::_destroy_session(session);
-			_env.ram().free(rq_ds);
+
+			if (window)
+				_driver.release_window(*window);
+			else
+				_env.ram().free(rq_ds);
 		}
 
 		/**
@@ -313,12 +334,20 @@ class Block::Root :
 			if (writeable)
 				writeable = Arg_string::find_arg(args, "writeable").bool_value(true);
 
+			/*
+			 * Prefer a window of the back-end buffer as packet buffer, which
+			 * spares copying the payload of each request
+			 */
+			Block::Driver::Window *window = _driver.alloc_window(tx_buf_size);
+
 			Ram_dataspace_capability ds_cap;
-			ds_cap = _env.ram().alloc(tx_buf_size);
+			ds_cap = window
+			       ? static_cap_cast<Ram_dataspace>(window->ds())
+			       : _env.ram().alloc(tx_buf_size);
 			Session_component *session = new (md_alloc())
 				Session_component(ds_cap, _table.partition(num),
 				                  _env.ep(), _env.rm(), _driver,
-				                  writeable);
+				                  writeable, window);
 
 			log("session opened at partition ", num, " for '", label_str, "'");
 			return session;
@@ -20,7 +20,10 @@
 #include <base/tslab.h>
 #include <base/heap.h>
 #include <util/list.h>
+#include <util/reconstructible.h>
 #include <block_session/connection.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 
 namespace Block {
 	class Block_dispatcher;
@@ -37,7 +40,8 @@ struct Block::Block_dispatcher : Genode::Interface
 bool operator== (const Block::Packet_descriptor& p1,
                  const Block::Packet_descriptor& p2)
 {
-	return p1.operation()    == p2.operation()    &&
+	return p1.offset()       == p2.offset()       &&
+	       p1.operation()    == p2.operation()    &&
 	       p1.block_number() == p2.block_number() &&
 	       p1.block_count()  == p2.block_count();
 }
@@ -47,39 +51,104 @@ class Block::Driver
 {
 	public:
 
+	/**
+	 * Part of the back-end packet buffer used as packet buffer of a client
+	 *
+	 * Requests of the client are forwarded to the back end without copying.
+	 * The window is freed not before all forwarded requests are completed,
+	 * even if the client session is closed earlier.
+	 */
+	class Window : public Genode::List<Window>::Element
+	{
+		private:
+
+			friend class Driver;
+
+			/*
+			 * Noncopyable
+			 */
+			Window(Window const &);
+			Window &operator = (Window const &);
+
+			Genode::addr_t                     const _offset;
+			Genode::size_t                     const _size;
+			Genode::Capability<Genode::Region_map> _rm;
+
+			unsigned _pending  = 0;
+			bool     _released = false;
+
+			Window(Genode::addr_t offset, Genode::size_t size,
+			       Genode::Capability<Genode::Region_map> rm)
+			: _offset(offset), _size(size), _rm(rm) { }
+
+		public:
+
+			Genode::Dataspace_capability ds() {
+				return Genode::Region_map_client(_rm).dataspace(); }
+
+			bool contains(Packet_descriptor const &p) const {
+				return p.offset() >= 0 && (Genode::size_t)p.offset() + p.size() <= _size; }
+	};
+
 	class Request : public Genode::List<Request>::Element
 	{
 		private:
 
-			Block_dispatcher &_dispatcher;
+			/*
+			 * Noncopyable
+			 */
+			Request(Request const &);
+			Request &operator = (Request const &);
+
+			Block_dispatcher *_dispatcher;
 			Packet_descriptor _cli;
 			Packet_descriptor _srv;
+			Window           *_window;
 
 		public:
 
 			Request(Block_dispatcher &d,
 			        Packet_descriptor &cli,
-			        Packet_descriptor &srv)
-			: _dispatcher(d), _cli(cli), _srv(srv) {}
+			        Packet_descriptor &srv,
+			        Window            *window = nullptr)
+			: _dispatcher(&d), _cli(cli), _srv(srv), _window(window) {}
 
 			bool handle(Packet_descriptor& reply)
 			{
 				bool ret =  reply == _srv;
-				if (ret) _dispatcher.dispatch(_cli, reply);
+				if (ret && _dispatcher) _dispatcher->dispatch(_cli, reply);
 				return ret;
 			}
 
 			bool same_dispatcher(Block_dispatcher &same) {
-				return &same == &_dispatcher; }
+				return &same == _dispatcher; }
+
+			/**
+			 * Keep request of a closed session until the back end completes it
+			 */
+			void orphan() { _dispatcher = nullptr; }
+
+			Window *window() { return _window; }
 	};
 
 	private:
 
-		enum { BLK_SZ = Session::TX_QUEUE_SIZE*sizeof(Request) };
+		enum {
+			BLK_SZ           = Session::TX_QUEUE_SIZE*sizeof(Request),
+			PRIV_BUFFER_SIZE = 4 * 1024 * 1024
+		};
 
 		Genode::Tslab<Request, BLK_SZ> _r_slab;
 		Genode::List<Request>          _r_list { };
 		Genode::Allocator_avl          _block_alloc;
+
+		/*
+		 * Part of the back-end packet buffer behind 'PRIV_BUFFER_SIZE'
+		 * used for client windows, which keeps the windows from starving
+		 * the copying sessions and the I/O of the partition table
+		 */
+		Genode::Allocator_avl          _window_alloc;
+		Genode::size_t           const _shared_buffer_size;
 		Block::Connection              _session;
 		Block::sector_t                _blk_cnt  = 0;
 		Genode::size_t                 _blk_size = 0;
@@ -87,21 +156,44 @@ class Block::Driver
 		Genode::Signal_handler<Driver> _source_submit;
 		Block::Session::Operations     _ops { };
 
+		Genode::Constructible<Genode::Rm_connection> _rm { };
+		Genode::List<Window>                         _windows { };
+		Genode::Allocator                           &_md_alloc;
+
 		void _ready_to_submit();
 
+		void _destroy_window(Window &window)
+		{
+			_rm->destroy(window._rm);
+			_window_alloc.free((void *)window._offset, window._size);
+			_windows.remove(&window);
+			Genode::destroy(&_md_alloc, &window);
+		}
+
 		void _ack_avail()
 		{
 			/* check for acknowledgements */
 			while (_session.tx()->ack_avail()) {
 				Packet_descriptor p = _session.tx()->get_acked_packet();
+				Window *window = nullptr;
 				for (Request *r = _r_list.first(); r; r = r->next()) {
 					if (r->handle(p)) {
+						window = r->window();
 						_r_list.remove(r);
 						Genode::destroy(&_r_slab, r);
 						break;
 					}
 				}
-				_session.tx()->release_packet(p);
+
+				/* packets of a window are not allocated from the buffer */
+				if (!window) {
+					_session.tx()->release_packet(p);
+					continue;
+				}
+
+				window->_pending--;
+				if (window->_released && !window->_pending)
+					_destroy_window(*window);
 			}
 
 			_ready_to_submit();
@@ -109,14 +201,33 @@ class Block::Driver
 
 	public:
 
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		/**
+		 * Constructor
+		 *
+		 * \param shared_buffer_size  size of the part of the back-end
+		 *                            packet buffer used for client windows
+		 */
+		Driver(Genode::Env &env, Genode::Heap &heap,
+		       Genode::size_t shared_buffer_size)
 		: _r_slab(&heap),
 		  _block_alloc(&heap),
-		  _session(env, &_block_alloc, 4 * 1024 * 1024),
+		  _window_alloc(&heap),
+		  _shared_buffer_size(Genode::align_addr(shared_buffer_size, 12)),
+		  _session(env, &_block_alloc, PRIV_BUFFER_SIZE + _shared_buffer_size),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
-		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit)
+		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
+		  _md_alloc(heap)
 		{
 			_session.info(&_blk_cnt, &_blk_size, &_ops);
+
+			if (!_shared_buffer_size)
+				return;
+
+			/* hand the shared part over from the packet to the window allocator */
+			_block_alloc.remove_range(PRIV_BUFFER_SIZE, _shared_buffer_size);
+			_window_alloc.add_range(PRIV_BUFFER_SIZE, _shared_buffer_size);
+
+			_rm.construct(env);
 		}
 
 		Genode::size_t blk_size() { return _blk_size; }
@@ -154,6 +265,70 @@ class Block::Driver
 			_session.tx()->submit_packet(p);
 		}
 
+		/**
+		 * Forward request of a client using a window without copying
+		 *
+		 * \param nr   first block of the request on the back-end device
+		 * \param cli  client packet, which must lie within the window
+		 */
+		void forward(Window &window, sector_t nr,
+		             Block_dispatcher &dispatcher, Packet_descriptor &cli)
+		{
+			if (!_session.tx()->ready_to_submit())
+				throw Block::Session::Tx::Source::Packet_alloc_failed();
+
+			Packet_descriptor p(Packet_descriptor(window._offset + cli.offset(),
+			                                      _blk_size * cli.block_count()),
+			                    cli.operation(), nr, cli.block_count());
+			Request *r = new (&_r_slab) Request(dispatcher, cli, p, &window);
+			_r_list.insert(r);
+			window._pending++;
+
+			_session.tx()->submit_packet(p);
+		}
+
+		/**
+		 * Allocate window of the back-end packet buffer
+		 *
+		 * \return  window, or nullptr if the shared part of the buffer is
+		 *          exhausted or not configured
+		 */
+		Window *alloc_window(Genode::size_t size)
+		{
+			if (!_rm.constructed())
+				return nullptr;
+
+			size = Genode::align_addr(size, 12);
+
+			void *offset = nullptr;
+			if (_window_alloc.alloc_aligned(size, &offset, 12).error())
+				return nullptr;
+
+			Genode::Capability<Genode::Region_map> rm;
+			try {
+				rm = _rm->create(size);
+				Genode::Region_map_client(rm).attach(_session.tx()->dataspace(),
+				                                     size, (Genode::off_t)offset,
+				                                     true, (Genode::addr_t)0);
+
+				Window *window = new (&_md_alloc) Window((Genode::addr_t)offset, size, rm);
+				_windows.insert(window);
+				return window;
+			} catch (...) {
+				if (rm.valid())
+					_rm->destroy(rm);
+				_window_alloc.free(offset, size);
+				return nullptr;
+			}
+		}
+
+		void release_window(Window &window)
+		{
+			window._released = true;
+			if (!window._pending)
+				_destroy_window(window);
+		}
+
 		void remove_dispatcher(Block_dispatcher &dispatcher)
 		{
 			for (Request *r = _r_list.first(); r;) {
@@ -165,6 +340,12 @@ class Block::Driver
 				Request *remove = r;
 				r = r->next();
 
+				/* the back end still accesses the window of the request */
+				if (remove->window()) {
+					remove->orphan();
+					continue;
+				}
+
 				_r_list.remove(remove);
 				Genode::destroy(&_r_slab, remove);
 			}
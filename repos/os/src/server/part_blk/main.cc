@@ -32,12 +32,18 @@ class Main
 
 		Block::Partition_table & _table();
 
+		Genode::size_t _shared_buffer_size()
+		{
+			return _config.xml().attribute_value("shared_buffer",
+			                                     Genode::Number_of_bytes(0));
+		}
+
 		Genode::Env &_env;
 
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
 		Genode::Heap        _heap     { _env.ram(), _env.rm() };
-		Block::Driver       _driver   { _env, _heap      };
+		Block::Driver       _driver   { _env, _heap, _shared_buffer_size() };
 		Genode::Reporter    _reporter { _env, "partitions" };
 		Mbr_partition_table _mbr      { _heap, _driver, _reporter };
 		Gpt                 _gpt      { _heap, _driver, _reporter };
@@ -32,12 +32,12 @@ struct Report_rom::Main
 
 	Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom };
-
 	Genode::Attached_rom_dataspace config_rom { env, "config" };
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
+	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom };
+
 	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
 	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
 
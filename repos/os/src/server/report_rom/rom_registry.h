@@ -72,7 +72,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_md_alloc, _ram, _rm, name,
+				       _read_write_policy, _read_write_policy);
 
 			_modules.insert(module);
 			return *module;
@@ -183,6 +184,18 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		{
 			return _release(reader, static_cast<Module &>(module));
 		}
+
+		bool shared_dataspace(Module::Name const &rom_label) const override
+		{
+			using namespace Genode;
+
+			try {
+				Session_policy policy(rom_label, _config_rom.xml());
+				return policy.attribute_value("shared_dataspace", false);
+			} catch (Session_policy::No_policy_defined) { }
+
+			return false;
+		}
 };
 
 #endif /* _ROM_REGISTRY_H_ */
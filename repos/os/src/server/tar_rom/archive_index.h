@@ -0,0 +1,231 @@
+/*
+ * \brief  Hash index of the files contained in a TAR archive
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ARCHIVE_INDEX_H_
+#define _ARCHIVE_INDEX_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/log.h>
+#include <os/archive_file_dataspaces.h>
+#include <util/construct_at.h>
+#include <util/string.h>
+
+namespace Tar_rom {
+
+	using namespace Genode;
+	class Archive_index;
+}
+
+
+/**
+ * Index that is built once by scanning the archive
+ *
+ * The index maps file names to the records of the archive. If the archive
+ * contains several records of the same name, the first one is used.
+ */
+class Tar_rom::Archive_index
+{
+	public:
+
+		struct Entry
+		{
+			char const * const name;
+			size_t       const name_len;
+			char const * const content;
+			size_t       const size;
+
+			/* dataspace handed out to the ROM sessions of the file */
+			Archive_file_dataspaces::File file  { };
+			unsigned                      users = 0;
+
+			Entry *next_in_bucket = nullptr;
+
+			Entry(char const *name, size_t name_len, char const *content, size_t size)
+			: name(name), name_len(name_len), content(content), size(size) { }
+
+			private:
+
+				/*
+				 * Noncopyable
+				 */
+				Entry(Entry const &);
+				Entry &operator = (Entry const &);
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Archive_index(Archive_index const &);
+		Archive_index &operator = (Archive_index const &);
+
+		enum {
+			/* length of on data block in tar */
+			BLOCK_LEN = 512,
+
+			/* length of the header field "file-name" in tar */
+			FIELD_NAME_LEN = 100,
+
+			/* offset of the header field "file-size" in tar */
+			FIELD_SIZE_OFFSET = 124
+		};
+
+		Allocator &_alloc;
+
+		char const * const _tar_addr;
+		size_t       const _tar_size;
+
+		/**
+		 * Call 'fn' for each record of the archive
+		 */
+		template <typename FN>
+		void _for_each_record(FN const &fn) const
+		{
+			/* measure size of archive in blocks */
+			size_t block_id = 0, block_cnt = _tar_size/BLOCK_LEN;
+
+			/* scan metablocks of archive */
+			while (block_id < block_cnt) {
+
+				char const *record = _tar_addr + block_id*BLOCK_LEN;
+
+				unsigned long file_size = 0;
+				ascii_to_unsigned(record + FIELD_SIZE_OFFSET, file_size, 8);
+
+				/* get name of tar record, skip leading dot of path if present */
+				char const *name = record;
+				size_t name_len = 0;
+				while (name_len < FIELD_NAME_LEN && name[name_len])
+					name_len++;
+
+				if (name_len >= 2 && name[0] == '.' && name[1] == '/') {
+					name++;
+					name_len--;
+				}
+
+				char const * const content = record + BLOCK_LEN;
+				if (content + file_size <= _tar_addr + _tar_size)
+					fn(name, name_len, content, file_size);
+
+				/* some datablocks */       /* one metablock */
+				block_id = block_id + (file_size / BLOCK_LEN) + 1;
+
+				/* round up */
+				if (file_size % BLOCK_LEN != 0) block_id++;
+
+				/* check for end of tar archive */
+				if (block_id*BLOCK_LEN >= _tar_size)
+					break;
+
+				/* lookout for empty eof-blocks */
+				if (*(_tar_addr + (block_id*BLOCK_LEN)) == 0x00)
+					if (*(_tar_addr + (block_id*BLOCK_LEN + 1)) == 0x00)
+						break;
+			}
+		}
+
+		unsigned _count_records() const
+		{
+			unsigned count = 0;
+			_for_each_record([&] (char const *, size_t, char const *, size_t) {
+				count++; });
+			return count;
+		}
+
+		static unsigned _num_buckets_for(unsigned num_entries)
+		{
+			unsigned n = 16;
+			while (n < 2*num_entries)
+				n <<= 1;
+			return n;
+		}
+
+		unsigned const _num_entries = max(_count_records(), 1U);
+		unsigned const _num_buckets = _num_buckets_for(_num_entries);
+
+		Entry  * const _entries = (Entry  *)_alloc.alloc(_num_entries*sizeof(Entry));
+		Entry ** const _buckets = (Entry **)_alloc.alloc(_num_buckets*sizeof(Entry *));
+
+		/**
+		 * FNV-1a hash
+		 */
+		static unsigned _hash(char const *s, size_t len)
+		{
+			unsigned h = 2166136261u;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (unsigned char)s[i])*16777619u;
+			return h;
+		}
+
+		Entry *&_bucket(char const *name, size_t len) {
+			return _buckets[_hash(name, len) & (_num_buckets - 1)]; }
+
+		Entry *_lookup(char const *name, size_t len)
+		{
+			for (Entry *e = _bucket(name, len); e; e = e->next_in_bucket)
+				if (e->name_len == len && !memcmp(e->name, name, len))
+					return e;
+
+			return nullptr;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param tar_addr  local address of tar archive
+		 * \param tar_size  size of tar archive in bytes
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Archive_index(Allocator &alloc, char const *tar_addr, size_t tar_size)
+		:
+			_alloc(alloc), _tar_addr(tar_addr), _tar_size(tar_size)
+		{
+			for (unsigned i = 0; i < _num_buckets; i++)
+				_buckets[i] = nullptr;
+
+			unsigned i = 0;
+			_for_each_record([&] (char const *name, size_t name_len,
+			                      char const *content, size_t size) {
+
+				if (_lookup(name, name_len))
+					return;
+
+				Entry &e = *construct_at<Entry>(&_entries[i++], name, name_len,
+				                                content, size);
+
+				Entry *&bucket = _bucket(name, name_len);
+				e.next_in_bucket = bucket;
+				bucket = &e;
+			});
+
+			log("indexed ", i, " files of tar archive");
+		}
+
+		~Archive_index()
+		{
+			_alloc.free(_entries, _num_entries*sizeof(Entry));
+			_alloc.free(_buckets, _num_buckets*sizeof(Entry *));
+		}
+
+		/**
+		 * Return entry of the file 'name', or nullptr if not present
+		 */
+		Entry *lookup(char const *name) { return _lookup(name, strlen(name)); }
+};
+
+#endif /* _ARCHIVE_INDEX_H_ */
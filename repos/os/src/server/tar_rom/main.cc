@@ -19,10 +19,15 @@
 #include <base/log.h>
 #include <base/session_label.h>
 #include <root/component.h>
+#include <os/archive_file_dataspaces.h>
+
+/* local includes */
+#include <archive_index.h>
 
 namespace Tar_rom {
 
 	using namespace Genode;
+	class Archive;
 	class Rom_session_component;
 	class Rom_root;
 	struct Main;
@@ -30,150 +35,115 @@ namespace Tar_rom {
 
 
 /**
- * A 'Rom_session_component' exports a single file of the tar archive
+ * Files of the archive handed out as dataspaces
+ *
+ * All sessions of the same file share one dataspace.
  */
-class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
+class Tar_rom::Archive
 {
 	private:
 
 		/*
 		 * Noncopyable
 		 */
-		Rom_session_component(Rom_session_component const &);
-		Rom_session_component &operator = (Rom_session_component const &);
-
-		Ram_session &_ram;
+		Archive(Archive const &);
+		Archive &operator = (Archive const &);
 
-		char const * const _tar_addr;
-		size_t       const _tar_size;
+		typedef Archive_index::Entry Entry;
 
-		Ram_dataspace_capability _file_ds;
+		Archive_index _index;
 
-		enum {
-			/* length of on data block in tar */
-			_BLOCK_LEN = 512,
+		Archive_file_dataspaces _files;
 
-			/* length of the header field "file-size" in tar */
-			_FIELD_SIZE_LEN = 124
-		};
+	public:
 
 		/**
-		 * Copy file content into dataspace
+		 * Constructor
 		 *
-		 * \param dst  destination dataspace
+		 * \param alloc  allocator used for the index of the archive
 		 */
-		void _copy_content_to_dataspace(Region_map &rm, Dataspace_capability dst,
-		                                char const *src, size_t len)
-		{
-			/* temporarily map dataspace */
-			Attached_dataspace ds(rm, dst);
-
-			/* copy content */
-			size_t bytes_to_copy = min(len, ds.size());
-			memcpy(ds.local_addr<char>(), src, bytes_to_copy);
-		}
+		Archive(Env &env, Allocator &alloc, Attached_rom_dataspace const &tar_ds)
+		:
+			_index(alloc, tar_ds.local_addr<char const>(), tar_ds.size()),
+			_files(env, tar_ds)
+		{ }
 
 		/**
-		 * Initialize dataspace containing the content of the archived file
+		 * Return dataspace with the content of file 'name'
+		 *
+		 * \throw Service_denied
 		 */
-		Ram_dataspace_capability _init_file_ds(Ram_session &ram, Region_map &rm,
-		                                       Session_label const &name)
+		Dataspace_capability acquire(Session_label const &name)
 		{
-			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
-
-			char   const *file_content = nullptr;
-			unsigned long file_size    = 0;
-
-			/* scan metablocks of archive */
-			while (block_id < block_cnt) {
-
-				ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
-				                  _FIELD_SIZE_LEN, file_size, 8);
-
-				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
+			Entry * const e = _index.lookup(name.string());
+			if (!e) {
+				error("couldn't find file '", name, "', empty result");
+				throw Service_denied();
+			}
 
-				/* skip leading dot of path if present */
-				if (record_filename[0] == '.' && record_filename[1] == '/')
-					record_filename++;
+			if (e->users) {
+				e->users++;
+				return e->file.ds;
+			}
 
-				/* get infos about current file */
-				if (name == record_filename) {
-					file_content = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					break;
-				}
+			if (!_files.alloc(e->file, e->content, e->size)) {
+				error("couldn't allocate memory for file, empty result");
+				throw Service_denied();
+			}
 
-				/* some datablocks */       /* one metablock */
-				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
+			e->users = 1;
+			return e->file.ds;
+		}
 
-				/* round up */
-				if (file_size % _BLOCK_LEN != 0) block_id++;
+		void release(Session_label const &name)
+		{
+			Entry * const e = _index.lookup(name.string());
+			if (!e || !e->users || --e->users)
+				return;
 
-				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
-					break;
+			_files.free(e->file);
+		}
+};
 
-				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
-						break;
-			}
 
-			if (!file_content) {
-				error("couldn't find file '", name, "', empty result");
-				return Ram_dataspace_capability();
-			}
+/**
+ * A 'Rom_session_component' exports a single file of the tar archive
+ */
+class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
+{
+	private:
 
-			/* try to allocate memory for file */
-			Ram_dataspace_capability file_ds;
-			try {
-				file_ds = ram.alloc(file_size);
+		Archive &_archive;
 
-				/* get content of file copied into dataspace and return */
-				_copy_content_to_dataspace(rm, file_ds, file_content, file_size);
-			} catch (...) {
-				error("couldn't allocate memory for file, empty result");
-				return file_ds;
-			}
+		Session_label const _name;
 
-			return file_ds;
-		}
+		Dataspace_capability const _file_ds;
 
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
+		 * Constructor
 		 *
-		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
-		 * \param  label     name of the requested ROM module
+		 * \param  label  name of the requested ROM module
 		 *
 		 * \throw Service_denied
 		 */
-		Rom_session_component(Ram_session &ram, Region_map &rm,
-		                      char const *tar_addr, unsigned tar_size,
-		                      Session_label const &label)
+		Rom_session_component(Archive &archive, Session_label const &label)
 		:
-			_ram(ram), _tar_addr(tar_addr), _tar_size(tar_size),
-			_file_ds(_init_file_ds(ram, rm, label))
-		{
-			if (!_file_ds.valid())
-				throw Service_denied();
-		}
+			_archive(archive), _name(label), _file_ds(archive.acquire(label))
+		{ }
 
 		/**
 		 * Destructor
 		 */
-		~Rom_session_component() { _ram.free(_file_ds); }
+		~Rom_session_component() { _archive.release(_name); }
 
 		/**
 		 * Return dataspace with content of file
 		 */
 		Rom_dataspace_capability dataspace()
 		{
-			Dataspace_capability ds = _file_ds;
-			return static_cap_cast<Rom_dataspace>(ds);
+			return static_cap_cast<Rom_dataspace>(_file_ds);
 		}
 
 		void sigh(Signal_context_capability) { }
@@ -190,10 +160,7 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 		Rom_root(Rom_root const &);
 		Rom_root &operator = (Rom_root const &);
 
-		Env &_env;
-
-		char const * const _tar_addr;
-		unsigned     const _tar_size;
+		Archive &_archive;
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -202,9 +169,7 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 			log("connection for module '", module_name, "' requested");
 
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(_env.ram(), _env.rm(),
-			                                              _tar_addr, _tar_size,
-			                                              module_name.string());
+			return new (md_alloc()) Rom_session_component(_archive, module_name);
 		}
 
 	public:
@@ -212,14 +177,12 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 		/**
 		 * Constructor
 		 *
-		 * \param tar_base  local address of tar archive
-		 * \param tar_size  size of tar archive in bytes
+		 * \param archive  archive containing the ROM modules
 		 */
-		Rom_root(Env &env, Allocator &md_alloc,
-		         char const *tar_addr, size_t tar_size)
+		Rom_root(Env &env, Allocator &md_alloc, Archive &archive)
 		:
 			Root_component<Rom_session_component>(env.ep(), md_alloc),
-			_env(env), _tar_addr(tar_addr), _tar_size(tar_size)
+			_archive(archive)
 		{ }
 };
 
@@ -249,7 +212,9 @@ struct Tar_rom::Main
 
 	Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
 
-	Rom_root _root { _env, _sliced_heap, _tar_ds.local_addr<char>(), _tar_ds.size() };
+	Archive _archive { _env, _sliced_heap, _tar_ds };
+
+	Rom_root _root { _env, _sliced_heap, _archive };
 
 	Main(Env &env) : _env(env)
 	{
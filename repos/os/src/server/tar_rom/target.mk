@@ -1,3 +1,4 @@
-TARGET = tar_rom
-SRC_CC = main.cc
-LIBS   = base
+TARGET  = tar_rom
+SRC_CC  = main.cc
+LIBS    = base
+INC_DIR += $(PRG_DIR)
@@ -30,6 +30,7 @@
 #include <buffer.h>
 #include <directory.h>
 #include <followed_subject.h>
+#include <timeline.h>
 #include <trace_files.h>
 
 
@@ -241,6 +242,9 @@ class Trace_fs::Trace_file_system
 
 		Followed_subject_registry  _followed_subject_registry;
 
+		Genode::Constructible<Timeline_file> _timeline_file { };
+		Genode::Constructible<Timeline>      _timeline      { };
+
 
 		/**
 		 * Cast Node pointer to Directory pointer
@@ -265,6 +269,16 @@ class Trace_fs::Trace_file_system
 
 			Process_entry<512> process_entry;
 
+			if (_timeline.constructed() && !_timeline->has_thread(subject->id())) {
+				try {
+					Subject_info const info = _trace.subject_info(subject->id());
+					_timeline->add_thread(subject->id(),
+					                      info.session_label().string(),
+					                      info.thread_name().string());
+				}
+				catch (...) { Genode::error("could not add subject to timeline"); }
+			}
+
 			while (!manager->last_entry()) {
 				size_t len = manager->dump_entry(process_entry);
 
@@ -273,6 +287,11 @@ class Trace_fs::Trace_file_system
 
 				try { subject->events_file.append(process_entry.data(), len); }
 				catch (...) { Genode::error("could not write entry"); }
+
+				/* the processed entry is terminated by a newline character */
+				if (_timeline.constructed())
+					try { _timeline->add(subject->id(), process_entry.data(), len - 1); }
+					catch (...) { Genode::error("could not add entry to timeline"); }
 			}
 
 			if (manager->last_entry()) {
@@ -395,12 +414,31 @@ class Trace_fs::Trace_file_system
 		                  Trace              &trace,
 		                  Directory          &root_dir,
 		                  size_t              buffer_size,
-		                  size_t              buffer_size_max)
+		                  size_t              buffer_size_max,
+		                  Timer::Connection  &timer,
+		                  bool                timeline)
 		:
 			_rm(rm), _alloc(alloc), _trace(trace), _root_dir(root_dir),
 			_buffer_size(buffer_size), _buffer_size_max(buffer_size_max),
 			_followed_subject_registry(_alloc)
-		{ }
+		{
+			if (!timeline)
+				return;
+
+			_timeline_file.construct(_alloc);
+			_timeline.construct(_alloc, timer, *_timeline_file);
+			_root_dir.adopt_unsynchronized(&*_timeline_file);
+		}
+
+		~Trace_file_system()
+		{
+			if (!_timeline_file.constructed())
+				return;
+
+			_root_dir.discard_unsynchronized(&*_timeline_file);
+			_timeline.destruct();
+			_timeline_file.destruct();
+		}
 
 		/**
 		 * Handle the change of the content of a node
@@ -599,6 +637,10 @@ class Trace_fs::Trace_file_system
 					parent->adopt_unsynchronized(followed_subject);
 				}
 			}
+
+			if (_timeline.constructed())
+				try { _timeline->flush(); }
+				catch (...) { Genode::error("could not update timeline"); }
 		}
 };
 
@@ -796,7 +838,8 @@ class Trace_fs::Session_component : public Session_rpc_object
 		                  size_t               trace_meta_quota,
 		                  size_t               trace_parent_levels,
 		                  size_t               buffer_size,
-		                  size_t               buffer_size_max)
+		                  size_t               buffer_size_max,
+		                  bool                 timeline)
 		:
 			Session_rpc_object(ram.alloc(tx_buf_size), rm, ep.rpc_ep()),
 			_ep(ep),
@@ -807,7 +850,7 @@ class Trace_fs::Session_component : public Session_rpc_object
 			_poll_interval(poll_interval),
 			_fs_update_timer(env),
 			_trace(new (&_md_alloc) Genode::Trace::Connection(env, trace_quota, trace_meta_quota, trace_parent_levels)),
-			_trace_fs(new (&_md_alloc) Trace_file_system(rm, _md_alloc, *_trace, _root_dir, buffer_size, buffer_size_max)),
+			_trace_fs(new (&_md_alloc) Trace_file_system(rm, _md_alloc, *_trace, _root_dir, buffer_size, buffer_size_max, _fs_update_timer, timeline)),
 			_process_packet_dispatcher(_ep, *this, &Session_component::_process_packets),
 			_fs_update_dispatcher(_ep, *this, &Session_component::_fs_update)
 		{
@@ -1035,6 +1078,7 @@ class Trace_fs::Root : public Root_component<Session_component>
 			Genode::Number_of_bytes buffer_size      =  32 * (1 << 10); /*  32 KiB */
 			Genode::Number_of_bytes buffer_size_max  =   1 * (1 << 20); /*   1 MiB */
 			unsigned trace_parent_levels             = 0;
+			bool     timeline                        = false;
 
 			Session_label const label = label_from_args(args);
 			try {
@@ -1058,6 +1102,7 @@ class Trace_fs::Root : public Root_component<Session_component>
 				catch (...) { }
 				try { policy.attribute("buffer_size_max").value(&buffer_size_max); }
 				catch (...) { }
+				timeline = policy.attribute_value("timeline", false);
 
 				/*
 				 * Determine directory that is used as root directory of
@@ -1114,7 +1159,7 @@ class Trace_fs::Root : public Root_component<Session_component>
 				                  *md_alloc(), subject_limit, interval,
 				                  trace_quota, trace_meta_quota,
 				                  trace_parent_levels, buffer_size,
-				                  buffer_size_max);
+				                  buffer_size_max, timeline);
 		}
 
 	public:
@@ -0,0 +1,389 @@
+/*
+ * \brief  Time-ordered export of the binary trace events of all subjects
+ * \date   2026-10-18
+ *
+ * The events are written in the JSON trace-event format that is understood
+ * by the timeline viewers of Chrome ('chrome://tracing') and Perfetto. The
+ * format allows the closing bracket of the event array to be omitted. So the
+ * file can be extended while the tracing continues.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TIMELINE_H_
+#define _TIMELINE_H_
+
+/* Genode includes */
+#include <base/trace/types.h>
+#include <timer_session/connection.h>
+#include <trace/binary_event.h>
+#include <trace/timestamp.h>
+#include <util/list.h>
+
+/* local includes */
+#include <file.h>
+
+
+namespace Trace_fs {
+
+	class Timeline_file;
+	class Timeline;
+}
+
+
+/**
+ * File that contains the timeline
+ */
+class Trace_fs::Timeline_file : public Buffered_file
+{
+	public:
+
+		Timeline_file(Allocator &md_alloc)
+		: Buffered_file(md_alloc, "timeline.json") { }
+
+		void append(char const *src, size_t len)
+		{
+			Buffered_file::write(src, len, length());
+		}
+
+		/********************
+		 ** File interface **
+		 ********************/
+
+		/* override to prevent the user from overriding the file */
+		size_t write(char const *, size_t, seek_off_t) override { return 0; }
+		void truncate(file_size_t) override { }
+};
+
+
+/**
+ * Converter of binary trace events to the JSON trace-event format
+ *
+ * The events gathered from all subjects during one update are sorted by
+ * their timestamp before they are appended to the timeline file. Each
+ * session label is presented as process, each subject as thread.
+ */
+class Trace_fs::Timeline
+{
+	private:
+
+		typedef Genode::uint64_t                    uint64_t;
+		typedef Genode::Trace::Binary_event         Event;
+		typedef Genode::Trace::Subject_id           Subject_id;
+		typedef Genode::String<Genode::Session_label::capacity()> Label;
+
+		/**
+		 * String printed with the escaping required by JSON
+		 */
+		struct Json_string
+		{
+			char const *str;
+
+			void print(Genode::Output &out) const
+			{
+				for (char const *s = str; *s; s++) {
+					if (*s == '"' || *s == '\\') {
+						out.out_char('\\');
+						out.out_char(*s);
+					} else if ((unsigned char)*s < 0x20) {
+						out.out_char(' ');
+					} else {
+						out.out_char(*s);
+					}
+				}
+			}
+		};
+
+		/**
+		 * Duration in nanoseconds, printed in microseconds
+		 */
+		struct Microseconds
+		{
+			uint64_t ns;
+
+			void print(Genode::Output &out) const
+			{
+				unsigned const frac = (unsigned)(ns % 1000);
+				Genode::print(out, ns/1000, ".",
+				              frac < 100 ? "0" : "", frac < 10 ? "0" : "", frac);
+			}
+		};
+
+		struct Process : Genode::List<Process>::Element
+		{
+			Label    const label;
+			unsigned const pid;
+
+			Process(Label const &label, unsigned pid) : label(label), pid(pid) { }
+		};
+
+		struct Thread : Genode::List<Thread>::Element
+		{
+			Subject_id const id;
+			unsigned   const pid;
+
+			Thread(Subject_id id, unsigned pid) : id(id), pid(pid) { }
+		};
+
+		struct Record
+		{
+			unsigned pid;
+			unsigned tid;
+			Event    event;
+
+			uint64_t timestamp() const { return event.header.timestamp; }
+		};
+
+		/*
+		 * Noncopyable
+		 */
+		Timeline(Timeline const &);
+		Timeline &operator = (Timeline const &);
+
+		Allocator         &_alloc;
+		Timer::Connection &_timer;
+		Timeline_file     &_file;
+
+		Genode::List<Process> _processes { };
+		Genode::List<Thread>  _threads   { };
+		unsigned              _num_processes = 0;
+
+		/* records of the current update */
+		Record  *_records     = nullptr;
+		Record  *_sorted      = nullptr;
+		unsigned _capacity    = 0;
+		unsigned _num_records = 0;
+
+		/* reference point for converting timestamps to wall-clock time */
+		uint64_t      const _start_timestamp = Genode::Trace::timestamp();
+		unsigned long const _start_us        = _timer.elapsed_us();
+
+		uint64_t _cycles_per_ms = 0;
+
+		void _append(char const *str) { _file.append(str, Genode::strlen(str)); }
+
+		template <typename... ARGS>
+		void _append_line(ARGS &&... args)
+		{
+			Genode::String<512> const line(args..., ",\n");
+			_append(line.string());
+		}
+
+		Process &_process(Label const &label)
+		{
+			for (Process *p = _processes.first(); p; p = p->next())
+				if (p->label == label)
+					return *p;
+
+			Process &p = *new (&_alloc) Process(label, ++_num_processes);
+			_processes.insert(&p);
+
+			_append_line("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":", p.pid,
+			             ",\"args\":{\"name\":\"", Json_string { label.string() }, "\"}}");
+			return p;
+		}
+
+		Thread const *_thread(Subject_id id) const
+		{
+			for (Thread const *t = _threads.first(); t; t = t->next())
+				if (t->id.id == id.id)
+					return t;
+
+			return nullptr;
+		}
+
+		/**
+		 * Update rate of the timestamp counter
+		 *
+		 * The rate is measured over the whole lifetime of the timeline,
+		 * which improves its accuracy with each update.
+		 */
+		void _calibrate()
+		{
+			unsigned long const us = _timer.elapsed_us() - _start_us;
+			if (us < 1000)
+				return;
+
+			uint64_t const cycles = Genode::Trace::timestamp() - _start_timestamp;
+			_cycles_per_ms = Genode::max(cycles/(us/1000), (uint64_t)1);
+		}
+
+		Microseconds _time(uint64_t timestamp) const
+		{
+			uint64_t const cycles = timestamp > _start_timestamp
+			                      ? timestamp - _start_timestamp : 0;
+
+			uint64_t const ms = cycles/_cycles_per_ms;
+			uint64_t const ns = ((cycles % _cycles_per_ms)*1000000)/_cycles_per_ms;
+
+			return Microseconds { ms*1000000 + ns };
+		}
+
+		void _grow()
+		{
+			unsigned const capacity = Genode::max(2*_capacity, 256U);
+
+			Record *records = (Record *)_alloc.alloc(capacity*sizeof(Record));
+			Record *sorted  = (Record *)_alloc.alloc(capacity*sizeof(Record));
+
+			if (_records) {
+				Genode::memcpy(records, _records, _num_records*sizeof(Record));
+				_alloc.free(_records, _capacity*sizeof(Record));
+				_alloc.free(_sorted,  _capacity*sizeof(Record));
+			}
+
+			_records  = records;
+			_sorted   = sorted;
+			_capacity = capacity;
+		}
+
+		/**
+		 * Sort records by timestamp
+		 *
+		 * The merge sort is stable. So events of the same thread with equal
+		 * timestamps keep their order.
+		 *
+		 * \return array that holds the sorted records
+		 */
+		Record *_sort()
+		{
+			Record *src = _records, *dst = _sorted;
+
+			for (unsigned width = 1; width < _num_records; width *= 2) {
+
+				for (unsigned lo = 0; lo < _num_records; lo += 2*width) {
+
+					unsigned const mid = Genode::min(lo + width,   _num_records);
+					unsigned const hi  = Genode::min(lo + 2*width, _num_records);
+
+					unsigned i = lo, j = mid, k = lo;
+					while (i < mid && j < hi)
+						dst[k++] = (src[j].timestamp() < src[i].timestamp())
+						         ? src[j++] : src[i++];
+					while (i < mid) dst[k++] = src[i++];
+					while (j < hi)  dst[k++] = src[j++];
+				}
+
+				Record * const tmp = src; src = dst; dst = tmp;
+			}
+			return src;
+		}
+
+		void _write(Record const &r)
+		{
+			Event const &e = r.event;
+
+			Microseconds const ts = _time(e.header.timestamp);
+
+			auto duration = [&] (char const *cat, char const *ph) {
+				_append_line("{\"name\":\"", Json_string { e.name }, "\","
+				             "\"cat\":\"", cat, "\",\"ph\":\"", ph, "\","
+				             "\"ts\":", ts, ",\"pid\":", r.pid, ",\"tid\":", r.tid, "}"); };
+
+			auto instant = [&] (char const *name, char const *arg) {
+				_append_line("{\"name\":\"", Json_string { name }, "\","
+				             "\"ph\":\"i\",\"s\":\"t\","
+				             "\"ts\":", ts, ",\"pid\":", r.pid, ",\"tid\":", r.tid, ","
+				             "\"args\":{\"", arg, "\":", e.header.value, "}}"); };
+
+			switch (e.type()) {
+			case Event::RPC_CALL:        duration("rpc",   "B"); break;
+			case Event::RPC_RETURNED:    duration("rpc",   "E"); break;
+			case Event::RPC_DISPATCH:    duration("serve", "B"); break;
+			case Event::RPC_REPLY:       duration("serve", "E"); break;
+			case Event::SIGNAL_SUBMIT:   instant("signal submit",   "count"); break;
+			case Event::SIGNAL_RECEIVED: instant("signal received", "count"); break;
+			case Event::LOCK_CONTENTION: instant(e.name,            "blocking"); break;
+			}
+		}
+
+	public:
+
+		Timeline(Allocator &alloc, Timer::Connection &timer, Timeline_file &file)
+		:
+			_alloc(alloc), _timer(timer), _file(file)
+		{
+			_append("[\n");
+		}
+
+		~Timeline()
+		{
+			while (Process *p = _processes.first()) {
+				_processes.remove(p);
+				destroy(&_alloc, p);
+			}
+			while (Thread *t = _threads.first()) {
+				_threads.remove(t);
+				destroy(&_alloc, t);
+			}
+			if (_records) {
+				_alloc.free(_records, _capacity*sizeof(Record));
+				_alloc.free(_sorted,  _capacity*sizeof(Record));
+			}
+		}
+
+		bool has_thread(Subject_id id) const { return _thread(id) != nullptr; }
+
+		/**
+		 * Register trace subject
+		 */
+		void add_thread(Subject_id id, char const *label, char const *name)
+		{
+			if (_thread(id))
+				return;
+
+			Process &p = _process(Label(label));
+
+			_threads.insert(new (&_alloc) Thread(id, p.pid));
+
+			_append_line("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":", p.pid,
+			             ",\"tid\":", id.id,
+			             ",\"args\":{\"name\":\"", Json_string { name }, "\"}}");
+		}
+
+		/**
+		 * Add trace-buffer entry of a subject
+		 *
+		 * Entries that do not hold a binary event are ignored.
+		 */
+		void add(Subject_id id, char const *data, size_t len)
+		{
+			Thread const * const t = _thread(id);
+			if (!t)
+				return;
+
+			Event event;
+			if (!event.parse(data, len))
+				return;
+
+			if (_num_records == _capacity)
+				_grow();
+
+			_records[_num_records++] = Record { t->pid, (unsigned)id.id, event };
+		}
+
+		/**
+		 * Append the events added since the last call to the timeline file
+		 */
+		void flush()
+		{
+			_calibrate();
+
+			/* keep the events until the timestamp rate is known */
+			if (!_cycles_per_ms || !_num_records)
+				return;
+
+			Record const * const sorted = _sort();
+			for (unsigned i = 0; i < _num_records; i++)
+				_write(sorted[i]);
+
+			_num_records = 0;
+		}
+};
+
+#endif /* _TIMELINE_H_ */
@@ -0,0 +1,156 @@
+/*
+ * \brief  Test and benchmark of the alarm scheduler
+ * \date   2026-10-18
+ *
+ * Schedules and cancels 100k alarms and checks that the remaining alarms
+ * trigger in the order of their deadlines. Furthermore, checks that a
+ * periodic alarm does not drift if the scheduler is handled irregularly.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <os/alarm.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Test_alarm : Alarm
+{
+	Alarm::Time &last;
+	unsigned    &errors;
+	unsigned    &triggered;
+	Alarm::Time  deadline { 0 };
+
+	Test_alarm(Alarm::Time &last, unsigned &errors, unsigned &triggered)
+	: last(last), errors(errors), triggered(triggered) { }
+
+	bool on_alarm(unsigned count) override
+	{
+		if (deadline < last) {
+			error("alarm with deadline ", deadline, " triggered after ", last);
+			errors++;
+		}
+		last = deadline;
+		triggered += count;
+		return false;
+	}
+};
+
+
+struct Main
+{
+	enum { NR_OF_ALARMS = 100000, PERIOD = 7 };
+
+	Env               &_env;
+	Timer::Connection  _timer     { _env };
+	Heap               _heap      { _env.ram(), _env.rm() };
+	Alarm::Time        _last      { 0 };
+	unsigned           _errors    { 0 };
+	unsigned           _triggered { 0 };
+
+	void _log_duration(char const *what, unsigned long start_ms)
+	{
+		log(what, " ", (unsigned)NR_OF_ALARMS, " alarms took ",
+		    _timer.elapsed_ms() - start_ms, " ms");
+	}
+
+	void _test_schedule_and_discard()
+	{
+		Alarm_scheduler scheduler;
+
+		Test_alarm *alarms = nullptr;
+		if (!_heap.alloc(sizeof(Test_alarm) * NR_OF_ALARMS, (void **)&alarms)) {
+			error("failed to allocate alarms");
+			_errors++;
+			return;
+		}
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++)
+			construct_at<Test_alarm>(&alarms[i], _last, _errors, _triggered);
+
+		unsigned long start_ms = _timer.elapsed_ms();
+		unsigned      seed     = 1;
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++) {
+			seed = seed * 1103515245 + 12345;
+			alarms[i].deadline = 1 + (seed >> 8) % 1000000;
+			scheduler.schedule_absolute(&alarms[i], alarms[i].deadline);
+		}
+		_log_duration("scheduling", start_ms);
+
+		start_ms = _timer.elapsed_ms();
+		for (unsigned i = 0; i < NR_OF_ALARMS; i += 2)
+			scheduler.discard(&alarms[i]);
+		_log_duration("discarding half of", start_ms);
+
+		start_ms = _timer.elapsed_ms();
+		for (Alarm::Time now = 0; now <= 1000000; now += 1000)
+			scheduler.handle(now);
+		_log_duration("handling", start_ms);
+
+		if (_triggered != NR_OF_ALARMS / 2) {
+			error(_triggered, " alarms triggered instead of ", NR_OF_ALARMS / 2);
+			_errors++;
+		}
+
+		for (unsigned i = 0; i < NR_OF_ALARMS; i++)
+			alarms[i].~Test_alarm();
+
+		_heap.free(alarms, sizeof(Test_alarm) * NR_OF_ALARMS);
+	}
+
+	void _test_periodic()
+	{
+		Alarm_scheduler scheduler;
+		Alarm::Time     last      = 0;
+		unsigned        triggered = 0;
+
+		struct Periodic_alarm : Test_alarm
+		{
+			using Test_alarm::Test_alarm;
+
+			bool on_alarm(unsigned count) override {
+				triggered += count; return true; }
+
+		} periodic(last, _errors, triggered);
+
+		scheduler.schedule(&periodic, PERIOD);
+
+		/* handle at irregular points in time */
+		Alarm::Time now = 0;
+		for (unsigned i = 0; i < 10000; i++) {
+			now += 1 + (i * 13) % 29;
+			scheduler.handle(now);
+		}
+
+		/* the period is anchored at the first handling, which is at time 1 */
+		unsigned const expected = 1 + (now - 1) / PERIOD;
+		if (triggered != expected) {
+			error("periodic alarm triggered ", triggered, " times instead of ",
+			      expected);
+			_errors++;
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- alarm scheduler test started ---");
+
+		_test_schedule_and_discard();
+		_test_periodic();
+
+		log("--- alarm scheduler test finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
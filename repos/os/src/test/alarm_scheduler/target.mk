@@ -0,0 +1,3 @@
+TARGET = test-alarm_scheduler
+SRC_CC = main.cc
+LIBS   = base alarm
@@ -0,0 +1,221 @@
+/*
+ * \brief  Benchmark of the pixel-blending kernels
+ * \date   2026-10-18
+ *
+ * Compares the per-pixel operations of the pixel types with the vectorized
+ * row functions of the blit library and the dither painter for typical
+ * window sizes. Before measuring, the test checks that both variants produce
+ * the same pixels.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <blit/blend.h>
+#include <os/dither_painter.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { MAX_W = 1280, MAX_H = 1024, PIXELS_PER_RUN = 64*1024*1024 };
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+
+	Attached_ram_dataspace _src_ds   { _env.ram(), _env.rm(), MAX_W*MAX_H*4 };
+	Attached_ram_dataspace _dst_ds   { _env.ram(), _env.rm(), MAX_W*MAX_H*4 };
+	Attached_ram_dataspace _ref_ds   { _env.ram(), _env.rm(), MAX_W*MAX_H*4 };
+	Attached_ram_dataspace _alpha_ds { _env.ram(), _env.rm(), MAX_W*MAX_H };
+
+	unsigned _errors { 0 };
+
+	template <typename PT>
+	PT *_src() { return _src_ds.local_addr<PT>(); }
+
+	template <typename PT>
+	PT *_dst() { return _dst_ds.local_addr<PT>(); }
+
+	template <typename PT>
+	PT *_ref() { return _ref_ds.local_addr<PT>(); }
+
+	unsigned char *_alpha() { return _alpha_ds.local_addr<unsigned char>(); }
+
+	void _fill()
+	{
+		/* pseudo-random pixels, alpha values with transparent and opaque runs */
+		uint32_t seed = 0x1234567;
+		auto random = [&] () { seed = seed*1103515245 + 12345; return seed >> 8; };
+
+		uint32_t *src = _src_ds.local_addr<uint32_t>();
+		uint32_t *dst = _dst_ds.local_addr<uint32_t>();
+		for (unsigned i = 0; i < MAX_W*MAX_H; i++) {
+			src[i] = (i % 7) ? random() : 0;
+			dst[i] = random();
+		}
+
+		for (unsigned i = 0; i < MAX_W*MAX_H; i++) {
+			unsigned const run = (i / 16) % 4;
+			_alpha()[i] = (run == 0) ? 0 : (run == 1) ? 255 : (unsigned char)random();
+		}
+	}
+
+	/**
+	 * Apply 'fn' to the rows of a 'w' x 'h' window
+	 */
+	template <typename FN>
+	static void _for_each_row(unsigned w, unsigned h, FN const &fn)
+	{
+		for (unsigned y = 0; y < h; y++)
+			fn(y*w, y);
+	}
+
+	/**
+	 * Check that 'reference' and 'kernel' yield the same pixels
+	 */
+	template <typename PT, typename REF_FN, typename KERNEL_FN>
+	void _verify(char const *name, unsigned w, unsigned h,
+	             REF_FN const &reference, KERNEL_FN const &kernel)
+	{
+		size_t const size = w*h*sizeof(PT);
+
+		memcpy(_ref<PT>(), _dst<PT>(), size);
+		_for_each_row(w, h, [&] (unsigned offset, unsigned y) {
+			reference(_ref<PT>() + offset, offset, y); });
+
+		_for_each_row(w, h, [&] (unsigned offset, unsigned y) {
+			kernel(_dst<PT>() + offset, offset, y); });
+
+		if (memcmp(_ref<PT>(), _dst<PT>(), size)) {
+			error(name, " ", w, "x", h, ": kernel result differs from reference");
+			_errors++;
+		}
+	}
+
+	template <typename PT, typename FN>
+	void _measure(char const *name, unsigned w, unsigned h, FN const &fn)
+	{
+		unsigned const rounds   = PIXELS_PER_RUN / (w*h);
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < rounds; i++)
+			_for_each_row(w, h, [&] (unsigned offset, unsigned y) {
+				fn(_dst<PT>() + offset, offset, y); });
+
+		uint64_t const duration_ms = _timer.elapsed_ms() - start_ms;
+		log(name, " ", w, "x", h, ": ",
+		    duration_ms ? ((uint64_t)rounds*w*h / duration_ms / 1000) : 0,
+		    " Mpixel/s");
+	}
+
+	template <typename PT, typename REF_FN, typename KERNEL_FN>
+	void _compare(char const *name, unsigned w, unsigned h,
+	              REF_FN const &reference, KERNEL_FN const &kernel)
+	{
+		_verify<PT>(name, w, h, reference, kernel);
+
+		log("");
+		_measure<PT>(String<32>(name, " scalar").string(), w, h, reference);
+		_measure<PT>(String<32>(name, " ", Blit::blend_kernels()).string(), w, h, kernel);
+	}
+
+	void _run(unsigned w, unsigned h)
+	{
+		typedef Pixel_rgb565 P565;
+		typedef Pixel_rgb888 P888;
+
+		_compare<P565>("mix rgb565", w, h,
+			[&] (P565 *d, unsigned offset, unsigned) {
+				P565 const *s = _src<P565>() + offset;
+				unsigned char const *a = _alpha() + offset;
+				for (unsigned i = 0; i < w; i++)
+					if (a[i]) d[i] = P565::mix(d[i], s[i], a[i]); },
+			[&] (P565 *d, unsigned offset, unsigned) {
+				Blit::mix(d, _src<P565>() + offset, _alpha() + offset, w); });
+
+		_compare<P888>("mix rgb888", w, h,
+			[&] (P888 *d, unsigned offset, unsigned) {
+				P888 const *s = _src<P888>() + offset;
+				unsigned char const *a = _alpha() + offset;
+				for (unsigned i = 0; i < w; i++)
+					if (a[i]) d[i] = P888::mix(d[i], s[i], a[i]); },
+			[&] (P888 *d, unsigned offset, unsigned) {
+				Blit::mix(d, _src<P888>() + offset, _alpha() + offset, w); });
+
+		P565 const color(255, 0, 0);
+
+		_compare<P565>("avr rgb565", w, h,
+			[&] (P565 *d, unsigned offset, unsigned) {
+				P565 const *s = _src<P565>() + offset;
+				for (unsigned i = 0; i < w; i++)
+					d[i] = P565::avr(color, s[i]); },
+			[&] (P565 *d, unsigned offset, unsigned) {
+				Blit::avr(d, _src<P565>() + offset, color, w); });
+
+		_compare<P565>("mask rgb565", w, h,
+			[&] (P565 *d, unsigned offset, unsigned) {
+				P565 const *s = _src<P565>() + offset;
+				for (unsigned i = 0; i < w; i++)
+					if (s[i].pixel) d[i] = s[i]; },
+			[&] (P565 *d, unsigned offset, unsigned) {
+				Blit::mask(d, _src<P565>() + offset, w); });
+
+		_compare<P888>("mask rgb888", w, h,
+			[&] (P888 *d, unsigned offset, unsigned) {
+				P888 const *s = _src<P888>() + offset;
+				for (unsigned i = 0; i < w; i++)
+					if (s[i].pixel) d[i] = s[i]; },
+			[&] (P888 *d, unsigned offset, unsigned) {
+				Blit::mask(d, _src<P888>() + offset, w); });
+
+		/* the dither painter converts the RGB888 source to the destination */
+		_compare<P565>("dither rgb565", w, h,
+			[&] (P565 *d, unsigned offset, unsigned y) {
+				Dither_painter::dither_row<P565, P888>(d, _src<P888>() + offset,
+				                                       _alpha() + offset,
+				                                       Dither_matrix::row(y), 0, w); },
+			[&] (P565 *d, unsigned offset, unsigned y) {
+				Dither_painter::dither_row(d, _src<P888>() + offset,
+				                           _alpha() + offset,
+				                           Dither_matrix::row(y), 0, w); });
+
+		_compare<Pixel_alpha8>("dither alpha8", w, h,
+			[&] (Pixel_alpha8 *d, unsigned offset, unsigned y) {
+				Dither_painter::dither_row<Pixel_alpha8, P888>(d, _src<P888>() + offset,
+				                                               _alpha() + offset,
+				                                               Dither_matrix::row(y), 0, w); },
+			[&] (Pixel_alpha8 *d, unsigned offset, unsigned y) {
+				Dither_painter::dither_row(d, _src<P888>() + offset,
+				                           _alpha() + offset,
+				                           Dither_matrix::row(y), 0, w); });
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- blend benchmark started (", Blit::blend_kernels(), " kernels) ---");
+
+		_fill();
+
+		struct { unsigned w, h; } const windows[] = {
+			{ 64, 64 }, { 333, 17 }, { 320, 240 }, { 800, 600 }, { 1280, 1024 } };
+
+		for (auto window : windows)
+			_run(window.w, window.h);
+
+		log("--- blend benchmark finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
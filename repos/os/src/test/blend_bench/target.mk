@@ -0,0 +1,3 @@
+TARGET = test-blend_bench
+SRC_CC = main.cc
+LIBS   = base blit
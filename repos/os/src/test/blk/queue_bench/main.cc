@@ -0,0 +1,164 @@
+/*
+ * \brief  Benchmark of block requests at different queue depths
+ * \date   2026-10-18
+ *
+ * The benchmark keeps a fixed number of requests outstanding at the block
+ * service and measures the request rate for queue depths between 1 and 32.
+ * Beforehand, it writes a pattern to the device and reads it back at the
+ * maximum queue depth to validate out-of-order completions.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum {
+		MAX_QUEUE_DEPTH = 32,
+		REQUEST_SIZE    = 4096,
+		REQUESTS        = 1024,
+		TX_BUFFER       = 2 * MAX_QUEUE_DEPTH * REQUEST_SIZE
+	};
+
+	typedef Block::Packet_descriptor Packet;
+
+	Env &             _env;
+	Heap              _heap    { _env.ram(), _env.rm() };
+	Allocator_avl     _alloc   { &_heap };
+	Block::Connection _session { _env, &_alloc, TX_BUFFER };
+	Timer::Connection _timer   { _env };
+
+	Io_signal_handler<Main> _ack_handler { _env.ep(), *this, &Main::_handle_ack };
+
+	size_t          _blk_size  = 0;
+	Block::sector_t _blk_count = 0;
+	size_t          _blk_per_request = 0;
+
+	unsigned _outstanding = 0;
+	unsigned _errors      = 0;
+
+	/* validate the content of read requests */
+	bool _verify = false;
+
+	static uint32_t _pattern(Block::sector_t block, size_t word) {
+		return (uint32_t)(block * 0x9e3779b1 + word); }
+
+	void _handle_ack()
+	{
+		while (_session.tx()->ack_avail()) {
+
+			Packet const p = _session.tx()->get_acked_packet();
+
+			if (!p.succeeded()) {
+				error("request for block ", p.block_number(), " failed");
+				_errors++;
+			}
+
+			if (p.operation() == Packet::READ && _verify)
+				_verify_content(p);
+
+			_session.tx()->release_packet(p);
+			_outstanding--;
+		}
+	}
+
+	void _verify_content(Packet const &p)
+	{
+		uint32_t const *words = (uint32_t const *)_session.tx()->packet_content(p);
+		size_t   const  num   = p.size() / sizeof(uint32_t);
+
+		for (size_t i = 0; i < num; i++) {
+			if (words[i] == _pattern(p.block_number(), i))
+				continue;
+
+			error("unexpected content of block ", p.block_number());
+			_errors++;
+			return;
+		}
+	}
+
+	/**
+	 * Issue 'count' requests with at most 'depth' of them outstanding
+	 */
+	void _run(Packet::Opcode op, unsigned depth, unsigned count)
+	{
+		Block::sector_t const num_requests = _blk_count / _blk_per_request;
+
+		for (unsigned i = 0; i < count; ) {
+
+			while (_outstanding < depth && i < count) {
+
+				Block::sector_t const block = (i % num_requests) * _blk_per_request;
+
+				Packet const p(_session.tx()->alloc_packet(REQUEST_SIZE),
+				               op, block, _blk_per_request);
+
+				if (op == Packet::WRITE) {
+					uint32_t *words = (uint32_t *)_session.tx()->packet_content(p);
+					for (size_t w = 0; w < REQUEST_SIZE / sizeof(uint32_t); w++)
+						words[w] = _pattern(block, w);
+				}
+
+				_session.tx()->submit_packet(p);
+				_outstanding++;
+				i++;
+			}
+			_env.ep().wait_and_dispatch_one_io_signal();
+		}
+
+		while (_outstanding)
+			_env.ep().wait_and_dispatch_one_io_signal();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- block queue benchmark started ---");
+
+		_session.tx_channel()->sigh_ack_avail(_ack_handler);
+
+		Block::Session::Operations ops;
+		_session.info(&_blk_count, &_blk_size, &ops);
+		_blk_per_request = REQUEST_SIZE / _blk_size;
+
+		unsigned const pattern_requests = (unsigned)(_blk_count / _blk_per_request);
+
+		/* validate out-of-order completions */
+		_run(Packet::WRITE, MAX_QUEUE_DEPTH, pattern_requests);
+		_verify = true;
+		_run(Packet::READ,  MAX_QUEUE_DEPTH, pattern_requests);
+		_verify = false;
+
+		for (unsigned depth = 1; depth <= MAX_QUEUE_DEPTH; depth *= 2) {
+
+			uint64_t const start_ms = _timer.elapsed_ms();
+			_run(Packet::READ, depth, REQUESTS);
+			uint64_t const duration_ms = _timer.elapsed_ms() - start_ms;
+
+			log("queue depth ", depth, ": ", (unsigned)REQUESTS, " requests in ",
+			    duration_ms, " ms (",
+			    duration_ms ? (REQUESTS * 1000ULL / duration_ms) : 0,
+			    " requests/s)");
+		}
+
+		log("--- block queue benchmark finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
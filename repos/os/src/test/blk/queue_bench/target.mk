@@ -0,0 +1,3 @@
+TARGET = test-blk-queue_bench
+SRC_CC = main.cc
+LIBS   = base
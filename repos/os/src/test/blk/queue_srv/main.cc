@@ -0,0 +1,198 @@
+/*
+ * \brief  In-memory block driver with a command queue
+ * \date   2026-10-18
+ *
+ * The driver models a device with native command queuing. It accepts up to
+ * 'queue_depth' requests at once and completes the outstanding requests
+ * after a fixed latency, in reverse order of their tags. The block data is
+ * copied not before the completion, which exercises the mapping of each tag
+ * to its packet.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <block/component.h>
+#include <block/driver.h>
+#include <timer_session/connection.h>
+
+
+class Driver : public Block::Driver
+{
+	public:
+
+		enum { MAX_QUEUE_DEPTH = 32 };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Driver(Driver const &);
+		Driver &operator = (Driver const &);
+
+		struct Buffer { char *read; char const *write; };
+
+		typedef Block::Request_table<MAX_QUEUE_DEPTH> Requests;
+
+		Genode::size_t                 _number;
+		Genode::size_t                 _size;
+		Genode::Attached_ram_dataspace _blk_ds;
+		Requests                       _requests { };
+		Buffer                         _buffers[MAX_QUEUE_DEPTH] { };
+		unsigned                       _congestions = 0;
+
+		char *_blocks(Block::Packet_descriptor const &p)
+		{
+			return _blk_ds.local_addr<char>() + p.block_number()*_size;
+		}
+
+		void _submit(Block::Packet_descriptor &packet, Buffer buffer)
+		{
+			/* the session component must not exceed the queue depth */
+			if (_requests.full())
+				_congestions++;
+
+			_buffers[_requests.alloc(packet)] = buffer;
+		}
+
+	public:
+
+		Driver(Genode::Env &env, Genode::size_t number, Genode::size_t size,
+		       unsigned queue_depth)
+		: Block::Driver(env.ram()),
+		  _number(number), _size(size),
+		  _blk_ds(env.ram(), env.rm(), number*size)
+		{
+			_requests.depth(queue_depth);
+		}
+
+		/**
+		 * Complete all outstanding requests
+		 */
+		void complete()
+		{
+			for (unsigned i = MAX_QUEUE_DEPTH; i > 0; i--) {
+
+				unsigned const tag = i - 1;
+				if (!_requests.pending(tag))
+					continue;
+
+				Block::Packet_descriptor p   = _requests.release(tag);
+				Buffer             const buf = _buffers[tag];
+				Genode::size_t     const len = p.block_count()*_size;
+
+				if (buf.read)
+					Genode::memcpy(buf.read, _blocks(p), len);
+				else
+					Genode::memcpy(_blocks(p), buf.write, len);
+
+				ack_packet(p);
+			}
+
+			if (_congestions) {
+				Genode::warning(_congestions, " requests exceeded the queue depth");
+				_congestions = 0;
+			}
+		}
+
+
+		/*******************************
+		 **  Block::Driver interface  **
+		 *******************************/
+
+		void session_invalidated() override
+		{
+			_requests.for_each_pending([&] (unsigned tag, Block::Packet_descriptor const &) {
+				_requests.release(tag); });
+		}
+
+		Genode::size_t  block_size()  override { return _size;   }
+		Block::sector_t block_count() override { return _number; }
+
+		unsigned queue_depth() override { return _requests.depth(); }
+
+		Block::Session::Operations ops() override
+		{
+			Block::Session::Operations ops;
+			ops.set_operation(Block::Packet_descriptor::READ);
+			ops.set_operation(Block::Packet_descriptor::WRITE);
+			return ops;
+		}
+
+		void read(Block::sector_t, Genode::size_t, char *buffer,
+		          Block::Packet_descriptor &packet) override
+		{
+			_submit(packet, Buffer { buffer, nullptr });
+		}
+
+		void write(Block::sector_t, Genode::size_t, const char *buffer,
+		           Block::Packet_descriptor &packet) override
+		{
+			_submit(packet, Buffer { nullptr, buffer });
+		}
+};
+
+
+struct Main
+{
+	Genode::Env &env;
+	Genode::Heap heap { env.ram(), env.rm() };
+
+	Genode::Attached_rom_dataspace config { env, "config" };
+
+	class Factory : public Block::Driver_factory
+	{
+		private:
+
+			/*
+			 * Noncopyable
+			 */
+			Factory(Factory const &);
+			Factory &operator = (Factory const &);
+
+		public:
+
+			::Driver *driver = nullptr;
+
+			Factory(Genode::Env &env, Genode::Heap &heap, Genode::Xml_node config)
+			{
+				Genode::size_t const blk_nr =
+					config.attribute_value("sectors", (Genode::size_t)16384);
+				Genode::size_t const blk_sz =
+					config.attribute_value("block_size", (Genode::size_t)512);
+				unsigned const depth =
+					config.attribute_value("queue_depth", (unsigned)::Driver::MAX_QUEUE_DEPTH);
+
+				driver = new (&heap) ::Driver(env, blk_nr, blk_sz, depth);
+			}
+
+			Block::Driver *create() override { return driver; }
+
+			void destroy(Block::Driver *) override { }
+
+	} factory { env, heap, config.xml() };
+
+	Block::Root                    root { env.ep(), heap, env.rm(), factory, true };
+	Timer::Connection              timer { env };
+	Genode::Signal_handler<Driver> dispatcher { env.ep(), *factory.driver,
+	                                            &Driver::complete };
+
+	Main(Genode::Env &env) : env(env)
+	{
+		timer.sigh(dispatcher);
+		timer.trigger_periodic(config.xml().attribute_value("latency_us", 1000U));
+		env.parent().announce(env.ep().manage(root));
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Main server(env); }
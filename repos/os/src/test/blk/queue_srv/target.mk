@@ -0,0 +1,3 @@
+TARGET = test-blk-queue_srv
+SRC_CC = main.cc
+LIBS   = base
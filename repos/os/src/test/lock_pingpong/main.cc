@@ -0,0 +1,171 @@
+/*
+ * \brief  Benchmark of the lock handover between threads
+ * \date   2026-10-18
+ *
+ * Two threads alternately pass the control to each other via two locks,
+ * each used as binary semaphore. Hence, each round comprises two contended
+ * lock handovers that include the blocking and the wake-up of a thread.
+ * For comparison, the benchmark measures uncontended locking and two
+ * threads competing for one lock.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/thread.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Partner : Thread
+{
+	enum { STACK_SIZE = 16*1024 };
+
+	Lock &_ping;
+	Lock &_pong;
+
+	unsigned const _rounds;
+
+	Partner(Env &env, Lock &ping, Lock &pong, unsigned rounds)
+	:
+		Thread(env, "partner", STACK_SIZE),
+		_ping(ping), _pong(pong), _rounds(rounds)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _rounds; i++) {
+			_ping.lock();
+			_pong.unlock();
+		}
+	}
+};
+
+
+struct Competitor : Thread
+{
+	enum { STACK_SIZE = 16*1024 };
+
+	Lock          &_lock;
+	unsigned long &_counter;
+
+	unsigned const _rounds;
+
+	Competitor(Env &env, char const *name, Lock &lock,
+	           unsigned long &counter, unsigned rounds)
+	:
+		Thread(env, name, STACK_SIZE),
+		_lock(lock), _counter(counter), _rounds(rounds)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _rounds; i++) {
+			Lock::Guard guard(_lock);
+			_counter++;
+		}
+	}
+};
+
+
+struct Main
+{
+	enum {
+		UNCONTENDED_ROUNDS = 10*1000*1000,
+		PINGPONG_ROUNDS    = 100*1000,
+		COMPETING_ROUNDS   = 1000*1000,
+	};
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+	unsigned           _errors { 0 };
+
+	void _report(char const *name, unsigned long ops, uint64_t duration_ms)
+	{
+		log(name, ": ", ops, " operations in ", duration_ms, " ms, ",
+		    duration_ms ? (duration_ms * 1000 * 1000) / ops : 0, " ns each");
+	}
+
+	void _uncontended()
+	{
+		Lock lock;
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+		for (unsigned i = 0; i < UNCONTENDED_ROUNDS; i++) {
+			lock.lock();
+			lock.unlock();
+		}
+		_report("uncontended lock/unlock", UNCONTENDED_ROUNDS,
+		        _timer.elapsed_ms() - start_ms);
+	}
+
+	void _pingpong()
+	{
+		Lock ping(Lock::LOCKED);
+		Lock pong(Lock::LOCKED);
+
+		Partner partner(_env, ping, pong, PINGPONG_ROUNDS);
+		partner.start();
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+		for (unsigned i = 0; i < PINGPONG_ROUNDS; i++) {
+			ping.unlock();
+			pong.lock();
+		}
+		_report("ping-pong handover", 2*PINGPONG_ROUNDS,
+		        _timer.elapsed_ms() - start_ms);
+
+		partner.join();
+	}
+
+	void _competing()
+	{
+		Lock                        lock;
+		unsigned long               counter = 0;
+		Cancelable_lock::Contention contention { "competing" };
+
+		lock.contention(contention);
+
+		Competitor first (_env, "first",  lock, counter, COMPETING_ROUNDS);
+		Competitor second(_env, "second", lock, counter, COMPETING_ROUNDS);
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+		first.start();
+		second.start();
+		first.join();
+		second.join();
+		_report("competing threads", 2*COMPETING_ROUNDS,
+		        _timer.elapsed_ms() - start_ms);
+		log("competing threads: ", contention.spinning, " acquired spinning, ",
+		    contention.blocking, " acquired blocking");
+
+		if (counter != 2*COMPETING_ROUNDS) {
+			error("counter is ", counter, " instead of ",
+			      (unsigned long)2*COMPETING_ROUNDS);
+			_errors++;
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- lock ping-pong benchmark started ---");
+
+		_uncontended();
+		_pingpong();
+		_competing();
+
+		log("--- lock ping-pong benchmark finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
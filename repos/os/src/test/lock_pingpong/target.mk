@@ -0,0 +1,3 @@
+TARGET = test-lock_pingpong
+SRC_CC = main.cc
+LIBS   = base
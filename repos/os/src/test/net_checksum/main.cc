@@ -0,0 +1,129 @@
+/*
+ * \brief  Benchmark of the internet-checksum computation
+ * \date   2026-10-18
+ *
+ * Compares the former byte-pair loop of the net library with the vectorized
+ * 'internet_checksum' for frame sizes between 64 and 9000 bytes, as well as
+ * with the incremental update that the NIC router applies after rewriting
+ * addresses and ports.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <net/internet_checksum.h>
+#include <net/ipv4.h>
+
+using namespace Genode;
+using namespace Net;
+
+
+/**
+ * Checksum computation as formerly done by 'Udp_packet::update_checksum'
+ */
+static uint16_t legacy_checksum(void const *data, size_t size)
+{
+	uint32_t sum = 0;
+	size_t const max = (size & 1) ? (size - 1) : size;
+	uint16_t const *words = (uint16_t const *)data;
+	for (size_t i = 0; i < max; i += sizeof(*words)) {
+		sum += host_to_big_endian(*words++); }
+
+	if (size & 1) {
+		uint8_t last[] = { *((uint8_t const *)data + (size - 1)), 0 };
+		sum += host_to_big_endian(*(uint16_t *)&last);
+	}
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16); }
+
+	return (uint16_t)~sum;
+}
+
+
+struct Main
+{
+	enum { MAX_FRAME_SIZE = 9000, BYTES_PER_RUN = 256*1024*1024 };
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+	uint8_t            _frame[MAX_FRAME_SIZE] { };
+	unsigned           _errors { 0 };
+
+	template <typename FUNC>
+	void _measure(char const *name, size_t frame_size, FUNC const &fn)
+	{
+		unsigned const rounds   = BYTES_PER_RUN / frame_size;
+		uint16_t       result   = 0;
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < rounds; i++) {
+			result ^= fn(); }
+
+		uint64_t const duration_ms = _timer.elapsed_ms() - start_ms;
+		log(name, " ", frame_size, " bytes: ",
+		    duration_ms ? (rounds / duration_ms) : 0, " frames/ms (",
+		    Hex(result), ")");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- net checksum benchmark started ---");
+
+		for (size_t i = 0; i < MAX_FRAME_SIZE; i++) {
+			_frame[i] = (uint8_t)(i * 7 + (i >> 8)); }
+
+		/* compare the computations for all sizes and alignments */
+		for (size_t size = 0; size < 256; size++) {
+			for (size_t offset = 0; offset < 8; offset++) {
+				if (legacy_checksum(_frame + offset, size) !=
+				    internet_checksum(_frame + offset, size))
+				{
+					error("checksum mismatch at size ", size,
+					      " offset ", offset);
+					_errors++;
+				}
+			}
+		}
+
+		/* verify an incremental update against a full computation */
+		Ipv4_address const old_ip(_frame);
+		Ipv4_address const new_ip((uint8_t)10);
+		uint16_t const old_checksum = internet_checksum(_frame, 1500);
+		memcpy(_frame, new_ip.addr, sizeof(new_ip.addr));
+		uint16_t const full = internet_checksum(_frame, 1500);
+		uint16_t const incr = internet_checksum_update(old_checksum, old_ip, new_ip);
+		if (full != incr) {
+			error("incremental update yields ", Hex(incr), " instead of ", Hex(full));
+			_errors++;
+		}
+
+		size_t const frame_sizes[] = { 64, 128, 256, 512, 1024, 1500, 4096, 9000 };
+		for (size_t frame_size : frame_sizes) {
+
+			_measure("legacy", frame_size, [&] () {
+				return legacy_checksum(_frame, frame_size); });
+
+			_measure("vectorized", frame_size, [&] () {
+				return internet_checksum(_frame, frame_size); });
+
+			_measure("incremental", frame_size, [&] () {
+				uint16_t checksum = old_checksum;
+				checksum = internet_checksum_update(checksum, old_ip, new_ip);
+				checksum = internet_checksum_update(checksum, 1024, 49152);
+				return internet_checksum_update(checksum, 80, 8080); });
+		}
+		log("--- net checksum benchmark finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
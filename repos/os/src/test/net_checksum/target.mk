@@ -0,0 +1,3 @@
+TARGET = test-net_checksum
+SRC_CC = main.cc
+LIBS   = base net
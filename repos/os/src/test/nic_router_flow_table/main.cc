@@ -0,0 +1,176 @@
+/*
+ * \brief  Unit test for the flow table of the NIC router
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/heap.h>
+#include <base/component.h>
+#include <base/log.h>
+
+/* NIC router includes */
+#include <flow_table.h>
+
+using namespace Genode;
+
+
+struct Flow_id
+{
+	unsigned value;
+	unsigned hash_mask;
+
+	uint32_t hash() const { return (value * 2654435761u) & hash_mask; }
+
+	bool operator == (Flow_id const &id) const { return id.value == value; }
+};
+
+
+struct Flow
+{
+	Flow_id  const id;
+	uint32_t const hash { id.hash() };
+
+	Flow(unsigned value, unsigned hash_mask) : id { value, hash_mask } { }
+
+	Flow_id const &flow_id()   const { return id; }
+	uint32_t       flow_hash() const { return hash; }
+};
+
+
+using Flow_table = Net::Flow_table<Flow_id, Flow>;
+
+
+struct Counting_allocator : Allocator
+{
+	Allocator &wrapped;
+	size_t     sum { 0 };
+
+	Counting_allocator(Allocator &wrapped) : wrapped(wrapped) { }
+
+	bool alloc(size_t size, void **out_addr) override
+	{
+		sum += size;
+		return wrapped.alloc(size, out_addr);
+	}
+
+	void free(void *addr, size_t size) override
+	{
+		sum -= size;
+		wrapped.free(addr, size);
+	}
+
+	size_t overhead(size_t size) const override { return wrapped.overhead(size); }
+	bool   need_size_for_free()  const override { return true; }
+};
+
+
+struct Main
+{
+	Env                &env;
+	Heap                heap  { env.ram(), env.rm() };
+	Counting_allocator  alloc { heap };
+	bool                ok    { true };
+
+	void check(bool condition, char const *what, unsigned value)
+	{
+		if (condition) {
+			return; }
+
+		error(what, " ", value);
+		ok = false;
+	}
+
+	bool found(Flow_table &table, Flow const &flow)
+	{
+		try { return &table.find_by_id(flow.id) == &flow; }
+		catch (Flow_table::No_match) { return false; }
+	}
+
+	void test(char const *name, unsigned hash_mask, unsigned nr_of_flows)
+	{
+		log("flows with ", name, " hashes");
+
+		void *flows_base = nullptr;
+		heap.alloc(nr_of_flows * sizeof(Flow), &flows_base);
+		Flow *flows = (Flow *)flows_base;
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			construct_at<Flow>(&flows[i], i, hash_mask); }
+		{
+			Flow_table table(alloc);
+
+			/* look up all flows inserted so far while the table grows */
+			for (unsigned i = 0; i < nr_of_flows; i++) {
+				table.insert(&flows[i]);
+				check(found(table, flows[i]), "inserted flow not found", i);
+				check(found(table, flows[i / 2]), "earlier flow not found", i / 2);
+			}
+			check(table.nr_of_entries() == nr_of_flows, "wrong number of flows",
+			      (unsigned)table.nr_of_entries());
+
+			/* remove every other flow, including the last one looked up */
+			for (unsigned i = 1; i < nr_of_flows; i += 2) {
+				check(found(table, flows[i]), "flow not found", i);
+				table.remove(&flows[i]);
+				check(!found(table, flows[i]), "removed flow found", i);
+			}
+			for (unsigned i = 0; i < nr_of_flows; i++) {
+				check(found(table, flows[i]) == !(i & 1), "wrong lookup", i); }
+
+			/* visit each remaining flow exactly once */
+			unsigned visits = 0;
+			unsigned long sum = 0;
+			table.for_each([&] (Flow &flow) {
+				visits++;
+				sum += flow.id.value;
+			});
+			unsigned long expected_sum = 0;
+			for (unsigned i = 0; i < nr_of_flows; i += 2) {
+				expected_sum += i; }
+
+			check(visits == (nr_of_flows + 1) / 2, "wrong number of visits", visits);
+			check(sum == expected_sum, "wrong flows visited", (unsigned)sum);
+
+			/* re-insert the removed flows on top of the tombstones */
+			for (unsigned i = 1; i < nr_of_flows; i += 2) {
+				table.insert(&flows[i]); }
+
+			for (unsigned i = 0; i < nr_of_flows; i++) {
+				check(found(table, flows[i]), "re-inserted flow not found", i); }
+
+			for (unsigned i = 0; i < nr_of_flows; i++) {
+				table.remove(&flows[i]); }
+
+			check(table.nr_of_entries() == 0, "flows left",
+			      (unsigned)table.nr_of_entries());
+		}
+		check(alloc.sum == 0, "table memory leaked", (unsigned)alloc.sum);
+		heap.free(flows, nr_of_flows * sizeof(Flow));
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- NIC router flow-table test ---");
+
+		/* collisions are limited to fewer flows as they make probing linear */
+		test("distinct",  ~0U,  20000);
+		test("colliding", 0xff, 2000);
+		test("identical", 0,    500);
+
+		if (!ok) {
+			env.parent().exit(-1);
+			return;
+		}
+		log("--- NIC router flow-table test finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,127 @@
+/*
+ * \brief  Test and benchmark of the XML index
+ * \date   2026-10-18
+ *
+ * Generates a large document, traverses it once with plain 'Xml_node'
+ * navigation and once via an 'Xml_index', and compares the results and
+ * the durations of both traversals.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <util/xml_generator.h>
+#include <util/xml_node.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+/**
+ * Return checksum of the structure and attributes of a node
+ */
+static unsigned long checksum(Xml_node node)
+{
+	unsigned long sum = node.size() + node.num_sub_nodes();
+
+	sum = sum*31 + node.attribute_value("id", 0UL);
+	sum = sum*31 + (node.addr() - node.content_base());
+
+	if (node.has_sub_node("label"))
+		sum = sum*31 + node.sub_node("label").attribute_value("value", 0UL);
+
+	if (node.num_sub_nodes() > 1)
+		sum = sum*31 + node.sub_node(node.num_sub_nodes() - 1).size();
+
+	node.for_each_sub_node([&] (Xml_node sub_node) {
+		sum = sum*31 + checksum(sub_node); });
+
+	return sum;
+}
+
+
+struct Main
+{
+	enum { DOC_SIZE = 1024*1024, NUM_DOMAINS = 500, ROUNDS = 10 };
+
+	Env                    &_env;
+	Heap                    _heap   { _env.ram(), _env.rm() };
+	Timer::Connection       _timer  { _env };
+	Attached_ram_dataspace  _doc_ds { _env.ram(), _env.rm(), DOC_SIZE };
+	char                   *_doc    { _doc_ds.local_addr<char>() };
+	unsigned                _errors { 0 };
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	size_t _generate()
+	{
+		Xml_generator xml(_doc, DOC_SIZE, "config", [&] () {
+			for (unsigned i = 0; i < NUM_DOMAINS; i++) {
+				xml.node("domain", [&] () {
+					xml.attribute("id",        i);
+					xml.attribute("interface", "10.0.2.1/24");
+					xml.attribute("gateway",   "10.0.2.2");
+					xml.node("label", [&] () { xml.attribute("value", i*2); });
+					for (unsigned j = 0; j < 8; j++) {
+						xml.node("tcp", [&] () {
+							xml.attribute("id",  j);
+							xml.attribute("dst", "192.168.1.0/24");
+							xml.node("permit", [&] () {
+								xml.attribute("port",   80 + j);
+								xml.attribute("domain", "uplink"); });
+						});
+					}
+				});
+			}
+		});
+		return xml.used();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML index test started ---");
+
+		Xml_node const doc(_doc, _generate());
+
+		unsigned long start_ms = _timer.elapsed_ms();
+		unsigned long plain    = 0;
+		for (unsigned i = 0; i < ROUNDS; i++)
+			plain = checksum(doc);
+		log("plain traversal:   ", (_timer.elapsed_ms() - start_ms) / ROUNDS, " ms");
+
+		start_ms = _timer.elapsed_ms();
+		Xml_index const index(_heap, doc);
+		log("index of ", index.num_nodes(), " nodes built in ",
+		    _timer.elapsed_ms() - start_ms, " ms");
+
+		start_ms = _timer.elapsed_ms();
+		unsigned long indexed = 0;
+		for (unsigned i = 0; i < ROUNDS; i++)
+			indexed = checksum(index.root());
+		log("indexed traversal: ", (_timer.elapsed_ms() - start_ms) / ROUNDS, " ms");
+
+		if (plain != indexed) {
+			error("checksum mismatch: plain ", Hex(plain), " indexed ", Hex(indexed));
+			_errors++;
+		}
+
+		log("--- XML index test finished (", _errors, " errors) ---");
+		_env.parent().exit(_errors ? -1 : 0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }